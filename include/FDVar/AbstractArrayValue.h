@@ -1,6 +1,8 @@
 #ifndef FDVAR_ABSTRACTARRAYVALUE_H
 #define FDVAR_ABSTRACTARRAYVALUE_H
 
+#include <utility>
+
 #include <FDVar/AbstractValue.h>
 
 namespace FDVar
@@ -12,7 +14,7 @@ namespace FDVar
 
 
         AbstractArrayValue() = default;
-        AbstractArrayValue(AbstractArrayValue &&) = default;
+        AbstractArrayValue(AbstractArrayValue &&) noexcept = default;
         AbstractArrayValue(const AbstractArrayValue &) = default;
 
         virtual ~AbstractArrayValue() = default;
@@ -27,6 +29,13 @@ namespace FDVar
 
         virtual void insert(AbstractValue::Ptr value, SizeType pos) = 0;
         virtual AbstractValue::Ptr removeAt(SizeType pos) = 0;
+
+        virtual void set(SizeType pos, AbstractValue::Ptr value)
+        {
+            removeAt(pos);
+            insert(std::move(value), pos);
+        }
+
         virtual void clear() = 0;
 
         ValueType getValueType() const override { return ValueType::Array; }
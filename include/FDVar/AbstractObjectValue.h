@@ -15,6 +15,8 @@
 
 #include <FDVar/AbstractValue.h>
 #include <FDVar/ArrayValue.h>
+#include <FDVar/SmallFunction.h>
+#include <FDVar/StringValue.h>
 
 namespace FDVar
 {
@@ -23,14 +25,16 @@ namespace FDVar
       public:
         typedef FDVAR_STRING_TYPE StringType;
         typedef FDVAR_STRING_VIEW_TYPE StringViewType;
+        typedef size_t SizeType;
+        typedef SmallFunction<void(StringViewType, const AbstractValue::Ptr &)> VisitorType;
 
         AbstractObjectValue() = default;
-        AbstractObjectValue(AbstractObjectValue &&) = default;
+        AbstractObjectValue(AbstractObjectValue &&) noexcept = default;
         AbstractObjectValue(const AbstractObjectValue &) = default;
 
         virtual ~AbstractObjectValue() = default;
 
-        AbstractObjectValue &operator=(AbstractObjectValue &&) = default;
+        AbstractObjectValue &operator=(AbstractObjectValue &&) noexcept = default;
         AbstractObjectValue &operator=(const AbstractObjectValue &) = default;
 
         virtual AbstractValue::Ptr keys() const = 0;
@@ -44,6 +48,50 @@ namespace FDVar
         virtual void set(StringViewType key, AbstractValue::Ptr value) = 0;
         virtual void unset(StringViewType key) = 0;
 
+        // Returns the stored pointer for member without copying it. Implementations that do not
+        // keep their members as AbstractValue::Ptr return nullptr; callers then use get().
+        virtual const AbstractValue::Ptr *find(const StringType &member) const
+        {
+            static_cast<void>(member);
+            return nullptr;
+        }
+
+        virtual bool contains(StringViewType member) const
+        {
+            if(get(member))
+            {
+                return true;
+            }
+
+            AbstractValue::Ptr names = keys();
+            const auto &arr = static_cast<const AbstractArrayValue &>(*names);
+            for(SizeType i = 0, imax = arr.size(); i < imax; ++i)
+            {
+                if(static_cast<const StringValue &>(*arr[i]).view() == member)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        virtual SizeType size() const
+        {
+            return static_cast<const AbstractArrayValue &>(*keys()).size();
+        }
+
+        virtual void forEach(const VisitorType &visitor) const
+        {
+            AbstractValue::Ptr names = keys();
+            const auto &arr = static_cast<const AbstractArrayValue &>(*names);
+            for(SizeType i = 0, imax = arr.size(); i < imax; ++i)
+            {
+                StringViewType key = static_cast<const StringValue &>(*arr[i]).view();
+                visitor(key, get(key));
+            }
+        }
+
         ValueType getValueType() const override { return ValueType::Object; }
     };
 } // namespace FDVar
@@ -2,8 +2,12 @@
 #define FDVAR_ABSTRACTVALUE_H
 
 #include <FDVar/ValueType.h>
+#include <atomic>
+#include <iterator>
 #include <memory>
 #include <optional>
+#include <thread>
+#include <vector>
 
 namespace FDVar
 {
@@ -12,18 +16,159 @@ namespace FDVar
       public:
         typedef std::shared_ptr<AbstractValue> Ptr;
 
+        class ReleaseHandler
+        {
+          public:
+            virtual ~ReleaseHandler() = default;
 
+            virtual bool defer(std::vector<Ptr> &children) = 0;
+        };
+
+      private:
+        inline static std::atomic<ReleaseHandler *> s_releaseHandler { nullptr };
+        inline static std::atomic<size_t> s_releaseThreshold { 0 };
+        inline static std::atomic<size_t> s_releasesInFlight { 0 };
+
+      public:
         AbstractValue() = default;
-        AbstractValue(AbstractValue &&) = default;
+        AbstractValue(AbstractValue &&) noexcept = default;
         AbstractValue(const AbstractValue &) = default;
 
         virtual ~AbstractValue() noexcept = default;
 
-        AbstractValue &operator=(AbstractValue &&) = default;
+        AbstractValue &operator=(AbstractValue &&) noexcept = default;
         AbstractValue &operator=(const AbstractValue &) = default;
 
         virtual ValueType getValueType() const = 0;
         virtual bool isType(ValueType type) const { return type == getValueType(); }
+
+        virtual void detachChildren(std::vector<Ptr> & /*children*/) {}
+
+        // Direct members of a container; used to decide whether releasing it is deferred.
+        virtual size_t childCount() const { return 0; }
+
+        // Tears pending values down without recursion. Uniquely owned containers at or above the
+        // release threshold are handed whole to the release handler, so a large container is
+        // deferred wherever it sits in the tree.
+        static void releaseChildren(std::vector<Ptr> &pending)
+        {
+            std::vector<Ptr> deferred;
+            releaseChildren(pending, releaseHandler() != nullptr ? &deferred : nullptr);
+            if(!deferred.empty() && !deferRelease(deferred))
+            {
+                releaseChildren(deferred, nullptr);
+            }
+        }
+
+        static ReleaseHandler *releaseHandler()
+        {
+            return s_releaseHandler.load(std::memory_order_acquire);
+        }
+
+        static size_t releaseThreshold()
+        {
+            return s_releaseThreshold.load(std::memory_order_relaxed);
+        }
+
+        static void setReleaseHandler(ReleaseHandler *handler, size_t threshold)
+        {
+            s_releaseThreshold.store(threshold, std::memory_order_relaxed);
+            s_releaseHandler.store(handler, std::memory_order_seq_cst);
+        }
+
+        // Waits until no thread is inside a handler it loaded before the last
+        // setReleaseHandler(), after which a replaced handler may be destroyed.
+        static void drainReleases()
+        {
+            while(s_releasesInFlight.load(std::memory_order_seq_cst) != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        static bool deferRelease(std::vector<Ptr> &children)
+        {
+            s_releasesInFlight.fetch_add(1, std::memory_order_seq_cst);
+            ReleaseHandler *handler = s_releaseHandler.load(std::memory_order_seq_cst);
+            bool deferred = false;
+            try
+            {
+                deferred = handler != nullptr && handler->defer(children);
+            }
+            catch(...)
+            {
+                s_releasesInFlight.fetch_sub(1, std::memory_order_release);
+                throw;
+            }
+
+            s_releasesInFlight.fetch_sub(1, std::memory_order_release);
+            return deferred;
+        }
+
+        template<typename ContainerType>
+        static void releaseValues(ContainerType &values)
+        {
+            if(releaseHandler() != nullptr && !values.empty() &&
+               values.size() >= releaseThreshold())
+            {
+                std::vector<Ptr> children(std::make_move_iterator(values.begin()),
+                                          std::make_move_iterator(values.end()));
+                values.clear();
+                if(!deferRelease(children))
+                {
+                    releaseInline(children);
+                }
+
+                return;
+            }
+
+            releaseInline(values);
+        }
+
+        template<typename ContainerType>
+        static void releaseInline(ContainerType &values)
+        {
+            std::vector<Ptr> pending;
+            for(auto &value: values)
+            {
+                pushUnique(pending, value);
+            }
+
+            releaseChildren(pending);
+        }
+
+      protected:
+        static void pushUnique(std::vector<Ptr> &pending, Ptr &value)
+        {
+            if(value.use_count() == 1 && value->childCount() != 0)
+            {
+                pending.push_back(std::move(value));
+            }
+        }
+
+      private:
+        static void releaseChildren(std::vector<Ptr> &pending, std::vector<Ptr> *deferred)
+        {
+            size_t threshold = releaseThreshold();
+            while(!pending.empty())
+            {
+                Ptr value = std::move(pending.back());
+                pending.pop_back();
+                if(value.use_count() != 1)
+                {
+                    continue;
+                }
+
+                size_t count = value->childCount();
+                if(deferred != nullptr && count != 0 && count >= threshold)
+                {
+                    deferred->push_back(std::move(value));
+                    continue;
+                }
+
+                value->detachChildren(pending);
+            }
+        }
     };
 
     template<typename T, typename U = void>
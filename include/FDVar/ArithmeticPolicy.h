@@ -0,0 +1,223 @@
+#ifndef FDVAR_ARITHMETICPOLICY_H
+#define FDVAR_ARITHMETICPOLICY_H
+
+#ifndef FDVAR_ARITHMETIC_POLICY
+    #define FDVAR_ARITHMETIC_POLICY Wrap
+#endif // FDVAR_ARITHMETIC_POLICY
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace FDVar
+{
+    // How integer arithmetic reacts to a result that does not fit in IntType. Wrap is two's
+    // complement and compiles to the plain instruction; Checked throws std::overflow_error;
+    // Saturate clamps to the IntType range; PromoteToFloat returns the result as a Float and
+    // PromoteToBigInteger as an exact BigInteger. Under every policy but Wrap a zero divisor
+    // throws std::domain_error.
+    enum class ArithmeticPolicy : uint8_t
+    {
+        Wrap,
+        Checked,
+        Saturate,
+        PromoteToFloat,
+        PromoteToBigInteger
+    };
+
+    // Policy of the DynamicVariable operators, fixed at build time by FDVAR_ARITHMETIC_POLICY.
+    inline constexpr ArithmeticPolicy DEFAULT_ARITHMETIC_POLICY =
+      ArithmeticPolicy::FDVAR_ARITHMETIC_POLICY;
+
+    namespace arithmetic
+    {
+        enum class Operation : uint8_t
+        {
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Modulo
+        };
+
+        // Stores the wrapped result of lhs op rhs and returns true if it overflowed. The divisor
+        // must not be zero.
+        template<Operation O, typename T>
+        bool overflow(T lhs, T rhs, T &result)
+        {
+            static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+            if constexpr(O == Operation::Divide || O == Operation::Modulo)
+            {
+                if(rhs == -1 && lhs == std::numeric_limits<T>::min())
+                {
+                    result = O == Operation::Divide ? lhs : 0;
+                    return O == Operation::Divide;
+                }
+
+                result = O == Operation::Divide ? lhs / rhs : lhs % rhs;
+                return false;
+            }
+#if defined(__GNUC__) || defined(__clang__)
+            else if constexpr(O == Operation::Add)
+            {
+                return __builtin_add_overflow(lhs, rhs, &result);
+            }
+            else if constexpr(O == Operation::Subtract)
+            {
+                return __builtin_sub_overflow(lhs, rhs, &result);
+            }
+            else
+            {
+                return __builtin_mul_overflow(lhs, rhs, &result);
+            }
+#else
+            else if constexpr(O == Operation::Add)
+            {
+                typedef std::make_unsigned_t<T> UnsignedType;
+                result = static_cast<T>(static_cast<UnsignedType>(lhs) +
+                                        static_cast<UnsignedType>(rhs));
+                return (lhs >= 0) == (rhs >= 0) && (result >= 0) != (lhs >= 0);
+            }
+            else if constexpr(O == Operation::Subtract)
+            {
+                typedef std::make_unsigned_t<T> UnsignedType;
+                result = static_cast<T>(static_cast<UnsignedType>(lhs) -
+                                        static_cast<UnsignedType>(rhs));
+                return (lhs >= 0) != (rhs >= 0) && (result >= 0) != (lhs >= 0);
+            }
+            else
+            {
+                typedef std::make_unsigned_t<T> UnsignedType;
+                result = static_cast<T>(static_cast<UnsignedType>(lhs) *
+                                        static_cast<UnsignedType>(rhs));
+                if(lhs == -1)
+                {
+                    return rhs == std::numeric_limits<T>::min();
+                }
+
+                return lhs != 0 && result / lhs != rhs;
+            }
+#endif
+        }
+
+        // Wrap, Checked and Saturate; the promoting policies need a caller that can change type
+        // and use fits() or promote().
+        template<ArithmeticPolicy P, Operation O, typename T>
+        T apply(T lhs, T rhs)
+        {
+            static_assert(P != ArithmeticPolicy::PromoteToFloat &&
+                          P != ArithmeticPolicy::PromoteToBigInteger);
+
+            if constexpr(P == ArithmeticPolicy::Wrap)
+            {
+                typedef std::make_unsigned_t<T> UnsignedType;
+                if constexpr(O == Operation::Add)
+                {
+                    return static_cast<T>(static_cast<UnsignedType>(lhs) +
+                                          static_cast<UnsignedType>(rhs));
+                }
+                else if constexpr(O == Operation::Subtract)
+                {
+                    return static_cast<T>(static_cast<UnsignedType>(lhs) -
+                                          static_cast<UnsignedType>(rhs));
+                }
+                else if constexpr(O == Operation::Multiply)
+                {
+                    return static_cast<T>(static_cast<UnsignedType>(lhs) *
+                                          static_cast<UnsignedType>(rhs));
+                }
+                else if constexpr(O == Operation::Divide)
+                {
+                    // min / -1 traps on most targets; -1 divides anything, so negate instead.
+                    if(rhs == -1)
+                    {
+                        return static_cast<T>(UnsignedType(0) - static_cast<UnsignedType>(lhs));
+                    }
+
+                    return lhs / rhs;
+                }
+                else
+                {
+                    return rhs == -1 ? T(0) : lhs % rhs;
+                }
+            }
+            else
+            {
+                if constexpr(O == Operation::Divide || O == Operation::Modulo)
+                {
+                    if(rhs == 0)
+                    {
+                        throw std::domain_error("integer division by zero");
+                    }
+                }
+
+                T result;
+                if(!overflow<O>(lhs, rhs, result))
+                {
+                    return result;
+                }
+
+                if constexpr(P == ArithmeticPolicy::Checked)
+                {
+                    throw std::overflow_error("integer overflow");
+                }
+                else
+                {
+                    bool negative = O == Operation::Multiply || O == Operation::Divide
+                                      ? (lhs < 0) != (rhs < 0)
+                                      : lhs < 0;
+                    return negative ? std::numeric_limits<T>::min()
+                                    : std::numeric_limits<T>::max();
+                }
+            }
+        }
+
+        // Stores lhs op rhs in result and returns true when it fits in T; the caller redoes the
+        // operation in a wider type otherwise.
+        template<Operation O, typename T>
+        bool fits(T lhs, T rhs, T &result)
+        {
+            if constexpr(O == Operation::Divide || O == Operation::Modulo)
+            {
+                if(rhs == 0)
+                {
+                    throw std::domain_error("integer division by zero");
+                }
+            }
+
+            return !overflow<O>(lhs, rhs, result);
+        }
+
+        // PromoteToFloat: stores lhs op rhs in result and returns true when it fits in T,
+        // otherwise stores it in real and returns false.
+        template<Operation O, typename T, typename F>
+        bool promote(T lhs, T rhs, T &result, F &real)
+        {
+            if(fits<O>(lhs, rhs, result))
+            {
+                return true;
+            }
+
+            auto a = static_cast<F>(lhs);
+            auto b = static_cast<F>(rhs);
+            if constexpr(O == Operation::Add)
+            {
+                real = a + b;
+            }
+            else if constexpr(O == Operation::Subtract)
+            {
+                real = a - b;
+            }
+            else
+            {
+                // Divide is the only other operation that can overflow (min / -1).
+                real = O == Operation::Multiply ? a * b : a / b;
+            }
+
+            return false;
+        }
+    } // namespace arithmetic
+} // namespace FDVar
+
+#endif // FDVAR_ARITHMETICPOLICY_H
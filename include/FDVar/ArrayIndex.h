@@ -0,0 +1,300 @@
+#ifndef FDVAR_ARRAYINDEX_H
+#define FDVAR_ARRAYINDEX_H
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <FDVar/ArrayValue.h>
+#include <FDVar/CloneValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/Path.h>
+
+namespace FDVar
+{
+    // Secondary index over the elements of an array, keyed by the value found at a field path
+    // inside each element. Elements without the field are not indexed. The index follows push,
+    // pop, insert, removeAt, set and clear on the array; editing a field of an element in place
+    // is not seen and needs set() on the array or rebuild(). Numeric keys match by value whatever
+    // their type, so find(1) also returns elements whose field is 1.0 or a Decimal 1.00; keys
+    // nested in arrays and objects compare as DynamicVariable does. Not thread-safe.
+    class ArrayIndex : private ArrayObserver
+    {
+      public:
+        typedef DynamicVariable::SizeType SizeType;
+        typedef DynamicVariable::StringViewType StringViewType;
+
+        enum class Kind : uint8_t
+        {
+            Hash,
+            Sorted
+        };
+
+      private:
+        static bool isNumber(const DynamicVariable &value)
+        {
+            return value.isType(ValueType::Integer) || value.isType(ValueType::Float) ||
+                   value.isType(ValueType::BigInteger) || value.isType(ValueType::Decimal);
+        }
+
+        // Equal numbers have the same integral part, which is hashed as an IntType when it
+        // fits and as a double otherwise, where only Float and BigInteger can land.
+        struct KeyHash
+        {
+            size_t operator()(const DynamicVariable &key) const
+            {
+                typedef DynamicVariable::IntType IntType;
+                typedef DynamicVariable::FloatType FloatType;
+                switch(key.getValueType())
+                {
+                    case ValueType::Integer:
+                        return std::hash<IntType>()(static_cast<IntType>(key));
+
+                    case ValueType::Decimal:
+                        return std::hash<IntType>()(
+                          static_cast<const DecimalValue &>(*key.internalValue()).toInteger());
+
+                    case ValueType::BigInteger:
+                    {
+                        const auto &big =
+                          static_cast<const BigIntegerValue &>(*key.internalValue());
+                        return big.fitsInteger() ? std::hash<IntType>()(big.toInteger())
+                                                 : std::hash<FloatType>()(big.toFloat());
+                    }
+
+                    case ValueType::Float:
+                    {
+                        constexpr FloatType limit =
+                          static_cast<FloatType>(std::numeric_limits<IntType>::min());
+                        FloatType integral = std::trunc(static_cast<FloatType>(key));
+                        return integral >= limit && integral < -limit
+                                 ? std::hash<IntType>()(static_cast<IntType>(integral))
+                                 : std::hash<FloatType>()(integral);
+                    }
+
+                    default:
+                        return std::hash<DynamicVariable>()(key);
+                }
+            }
+        };
+
+        struct KeyEqual
+        {
+            bool operator()(const DynamicVariable &lhs, const DynamicVariable &rhs) const
+            {
+                return isNumber(lhs) && isNumber(rhs) ? lhs.compareNumber(rhs) == 0 : lhs == rhs;
+            }
+        };
+
+        struct KeyLess
+        {
+            bool operator()(const DynamicVariable &lhs, const DynamicVariable &rhs) const
+            {
+                return (isNumber(lhs) && isNumber(rhs) ? lhs.compareNumber(rhs)
+                                                       : lhs.compare(rhs)) < 0;
+            }
+        };
+
+        typedef std::unordered_multimap<DynamicVariable, AbstractValue::Ptr, KeyHash, KeyEqual>
+          HashType;
+        typedef std::multimap<DynamicVariable, AbstractValue::Ptr, KeyLess> SortedType;
+        typedef std::unordered_multimap<const AbstractValue *, DynamicVariable> KeysType;
+
+        std::shared_ptr<ArrayValue> m_array;
+        Path m_field;
+        Kind m_kind;
+        HashType m_hash;
+        SortedType m_sorted;
+        KeysType m_keys;
+
+      public:
+        ArrayIndex(const DynamicVariable &array, Path field, Kind kind = Kind::Hash) :
+            m_array(std::dynamic_pointer_cast<ArrayValue>(array.internalValue())),
+            m_field(std::move(field)),
+            m_kind(kind)
+        {
+            if(!m_array)
+            {
+                throw std::invalid_argument("ArrayIndex: value is not an array");
+            }
+
+            if(!m_field.isSingular())
+            {
+                throw std::invalid_argument("ArrayIndex: field path must select a single value");
+            }
+
+            rebuild();
+            m_array->addObserver(this);
+        }
+
+        // field is a member name, a JSON Pointer or a JSONPath expression.
+        ArrayIndex(const DynamicVariable &array, StringViewType field, Kind kind = Kind::Hash) :
+            ArrayIndex(array,
+                       !field.empty() && (field[0] == '/' || field[0] == '$')
+                         ? Path::parse(field)
+                         : Path().member(field),
+                       kind)
+        {
+        }
+
+        ArrayIndex(const ArrayIndex &) = delete;
+        ArrayIndex &operator=(const ArrayIndex &) = delete;
+
+        ~ArrayIndex() override { m_array->removeObserver(this); }
+
+        Kind kind() const { return m_kind; }
+
+        SizeType size() const { return m_keys.size(); }
+
+        SizeType count(const DynamicVariable &key) const
+        {
+            return m_kind == Kind::Hash ? m_hash.count(key) : m_sorted.count(key);
+        }
+
+        // Returns one element whose field equals key, or None.
+        DynamicVariable find(const DynamicVariable &key) const
+        {
+            if(m_kind == Kind::Hash)
+            {
+                auto where = m_hash.find(key);
+                return where == m_hash.end() ? DynamicVariable() : DynamicVariable(where->second);
+            }
+
+            auto where = m_sorted.find(key);
+            return where == m_sorted.end() ? DynamicVariable() : DynamicVariable(where->second);
+        }
+
+        DynamicVariable findAll(const DynamicVariable &key) const
+        {
+            DynamicVariable result(ValueType::Array);
+            if(m_kind == Kind::Hash)
+            {
+                collect(m_hash.equal_range(key), result);
+            }
+            else
+            {
+                collect(m_sorted.equal_range(key), result);
+            }
+
+            return result;
+        }
+
+        // Elements whose field lies in [lower, upper], ordered by field value.
+        DynamicVariable range(const DynamicVariable &lower, const DynamicVariable &upper) const
+        {
+            if(m_kind != Kind::Sorted)
+            {
+                throw std::domain_error("ArrayIndex::range: index is not sorted");
+            }
+
+            DynamicVariable result(ValueType::Array);
+            if(KeyLess()(upper, lower))
+            {
+                return result;
+            }
+
+            collect(std::make_pair(m_sorted.lower_bound(lower), m_sorted.upper_bound(upper)),
+                    result);
+            return result;
+        }
+
+        void rebuild()
+        {
+            m_hash.clear();
+            m_sorted.clear();
+            m_keys.clear();
+            const ArrayValue &array = *m_array;
+            for(SizeType i = 0, imax = array.size(); i < imax; ++i)
+            {
+                add(array[i]);
+            }
+        }
+
+      private:
+        template<typename Iterator>
+        static void collect(std::pair<Iterator, Iterator> matches, DynamicVariable &result)
+        {
+            for(; matches.first != matches.second; ++matches.first)
+            {
+                result.push(DynamicVariable(matches.first->second));
+            }
+        }
+
+        void add(const AbstractValue::Ptr &element)
+        {
+            DynamicVariable match;
+            if(!m_field.get(DynamicVariable(element), match))
+            {
+                return;
+            }
+
+            // Container keys are cloned so that editing the element cannot rehash them in place.
+            DynamicVariable key = detail::cloneValue(match);
+            if(m_kind == Kind::Hash)
+            {
+                m_hash.emplace(key, element);
+            }
+            else
+            {
+                m_sorted.emplace(key, element);
+            }
+
+            m_keys.emplace(element.get(), std::move(key));
+        }
+
+        template<typename Map>
+        static void erase(Map &map, const DynamicVariable &key, const AbstractValue *element)
+        {
+            auto matches = map.equal_range(key);
+            for(auto it = matches.first; it != matches.second; ++it)
+            {
+                if(it->second.get() == element)
+                {
+                    map.erase(it);
+                    return;
+                }
+            }
+        }
+
+        void remove(const AbstractValue::Ptr &element)
+        {
+            auto where = m_keys.find(element.get());
+            if(where == m_keys.end())
+            {
+                return;
+            }
+
+            if(m_kind == Kind::Hash)
+            {
+                erase(m_hash, where->second, element.get());
+            }
+            else
+            {
+                erase(m_sorted, where->second, element.get());
+            }
+
+            m_keys.erase(where);
+        }
+
+        void inserted(SizeType, const AbstractValue::Ptr &value) override { add(value); }
+
+        void removed(SizeType, const AbstractValue::Ptr &value) override { remove(value); }
+
+        void replaced(SizeType,
+                      const AbstractValue::Ptr &previous,
+                      const AbstractValue::Ptr &value) override
+        {
+            remove(previous);
+            add(value);
+        }
+
+        void reset() override { rebuild(); }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_ARRAYINDEX_H
@@ -6,13 +6,32 @@
     #define FDVAR_CONTAINER_TYPE std::vector
 #endif // FDVAR_CONTAINER_TYPE
 
+#include <algorithm>
 #include <iterator>
+#include <memory>
 #include <optional>
+#include <type_traits>
+#include <vector>
 
 #include <FDVar/AbstractArrayValue.h>
 
 namespace FDVar
 {
+    class ArrayObserver
+    {
+      public:
+        typedef AbstractArrayValue::SizeType SizeType;
+
+        virtual ~ArrayObserver() = default;
+
+        virtual void inserted(SizeType pos, const AbstractValue::Ptr &value) = 0;
+        virtual void removed(SizeType pos, const AbstractValue::Ptr &value) = 0;
+        virtual void replaced(SizeType pos,
+                              const AbstractValue::Ptr &previous,
+                              const AbstractValue::Ptr &value) = 0;
+        virtual void reset() = 0;
+    };
+
     class ArrayValue : public AbstractArrayValue
     {
       public:
@@ -20,37 +39,137 @@ namespace FDVar
 
       private:
         ArrayType m_values;
+        std::unique_ptr<std::vector<ArrayObserver *>> m_observers;
 
       public:
         ArrayValue() = default;
-        ArrayValue(ArrayValue &&) = default;
-        ArrayValue(const ArrayValue &) = default;
+        // The source is left empty, so its observers only drop their entries.
+        ArrayValue(ArrayValue &&other) noexcept(
+          std::is_nothrow_move_constructible_v<ArrayType>) :
+            m_values(std::move(other.m_values))
+        {
+            other.notifyReset();
+        }
+        ArrayValue(const ArrayValue &other) : m_values(other.m_values) {}
         ArrayValue(ArrayType &&values) : m_values(std::move(values)) {}
         ArrayValue(const ArrayType &values) : m_values(values) {}
 
         ArrayValue(std::initializer_list<AbstractValue::Ptr> l) : m_values(l) {}
 
-        ~ArrayValue() override = default;
+        ~ArrayValue() override { releaseValues(m_values); }
+
+        ArrayValue &operator=(ArrayValue &&other)
+        {
+            m_values = std::move(other.m_values);
+            other.notifyReset();
+            notifyReset();
+            return *this;
+        }
+
+        ArrayValue &operator=(const ArrayValue &other)
+        {
+            m_values = other.m_values;
+            notifyReset();
+            return *this;
+        }
+
+        // Observers see every structural change made through this value. They are not copied
+        // with it and must unregister before they are destroyed.
+        void addObserver(ArrayObserver *observer)
+        {
+            if(!m_observers)
+            {
+                m_observers.reset(new std::vector<ArrayObserver *>());
+            }
+
+            m_observers->push_back(observer);
+        }
+
+        void removeObserver(ArrayObserver *observer)
+        {
+            if(m_observers)
+            {
+                m_observers->erase(
+                  std::remove(m_observers->begin(), m_observers->end(), observer),
+                  m_observers->end());
+            }
+        }
 
         explicit operator const ArrayType &() const { return m_values; }
 
         SizeType size() const override { return m_values.size(); }
+        size_t childCount() const override { return m_values.size(); }
         bool isEmpty() const override { return m_values.empty(); }
         AbstractValue::Ptr operator[](SizeType pos) override { return m_values[pos]; }
         const AbstractValue::Ptr &operator[](SizeType pos) const override { return m_values[pos]; }
 
-        void push(AbstractValue::Ptr value) override { m_values.push_back(std::move(value)); }
+        void push(AbstractValue::Ptr value) override
+        {
+            m_values.push_back(std::move(value));
+            if(m_observers)
+            {
+                for(ArrayObserver *observer: *m_observers)
+                {
+                    observer->inserted(m_values.size() - 1, m_values.back());
+                }
+            }
+        }
+
         AbstractValue::Ptr pop() override;
         void insert(AbstractValue::Ptr value, SizeType pos) override;
         AbstractValue::Ptr removeAt(SizeType pos) override;
-        void clear() override { m_values.clear(); }
+
+        void set(SizeType pos, AbstractValue::Ptr value) override
+        {
+            AbstractValue::Ptr previous = std::move(m_values[pos]);
+            m_values[pos] = std::move(value);
+            if(m_observers)
+            {
+                for(ArrayObserver *observer: *m_observers)
+                {
+                    observer->replaced(pos, previous, m_values[pos]);
+                }
+            }
+        }
+
+        void clear() override
+        {
+            m_values.clear();
+            notifyReset();
+        }
+
+        void detachChildren(std::vector<AbstractValue::Ptr> &children) override
+        {
+            std::move(m_values.begin(), m_values.end(), std::back_inserter(children));
+            m_values.clear();
+            notifyReset();
+        }
+
+      private:
+        void notifyReset()
+        {
+            if(m_observers)
+            {
+                for(ArrayObserver *observer: *m_observers)
+                {
+                    observer->reset();
+                }
+            }
+        }
     };
 
     void ArrayValue::insert(AbstractValue::Ptr value, ArrayValue::SizeType pos)
     {
         auto where = m_values.begin();
         std::advance(where, pos);
-        m_values.insert(where, std::move(value));
+        where = m_values.insert(where, std::move(value));
+        if(m_observers)
+        {
+            for(ArrayObserver *observer: *m_observers)
+            {
+                observer->inserted(pos, *where);
+            }
+        }
     }
 
     AbstractValue::Ptr ArrayValue::removeAt(ArrayValue::SizeType pos)
@@ -59,6 +178,14 @@ namespace FDVar
         auto where = m_values.begin();
         std::advance(where, pos);
         m_values.erase(where);
+        if(m_observers)
+        {
+            for(ArrayObserver *observer: *m_observers)
+            {
+                observer->removed(pos, result);
+            }
+        }
+
         return result;
     }
 
@@ -66,6 +193,14 @@ namespace FDVar
     {
         FDVar::AbstractValue::Ptr result = m_values.back();
         m_values.pop_back();
+        if(m_observers)
+        {
+            for(ArrayObserver *observer: *m_observers)
+            {
+                observer->removed(m_values.size(), result);
+            }
+        }
+
         return result;
     }
 
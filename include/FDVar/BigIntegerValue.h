@@ -0,0 +1,610 @@
+#ifndef FDVAR_BIGINTEGERVALUE_H
+#define FDVAR_BIGINTEGERVALUE_H
+
+#ifndef FDVAR_BIGINTEGER_KARATSUBA_THRESHOLD
+    #define FDVAR_BIGINTEGER_KARATSUBA_THRESHOLD 32
+#endif // FDVAR_BIGINTEGER_KARATSUBA_THRESHOLD
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <FDVar/AbstractValue.h>
+#include <FDVar/IntValue.h>
+
+namespace FDVar
+{
+    // Signed integer of unbounded size: a sign and a little-endian magnitude of 32-bit limbs
+    // without leading zero limbs. Division truncates toward zero, as it does for IntValue.
+    class BigIntegerValue : public AbstractValue
+    {
+      public:
+        typedef IntValue::IntType IntType;
+        typedef uint32_t LimbType;
+        typedef std::vector<LimbType> LimbsType;
+
+      private:
+        typedef uint64_t WideType;
+
+        static constexpr unsigned LIMB_BITS = 32;
+        static constexpr WideType LIMB_BASE = WideType(1) << LIMB_BITS;
+        static constexpr LimbType DECIMAL_CHUNK = 1000000000;
+        static constexpr unsigned DECIMAL_CHUNK_DIGITS = 9;
+
+        LimbsType m_limbs;
+        bool m_negative;
+
+      public:
+        BigIntegerValue() : m_negative(false) {}
+
+        template<
+          typename T,
+          typename U = std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, T>>
+        explicit BigIntegerValue(T value) : m_negative(false)
+        {
+            typedef std::make_unsigned_t<T> UnsignedType;
+            auto magnitude = static_cast<UnsignedType>(value);
+            if constexpr(std::is_signed_v<T>)
+            {
+                if(value < 0)
+                {
+                    m_negative = true;
+                    magnitude = static_cast<UnsignedType>(0) - magnitude;
+                }
+            }
+
+            while(magnitude != 0)
+            {
+                m_limbs.push_back(static_cast<LimbType>(magnitude));
+                if constexpr(sizeof(UnsignedType) * 8 > LIMB_BITS)
+                {
+                    magnitude >>= LIMB_BITS;
+                }
+                else
+                {
+                    magnitude = 0;
+                }
+            }
+        }
+
+        BigIntegerValue(LimbsType limbs, bool negative) :
+            m_limbs(std::move(limbs)),
+            m_negative(negative)
+        {
+            normalize();
+        }
+
+        BigIntegerValue(BigIntegerValue &&) noexcept = default;
+        BigIntegerValue(const BigIntegerValue &) = default;
+
+        ~BigIntegerValue() noexcept override = default;
+
+        BigIntegerValue &operator=(BigIntegerValue &&) noexcept = default;
+        BigIntegerValue &operator=(const BigIntegerValue &) = default;
+
+        ValueType getValueType() const override { return ValueType::BigInteger; }
+
+        // Accepts an optional sign followed by decimal digits.
+        static BigIntegerValue parse(std::string_view text)
+        {
+            bool negative = false;
+            if(!text.empty() && (text[0] == '-' || text[0] == '+'))
+            {
+                negative = text[0] == '-';
+                text.remove_prefix(1);
+            }
+
+            if(text.empty())
+            {
+                throw std::invalid_argument("BigIntegerValue::parse: no digits");
+            }
+
+            LimbsType limbs;
+            size_t first = text.size() % DECIMAL_CHUNK_DIGITS;
+            if(first == 0)
+            {
+                first = DECIMAL_CHUNK_DIGITS;
+            }
+
+            for(size_t start = 0, length = first; start < text.size();
+                start += length, length = DECIMAL_CHUNK_DIGITS)
+            {
+                LimbType chunk = 0;
+                LimbType scale = 1;
+                for(size_t i = start; i < start + length; ++i)
+                {
+                    if(text[i] < '0' || text[i] > '9')
+                    {
+                        throw std::invalid_argument("BigIntegerValue::parse: invalid digit");
+                    }
+
+                    chunk = chunk * 10 + static_cast<LimbType>(text[i] - '0');
+                    scale *= 10;
+                }
+
+                multiplyAdd(limbs, scale, chunk);
+            }
+
+            return BigIntegerValue(std::move(limbs), negative);
+        }
+
+        const LimbsType &limbs() const { return m_limbs; }
+
+        bool isZero() const { return m_limbs.empty(); }
+
+        bool isNegative() const { return m_negative; }
+
+        bool fitsInteger() const
+        {
+            static_assert(sizeof(IntType) <= sizeof(WideType));
+            if(m_limbs.size() * LIMB_BITS > sizeof(IntType) * 8)
+            {
+                return false;
+            }
+
+            WideType limit = static_cast<WideType>(std::numeric_limits<IntType>::max());
+            return magnitude() <= (m_negative ? limit + 1 : limit);
+        }
+
+        IntType toInteger() const
+        {
+            if(!fitsInteger())
+            {
+                throw std::overflow_error("BigIntegerValue: value does not fit in IntType");
+            }
+
+            WideType value = magnitude();
+            return m_negative ? static_cast<IntType>(WideType(0) - value)
+                              : static_cast<IntType>(value);
+        }
+
+        double toFloat() const
+        {
+            double result = 0;
+            for(auto it = m_limbs.rbegin(); it != m_limbs.rend(); ++it)
+            {
+                result = result * static_cast<double>(LIMB_BASE) + static_cast<double>(*it);
+            }
+
+            return m_negative ? -result : result;
+        }
+
+        std::string toString() const
+        {
+            if(m_limbs.empty())
+            {
+                return "0";
+            }
+
+            std::vector<LimbType> chunks;
+            LimbsType rest = m_limbs;
+            while(!rest.empty())
+            {
+                chunks.push_back(divideSmall(rest, DECIMAL_CHUNK));
+            }
+
+            std::string result = m_negative ? "-" : "";
+            result += std::to_string(chunks.back());
+            for(size_t i = chunks.size() - 1; i-- > 0;)
+            {
+                std::string digits = std::to_string(chunks[i]);
+                result.append(DECIMAL_CHUNK_DIGITS - digits.size(), '0');
+                result += digits;
+            }
+
+            return result;
+        }
+
+        int compare(const BigIntegerValue &other) const
+        {
+            if(m_negative != other.m_negative)
+            {
+                return m_negative ? -1 : 1;
+            }
+
+            int result = compareMagnitude(m_limbs, other.m_limbs);
+            return m_negative ? -result : result;
+        }
+
+        bool operator==(const BigIntegerValue &other) const
+        {
+            return m_negative == other.m_negative && m_limbs == other.m_limbs;
+        }
+
+        bool operator!=(const BigIntegerValue &other) const { return !(*this == other); }
+        bool operator<(const BigIntegerValue &other) const { return compare(other) < 0; }
+        bool operator<=(const BigIntegerValue &other) const { return compare(other) <= 0; }
+        bool operator>(const BigIntegerValue &other) const { return compare(other) > 0; }
+        bool operator>=(const BigIntegerValue &other) const { return compare(other) >= 0; }
+
+        BigIntegerValue operator-() const
+        {
+            BigIntegerValue result(*this);
+            result.m_negative = !m_negative && !m_limbs.empty();
+            return result;
+        }
+
+        BigIntegerValue operator+(const BigIntegerValue &other) const
+        {
+            return addSigned(*this, other.m_limbs, other.m_negative);
+        }
+
+        BigIntegerValue operator-(const BigIntegerValue &other) const
+        {
+            return addSigned(*this, other.m_limbs, !other.m_negative);
+        }
+
+        BigIntegerValue operator*(const BigIntegerValue &other) const
+        {
+            return BigIntegerValue(multiplyMagnitude(m_limbs, other.m_limbs),
+                                   m_negative != other.m_negative);
+        }
+
+        BigIntegerValue operator/(const BigIntegerValue &other) const
+        {
+            LimbsType quotient;
+            LimbsType remainder;
+            divideMagnitude(m_limbs, other.m_limbs, quotient, remainder);
+            return BigIntegerValue(std::move(quotient), m_negative != other.m_negative);
+        }
+
+        BigIntegerValue operator%(const BigIntegerValue &other) const
+        {
+            LimbsType quotient;
+            LimbsType remainder;
+            divideMagnitude(m_limbs, other.m_limbs, quotient, remainder);
+            return BigIntegerValue(std::move(remainder), m_negative);
+        }
+
+        BigIntegerValue &operator+=(const BigIntegerValue &other) { return *this = *this + other; }
+        BigIntegerValue &operator-=(const BigIntegerValue &other) { return *this = *this - other; }
+        BigIntegerValue &operator*=(const BigIntegerValue &other) { return *this = *this * other; }
+        BigIntegerValue &operator/=(const BigIntegerValue &other) { return *this = *this / other; }
+        BigIntegerValue &operator%=(const BigIntegerValue &other) { return *this = *this % other; }
+
+      private:
+        void normalize()
+        {
+            while(!m_limbs.empty() && m_limbs.back() == 0)
+            {
+                m_limbs.pop_back();
+            }
+
+            if(m_limbs.empty())
+            {
+                m_negative = false;
+            }
+        }
+
+        WideType magnitude() const
+        {
+            WideType value = 0;
+            for(size_t i = m_limbs.size(); i-- > 0;)
+            {
+                value = (value << LIMB_BITS) | m_limbs[i];
+            }
+
+            return value;
+        }
+
+        static void trim(LimbsType &limbs)
+        {
+            while(!limbs.empty() && limbs.back() == 0)
+            {
+                limbs.pop_back();
+            }
+        }
+
+        static int compareMagnitude(const LimbsType &lhs, const LimbsType &rhs)
+        {
+            if(lhs.size() != rhs.size())
+            {
+                return lhs.size() < rhs.size() ? -1 : 1;
+            }
+
+            for(size_t i = lhs.size(); i-- > 0;)
+            {
+                if(lhs[i] != rhs[i])
+                {
+                    return lhs[i] < rhs[i] ? -1 : 1;
+                }
+            }
+
+            return 0;
+        }
+
+        static BigIntegerValue addSigned(const BigIntegerValue &lhs,
+                                         const LimbsType &rhs,
+                                         bool rhsNegative)
+        {
+            if(lhs.m_negative == rhsNegative)
+            {
+                LimbsType sum = lhs.m_limbs;
+                addShifted(sum, rhs, 0);
+                return BigIntegerValue(std::move(sum), rhsNegative);
+            }
+
+            if(compareMagnitude(lhs.m_limbs, rhs) >= 0)
+            {
+                LimbsType difference = lhs.m_limbs;
+                subtractInPlace(difference, rhs);
+                return BigIntegerValue(std::move(difference), lhs.m_negative);
+            }
+
+            LimbsType difference = rhs;
+            subtractInPlace(difference, lhs.m_limbs);
+            return BigIntegerValue(std::move(difference), rhsNegative);
+        }
+
+        // target += value << (shift limbs).
+        static void addShifted(LimbsType &target, const LimbsType &value, size_t shift)
+        {
+            if(target.size() < value.size() + shift)
+            {
+                target.resize(value.size() + shift, 0);
+            }
+
+            WideType carry = 0;
+            size_t i = 0;
+            for(; i < value.size(); ++i)
+            {
+                WideType sum = WideType(target[i + shift]) + value[i] + carry;
+                target[i + shift] = static_cast<LimbType>(sum);
+                carry = sum >> LIMB_BITS;
+            }
+
+            for(i += shift; carry != 0; ++i)
+            {
+                if(i == target.size())
+                {
+                    target.push_back(0);
+                }
+
+                WideType sum = WideType(target[i]) + carry;
+                target[i] = static_cast<LimbType>(sum);
+                carry = sum >> LIMB_BITS;
+            }
+        }
+
+        // target -= value; target must not be smaller than value.
+        static void subtractInPlace(LimbsType &target, const LimbsType &value)
+        {
+            WideType borrow = 0;
+            for(size_t i = 0; i < target.size() && (i < value.size() || borrow != 0); ++i)
+            {
+                WideType subtrahend = (i < value.size() ? value[i] : 0) + borrow;
+                borrow = WideType(target[i]) < subtrahend ? 1 : 0;
+                target[i] = static_cast<LimbType>(WideType(target[i]) + (borrow << LIMB_BITS) -
+                                                  subtrahend);
+            }
+
+            trim(target);
+        }
+
+        static void multiplyAdd(LimbsType &limbs, LimbType factor, LimbType addend)
+        {
+            WideType carry = addend;
+            for(auto &limb: limbs)
+            {
+                WideType product = WideType(limb) * factor + carry;
+                limb = static_cast<LimbType>(product);
+                carry = product >> LIMB_BITS;
+            }
+
+            if(carry != 0)
+            {
+                limbs.push_back(static_cast<LimbType>(carry));
+            }
+        }
+
+        // Divides limbs in place and returns the remainder.
+        static LimbType divideSmall(LimbsType &limbs, LimbType divisor)
+        {
+            WideType remainder = 0;
+            for(size_t i = limbs.size(); i-- > 0;)
+            {
+                WideType current = (remainder << LIMB_BITS) | limbs[i];
+                limbs[i] = static_cast<LimbType>(current / divisor);
+                remainder = current % divisor;
+            }
+
+            trim(limbs);
+            return static_cast<LimbType>(remainder);
+        }
+
+        static LimbsType multiplySchoolbook(const LimbType *lhs,
+                                            size_t lhsSize,
+                                            const LimbType *rhs,
+                                            size_t rhsSize)
+        {
+            LimbsType result(lhsSize + rhsSize, 0);
+            for(size_t i = 0; i < lhsSize; ++i)
+            {
+                WideType carry = 0;
+                for(size_t j = 0; j < rhsSize; ++j)
+                {
+                    WideType product = WideType(lhs[i]) * rhs[j] + result[i + j] + carry;
+                    result[i + j] = static_cast<LimbType>(product);
+                    carry = product >> LIMB_BITS;
+                }
+
+                result[i + rhsSize] = static_cast<LimbType>(carry);
+            }
+
+            trim(result);
+            return result;
+        }
+
+        static LimbsType multiplyRange(const LimbType *lhs,
+                                       size_t lhsSize,
+                                       const LimbType *rhs,
+                                       size_t rhsSize)
+        {
+            if(lhsSize < rhsSize)
+            {
+                std::swap(lhs, rhs);
+                std::swap(lhsSize, rhsSize);
+            }
+
+            if(rhsSize < FDVAR_BIGINTEGER_KARATSUBA_THRESHOLD)
+            {
+                return multiplySchoolbook(lhs, lhsSize, rhs, rhsSize);
+            }
+
+            // Karatsuba: split both operands at half limbs and use three half-size products.
+            size_t half = lhsSize / 2;
+            if(rhsSize <= half)
+            {
+                LimbsType result = multiplyRange(lhs, half, rhs, rhsSize);
+                addShifted(result, multiplyRange(lhs + half, lhsSize - half, rhs, rhsSize), half);
+                trim(result);
+                return result;
+            }
+
+            LimbsType low = multiplyRange(lhs, half, rhs, half);
+            LimbsType high = multiplyRange(lhs + half, lhsSize - half, rhs + half, rhsSize - half);
+
+            LimbsType lhsSum(lhs, lhs + half);
+            trim(lhsSum);
+            addShifted(lhsSum, LimbsType(lhs + half, lhs + lhsSize), 0);
+            LimbsType rhsSum(rhs, rhs + half);
+            trim(rhsSum);
+            addShifted(rhsSum, LimbsType(rhs + half, rhs + rhsSize), 0);
+
+            LimbsType middle =
+              multiplyRange(lhsSum.data(), lhsSum.size(), rhsSum.data(), rhsSum.size());
+            subtractInPlace(middle, low);
+            subtractInPlace(middle, high);
+
+            LimbsType result = low;
+            addShifted(result, middle, half);
+            addShifted(result, high, 2 * half);
+            trim(result);
+            return result;
+        }
+
+        static LimbsType multiplyMagnitude(const LimbsType &lhs, const LimbsType &rhs)
+        {
+            if(lhs.empty() || rhs.empty())
+            {
+                return {};
+            }
+
+            return multiplyRange(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+        }
+
+        // Knuth's algorithm D on 32-bit limbs.
+        static void divideMagnitude(const LimbsType &dividend,
+                                    const LimbsType &divisor,
+                                    LimbsType &quotient,
+                                    LimbsType &remainder)
+        {
+            if(divisor.empty())
+            {
+                throw std::domain_error("integer division by zero");
+            }
+
+            if(compareMagnitude(dividend, divisor) < 0)
+            {
+                quotient.clear();
+                remainder = dividend;
+                return;
+            }
+
+            if(divisor.size() == 1)
+            {
+                quotient = dividend;
+                LimbType rest = divideSmall(quotient, divisor[0]);
+                remainder.assign(rest != 0 ? 1 : 0, rest);
+                return;
+            }
+
+            size_t n = divisor.size();
+            size_t m = dividend.size() - n;
+            unsigned shift = 0;
+            for(LimbType top = divisor.back(); (top & 0x80000000u) == 0; top <<= 1)
+            {
+                ++shift;
+            }
+
+            LimbsType v(n);
+            LimbsType u(dividend.size() + 1);
+            for(size_t i = n; i-- > 0;)
+            {
+                WideType low = i > 0 && shift != 0 ? divisor[i - 1] >> (LIMB_BITS - shift) : 0;
+                v[i] = static_cast<LimbType>((WideType(divisor[i]) << shift) | low);
+            }
+
+            u[dividend.size()] =
+              shift != 0 ? static_cast<LimbType>(dividend.back() >> (LIMB_BITS - shift)) : 0;
+            for(size_t i = dividend.size(); i-- > 0;)
+            {
+                WideType low = i > 0 && shift != 0 ? dividend[i - 1] >> (LIMB_BITS - shift) : 0;
+                u[i] = static_cast<LimbType>((WideType(dividend[i]) << shift) | low);
+            }
+
+            quotient.assign(m + 1, 0);
+            for(size_t j = m + 1; j-- > 0;)
+            {
+                WideType numerator = (WideType(u[j + n]) << LIMB_BITS) | u[j + n - 1];
+                WideType estimate = numerator / v[n - 1];
+                WideType rest = numerator % v[n - 1];
+                while(estimate >= LIMB_BASE ||
+                      estimate * v[n - 2] > ((rest << LIMB_BITS) | u[j + n - 2]))
+                {
+                    --estimate;
+                    rest += v[n - 1];
+                    if(rest >= LIMB_BASE)
+                    {
+                        break;
+                    }
+                }
+
+                int64_t borrow = 0;
+                for(size_t i = 0; i < n; ++i)
+                {
+                    WideType product = estimate * v[i];
+                    int64_t difference = static_cast<int64_t>(u[i + j]) - borrow -
+                                         static_cast<int64_t>(product & 0xFFFFFFFFu);
+                    u[i + j] = static_cast<LimbType>(difference);
+                    borrow = static_cast<int64_t>(product >> LIMB_BITS) - (difference >> LIMB_BITS);
+                }
+
+                int64_t top = static_cast<int64_t>(u[j + n]) - borrow;
+                u[j + n] = static_cast<LimbType>(top);
+                quotient[j] = static_cast<LimbType>(estimate);
+                if(top < 0)
+                {
+                    --quotient[j];
+                    WideType carry = 0;
+                    for(size_t i = 0; i < n; ++i)
+                    {
+                        WideType sum = WideType(u[i + j]) + v[i] + carry;
+                        u[i + j] = static_cast<LimbType>(sum);
+                        carry = sum >> LIMB_BITS;
+                    }
+
+                    u[j + n] = static_cast<LimbType>(u[j + n] + carry);
+                }
+            }
+
+            remainder.assign(n, 0);
+            for(size_t i = 0; i < n; ++i)
+            {
+                WideType high = shift != 0 ? WideType(u[i + 1]) << (LIMB_BITS - shift) : 0;
+                remainder[i] = static_cast<LimbType>((u[i] >> shift) | high);
+            }
+
+            trim(quotient);
+            trim(remainder);
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_BIGINTEGERVALUE_H
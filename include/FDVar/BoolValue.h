@@ -16,7 +16,7 @@ namespace FDVar
         BoolValue() : BoolValue(false) {}
         explicit BoolValue(bool value) : m_value(value) {}
 
-        BoolValue(BoolValue &&) = default;
+        BoolValue(BoolValue &&) noexcept = default;
         BoolValue(const BoolValue &) = default;
         ~BoolValue() override = default;
 
@@ -28,7 +28,7 @@ namespace FDVar
             return *this;
         }
 
-        BoolValue &operator=(BoolValue &&) = default;
+        BoolValue &operator=(BoolValue &&) noexcept = default;
         BoolValue &operator=(const BoolValue &) = default;
 
         explicit operator bool() const { return m_value; }
@@ -0,0 +1,148 @@
+#ifndef FDVAR_BYTESVALUE_H
+#define FDVAR_BYTESVALUE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <FDVar/AbstractValue.h>
+#include <FDVar/Hash.h>
+
+namespace FDVar
+{
+    // Immutable byte buffer. The storage is reference counted and never modified, so copies and
+    // slices share it and cost O(1) regardless of size. The buffer may be owned by the value or
+    // adopted from elsewhere (a mapped file, a network buffer) together with its release logic.
+    class BytesValue : public AbstractValue
+    {
+      public:
+        typedef uint8_t ByteType;
+        typedef size_t SizeType;
+        typedef std::shared_ptr<const ByteType> BufferType;
+        typedef const ByteType *IteratorType;
+
+        static constexpr SizeType npos = static_cast<SizeType>(-1);
+
+      private:
+        BufferType m_buffer;
+        SizeType m_offset;
+        SizeType m_length;
+
+        BytesValue(BufferType buffer, SizeType offset, SizeType length) :
+            m_buffer(std::move(buffer)),
+            m_offset(offset),
+            m_length(length)
+        {
+        }
+
+      public:
+        BytesValue() : m_offset(0), m_length(0) {}
+
+        explicit BytesValue(std::vector<ByteType> &&data) : m_offset(0), m_length(data.size())
+        {
+            auto storage = std::make_shared<const std::vector<ByteType>>(std::move(data));
+            m_buffer = BufferType(storage, storage->data());
+        }
+
+        BytesValue(const void *data, SizeType size) :
+            BytesValue(std::vector<ByteType>(static_cast<const ByteType *>(data),
+                                             static_cast<const ByteType *>(data) + size))
+        {
+        }
+
+        explicit BytesValue(std::string_view data) : BytesValue(data.data(), data.size()) {}
+
+        // Shares memory kept alive by owner, e.g. a slice of an already reference counted buffer.
+        BytesValue(std::shared_ptr<const void> owner, const void *data, SizeType size) :
+            m_buffer(std::move(owner), static_cast<const ByteType *>(data)),
+            m_offset(0),
+            m_length(size)
+        {
+        }
+
+        // Takes ownership of external memory; deleter(data) runs once the last copy or slice
+        // referring to it is destroyed.
+        template<typename Deleter>
+        static BytesValue adopt(const void *data, SizeType size, Deleter deleter)
+        {
+            return BytesValue(BufferType(static_cast<const ByteType *>(data), std::move(deleter)),
+                              0, size);
+        }
+
+        BytesValue(BytesValue &&) noexcept = default;
+        BytesValue(const BytesValue &) = default;
+
+        ~BytesValue() noexcept override = default;
+
+        ValueType getValueType() const override { return ValueType::Bytes; }
+
+        BytesValue &operator=(BytesValue &&) noexcept = default;
+        BytesValue &operator=(const BytesValue &) = default;
+
+        const ByteType *data() const { return m_buffer.get() + m_offset; }
+        SizeType size() const { return m_length; }
+        bool isEmpty() const { return m_length == 0; }
+
+        IteratorType begin() const { return data(); }
+        IteratorType end() const { return data() + m_length; }
+
+        ByteType operator[](SizeType pos) const { return data()[pos]; }
+
+        ByteType at(SizeType pos) const
+        {
+            if(pos >= m_length)
+            {
+                throw std::out_of_range("at: position out of range");
+            }
+
+            return data()[pos];
+        }
+
+        // Shares the underlying buffer; count is clamped to the end like std::string::substr.
+        BytesValue slice(SizeType from, SizeType count = npos) const
+        {
+            if(from > m_length)
+            {
+                throw std::out_of_range("slice: position out of range");
+            }
+
+            return BytesValue(m_buffer, m_offset + from, std::min(count, m_length - from));
+        }
+
+        const BufferType &buffer() const { return m_buffer; }
+        SizeType offset() const { return m_offset; }
+
+        int compare(const BytesValue &other) const
+        {
+            SizeType common = std::min(m_length, other.m_length);
+            int result = common == 0 ? 0 : std::memcmp(data(), other.data(), common);
+            if(result != 0)
+            {
+                return result < 0 ? -1 : 1;
+            }
+
+            return m_length < other.m_length ? -1 : (other.m_length < m_length ? 1 : 0);
+        }
+
+        bool operator==(const BytesValue &other) const
+        {
+            return m_length == other.m_length &&
+                   (data() == other.data() || compare(other) == 0);
+        }
+
+        bool operator!=(const BytesValue &other) const { return !(*this == other); }
+        bool operator<(const BytesValue &other) const { return compare(other) < 0; }
+        bool operator<=(const BytesValue &other) const { return compare(other) <= 0; }
+        bool operator>(const BytesValue &other) const { return compare(other) > 0; }
+        bool operator>=(const BytesValue &other) const { return compare(other) >= 0; }
+
+        uint64_t hash() const { return hash::bytes(data(), m_length); }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_BYTESVALUE_H
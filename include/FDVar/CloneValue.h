@@ -0,0 +1,64 @@
+#ifndef FDVAR_CLONEVALUE_H
+#define FDVAR_CLONEVALUE_H
+
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+
+namespace FDVar
+{
+    namespace detail
+    {
+        // Deep copy of value: arrays and objects are rebuilt iteratively so the result shares
+        // no container with value, scalars are copied as they are.
+        inline DynamicVariable cloneValue(const DynamicVariable &value)
+        {
+            DynamicVariable result;
+            if(!value.isType(ValueType::Array) && !value.isType(ValueType::Object))
+            {
+                result = value;
+                return result;
+            }
+
+            result = DynamicVariable(value.getValueType());
+            std::vector<std::pair<DynamicVariable, DynamicVariable>> pending { { value, result } };
+            auto cloneChild = [&pending](const DynamicVariable &child) {
+                if(child.isType(ValueType::Array) || child.isType(ValueType::Object))
+                {
+                    DynamicVariable copy(child.getValueType());
+                    pending.emplace_back(child, copy);
+                    return copy;
+                }
+
+                DynamicVariable copy;
+                copy = child;
+                return copy;
+            };
+
+            while(!pending.empty())
+            {
+                auto [source, target] = std::move(pending.back());
+                pending.pop_back();
+                if(source.isType(ValueType::Array))
+                {
+                    for(DynamicVariable::SizeType i = 0, imax = source.size(); i < imax; ++i)
+                    {
+                        target.push(cloneChild(source[i]));
+                    }
+                }
+                else
+                {
+                    static_cast<const AbstractObjectValue &>(*source.internalValue()).forEach(
+                      [&](DynamicVariable::StringViewType key, const AbstractValue::Ptr &child) {
+                          target.set(key, cloneChild(DynamicVariable(child)));
+                      });
+                }
+            }
+
+            return result;
+        }
+    } // namespace detail
+} // namespace FDVar
+
+#endif // FDVAR_CLONEVALUE_H
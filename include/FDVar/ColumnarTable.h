@@ -0,0 +1,698 @@
+#ifndef FDVAR_COLUMNARTABLE_H
+#define FDVAR_COLUMNARTABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+
+namespace FDVar
+{
+    // Struct-of-arrays copy of an array of objects: one packed column per member name, so scans,
+    // filters and aggregates walk contiguous memory instead of looking a member up per row.
+    // Integer, Float and Boolean members are stored unboxed; strings are dictionary encoded.
+    // A column mixing Integer and Float becomes Float; any other mix, or a member that is an
+    // array, object or another value type, is rejected. The table is a snapshot and does not
+    // follow later changes to the source array.
+    class ColumnarTable
+    {
+      public:
+        typedef DynamicVariable::SizeType SizeType;
+        typedef DynamicVariable::IntType IntType;
+        typedef DynamicVariable::FloatType FloatType;
+        typedef DynamicVariable::StringType StringType;
+        typedef DynamicVariable::StringViewType StringViewType;
+        typedef uint32_t CodeType;
+
+        // One entry per row, non-zero for selected rows.
+        typedef std::vector<uint8_t> MaskType;
+
+        enum class Comparison : uint8_t
+        {
+            Equal,
+            NotEqual,
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual
+        };
+
+        class Column
+        {
+            friend class ColumnarTable;
+
+          public:
+            enum class Kind : uint8_t
+            {
+                Null,
+                Integer,
+                Float,
+                Boolean,
+                String
+            };
+
+            // Missing rows lack the member; Null rows hold it as None.
+            enum class State : uint8_t
+            {
+                Missing,
+                Null,
+                Value
+            };
+
+          private:
+            StringType m_name;
+            Kind m_kind;
+            std::vector<State> m_states;
+            std::vector<IntType> m_integers;
+            std::vector<FloatType> m_floats;
+            std::vector<uint8_t> m_booleans;
+            std::vector<CodeType> m_codes;
+            std::vector<StringType> m_dictionary;
+
+          public:
+            explicit Column(StringType name) : m_name(std::move(name)), m_kind(Kind::Null) {}
+
+            const StringType &name() const { return m_name; }
+            Kind kind() const { return m_kind; }
+            SizeType size() const { return m_states.size(); }
+
+            const std::vector<State> &states() const { return m_states; }
+            bool hasValue(SizeType row) const { return m_states[row] == State::Value; }
+
+            // Only the vector matching kind() is filled; rows without a value hold zero.
+            const std::vector<IntType> &integers() const { return m_integers; }
+            const std::vector<FloatType> &floats() const { return m_floats; }
+            const std::vector<uint8_t> &booleans() const { return m_booleans; }
+            const std::vector<CodeType> &codes() const { return m_codes; }
+            const std::vector<StringType> &dictionary() const { return m_dictionary; }
+
+            DynamicVariable value(SizeType row) const
+            {
+                if(m_states[row] != State::Value)
+                {
+                    return DynamicVariable();
+                }
+
+                switch(m_kind)
+                {
+                    case Kind::Integer:
+                        return DynamicVariable(m_integers[row]);
+                    case Kind::Float:
+                        return DynamicVariable(m_floats[row]);
+                    case Kind::Boolean:
+                        return DynamicVariable(m_booleans[row] != 0);
+                    case Kind::String:
+                        return DynamicVariable(StringViewType(m_dictionary[m_codes[row]]));
+                    default:
+                        return DynamicVariable();
+                }
+            }
+        };
+
+      private:
+        struct Builder
+        {
+            Column column;
+            std::unordered_map<StringType, CodeType> codes;
+        };
+
+        std::vector<Column> m_columns;
+        SizeType m_rows;
+
+      public:
+        ColumnarTable() : m_rows(0) {}
+
+        explicit ColumnarTable(const DynamicVariable &array) : m_rows(0)
+        {
+            if(!array.isType(ValueType::Array))
+            {
+                throw std::invalid_argument("ColumnarTable: value is not an array");
+            }
+
+            const auto &rows = static_cast<const AbstractArrayValue &>(*array.internalValue());
+            std::vector<Builder> builders;
+            std::unordered_map<StringType, SizeType> positions;
+            for(SizeType row = 0, imax = rows.size(); row < imax; ++row)
+            {
+                const AbstractValue::Ptr &element = rows[row];
+                if(!element || !element->isType(ValueType::Object))
+                {
+                    throw std::invalid_argument("ColumnarTable: element is not an object");
+                }
+
+                static_cast<const AbstractObjectValue &>(*element).forEach(
+                  [&](StringViewType key, const AbstractValue::Ptr &value) {
+                      auto where = positions.find(StringType(key));
+                      if(where == positions.end())
+                      {
+                          where = positions.emplace(StringType(key), builders.size()).first;
+                          builders.push_back(Builder { Column(StringType(key)), {} });
+                          pad(builders.back().column, row);
+                      }
+
+                      append(builders[where->second], value);
+                  });
+
+                m_rows = row + 1;
+                for(Builder &builder: builders)
+                {
+                    pad(builder.column, m_rows);
+                }
+            }
+
+            m_columns.reserve(builders.size());
+            for(Builder &builder: builders)
+            {
+                m_columns.push_back(std::move(builder.column));
+            }
+
+            std::sort(m_columns.begin(), m_columns.end(),
+                      [](const Column &lhs, const Column &rhs) { return lhs.m_name < rhs.m_name; });
+        }
+
+        SizeType rows() const { return m_rows; }
+        const std::vector<Column> &columns() const { return m_columns; }
+
+        bool contains(StringViewType name) const
+        {
+            auto where = findColumn(name);
+            return where != m_columns.end() && where->m_name == name;
+        }
+
+        const Column &column(StringViewType name) const
+        {
+            auto where = findColumn(name);
+            if(where == m_columns.end() || where->m_name != name)
+            {
+                throw std::out_of_range("ColumnarTable: no such column");
+            }
+
+            return *where;
+        }
+
+        // Rows whose value compares to operand as requested, within mask when one is given.
+        // Rows without a value never match. Integer and Float operands compare with both numeric
+        // column kinds; a string operand is compared once per dictionary entry.
+        MaskType filter(StringViewType name,
+                        Comparison comparison,
+                        const DynamicVariable &operand,
+                        const MaskType *mask = nullptr) const
+        {
+            const Column &col = column(name);
+            MaskType result = selected(col, mask);
+            bool integer = operand.isType(ValueType::Integer);
+            switch(col.m_kind)
+            {
+                case Column::Kind::Null:
+                    std::fill(result.begin(), result.end(), 0);
+                    break;
+
+                case Column::Kind::Integer:
+                    if(integer)
+                    {
+                        compare(result, col.m_integers, static_cast<IntType>(operand), comparison);
+                    }
+                    else
+                    {
+                        compare(result, col.m_integers, number(operand), comparison);
+                    }
+
+                    break;
+
+                case Column::Kind::Float:
+                    compare(result, col.m_floats, number(operand), comparison);
+                    break;
+
+                case Column::Kind::Boolean:
+                    if(!operand.isType(ValueType::Boolean))
+                    {
+                        throw std::invalid_argument("ColumnarTable::filter: operand type mismatch");
+                    }
+
+                    compare(result, col.m_booleans, uint8_t(static_cast<bool>(operand)),
+                            comparison);
+                    break;
+
+                case Column::Kind::String:
+                {
+                    if(!operand.isType(ValueType::String))
+                    {
+                        throw std::invalid_argument("ColumnarTable::filter: operand type mismatch");
+                    }
+
+                    std::vector<uint8_t> matches(col.m_dictionary.size());
+                    compare(matches, col.m_dictionary, StringType(operand.view()), comparison,
+                            false);
+                    for(SizeType i = 0; i < m_rows; ++i)
+                    {
+                        result[i] &= matches[col.m_codes[i]];
+                    }
+
+                    break;
+                }
+            }
+
+            return result;
+        }
+
+        // Rows with a value, within mask when one is given.
+        SizeType count(StringViewType name, const MaskType *mask = nullptr) const
+        {
+            MaskType rows = selected(column(name), mask);
+            SizeType total = 0;
+            for(uint8_t row: rows)
+            {
+                total += row;
+            }
+
+            return total;
+        }
+
+        // Integer for Integer columns, wrapping like ArithmeticPolicy::Wrap; Float for Float
+        // columns; the number of true values for Boolean columns.
+        DynamicVariable sum(StringViewType name, const MaskType *mask = nullptr) const
+        {
+            const Column &col = column(name);
+            MaskType rows = selected(col, mask);
+            switch(col.m_kind)
+            {
+                case Column::Kind::Null:
+                    return DynamicVariable(IntType(0));
+
+                case Column::Kind::Integer:
+                {
+                    typedef std::make_unsigned_t<IntType> UnsignedType;
+                    UnsignedType total = 0;
+                    for(SizeType i = 0; i < m_rows; ++i)
+                    {
+                        total += static_cast<UnsignedType>(col.m_integers[i]) &
+                                 (UnsignedType(0) - rows[i]);
+                    }
+
+                    return DynamicVariable(static_cast<IntType>(total));
+                }
+
+                case Column::Kind::Float:
+                {
+                    FloatType total = 0;
+                    for(SizeType i = 0; i < m_rows; ++i)
+                    {
+                        total += rows[i] ? col.m_floats[i] : FloatType(0);
+                    }
+
+                    return DynamicVariable(total);
+                }
+
+                case Column::Kind::Boolean:
+                {
+                    IntType total = 0;
+                    for(SizeType i = 0; i < m_rows; ++i)
+                    {
+                        total += col.m_booleans[i] & rows[i];
+                    }
+
+                    return DynamicVariable(total);
+                }
+
+                default:
+                    throw std::invalid_argument("ColumnarTable::sum: column is not numeric");
+            }
+        }
+
+        // Float, or None when no row has a value.
+        DynamicVariable mean(StringViewType name, const MaskType *mask = nullptr) const
+        {
+            const Column &col = column(name);
+            if(col.m_kind == Column::Kind::String)
+            {
+                throw std::invalid_argument("ColumnarTable::mean: column is not numeric");
+            }
+
+            SizeType rows = count(name, mask);
+            if(rows == 0)
+            {
+                return DynamicVariable();
+            }
+
+            if(col.m_kind == Column::Kind::Integer)
+            {
+                MaskType selection = selected(col, mask);
+                FloatType total = 0;
+                for(SizeType i = 0; i < m_rows; ++i)
+                {
+                    total += selection[i] ? FloatType(col.m_integers[i]) : FloatType(0);
+                }
+
+                return DynamicVariable(total / FloatType(rows));
+            }
+
+            DynamicVariable total = sum(name, mask);
+            return DynamicVariable(
+              (total.isType(ValueType::Float) ? static_cast<FloatType>(total)
+                                              : FloatType(static_cast<IntType>(total))) /
+              FloatType(rows));
+        }
+
+        // The smallest and largest value, or None when no row has a value.
+        DynamicVariable min(StringViewType name, const MaskType *mask = nullptr) const
+        {
+            return extreme(column(name), mask, std::less<>());
+        }
+
+        DynamicVariable max(StringViewType name, const MaskType *mask = nullptr) const
+        {
+            return extreme(column(name), mask, std::greater<>());
+        }
+
+      private:
+        typename std::vector<Column>::const_iterator findColumn(StringViewType name) const
+        {
+            return std::lower_bound(
+              m_columns.begin(), m_columns.end(), name,
+              [](const Column &column, StringViewType key) { return column.m_name < key; });
+        }
+
+        MaskType selected(const Column &col, const MaskType *mask) const
+        {
+            if(mask != nullptr && mask->size() != m_rows)
+            {
+                throw std::invalid_argument("ColumnarTable: mask size does not match the rows");
+            }
+
+            MaskType result(m_rows);
+            for(SizeType i = 0; i < m_rows; ++i)
+            {
+                result[i] = uint8_t(col.m_states[i] == Column::State::Value);
+            }
+
+            if(mask != nullptr)
+            {
+                for(SizeType i = 0; i < m_rows; ++i)
+                {
+                    result[i] &= uint8_t((*mask)[i] != 0);
+                }
+            }
+
+            return result;
+        }
+
+        static FloatType number(const DynamicVariable &operand)
+        {
+            if(operand.isType(ValueType::Integer))
+            {
+                return FloatType(static_cast<IntType>(operand));
+            }
+
+            if(!operand.isType(ValueType::Float))
+            {
+                throw std::invalid_argument("ColumnarTable::filter: operand type mismatch");
+            }
+
+            return static_cast<FloatType>(operand);
+        }
+
+        // result[i] &= values[i] <comparison> operand; with combine false the result is assigned.
+        template<typename ResultType, typename T, typename U>
+        static void compare(ResultType &result,
+                            const std::vector<T> &values,
+                            const U &operand,
+                            Comparison comparison,
+                            bool combine = true)
+        {
+            switch(comparison)
+            {
+                case Comparison::Equal:
+                    compareWith(result, values, operand, std::equal_to<>(), combine);
+                    break;
+                case Comparison::NotEqual:
+                    compareWith(result, values, operand, std::not_equal_to<>(), combine);
+                    break;
+                case Comparison::Less:
+                    compareWith(result, values, operand, std::less<>(), combine);
+                    break;
+                case Comparison::LessEqual:
+                    compareWith(result, values, operand, std::less_equal<>(), combine);
+                    break;
+                case Comparison::Greater:
+                    compareWith(result, values, operand, std::greater<>(), combine);
+                    break;
+                case Comparison::GreaterEqual:
+                    compareWith(result, values, operand, std::greater_equal<>(), combine);
+                    break;
+            }
+        }
+
+        // Branch-free loops over packed values, which compilers can vectorize. A uint8_t store may
+        // alias anything, including Boolean column data and the vectors' own data pointers, so
+        // the loops take restrict pointers; otherwise every store forces a reload.
+        template<typename ResultType, typename T, typename U, typename CompareType>
+        static void compareWith(ResultType &result,
+                                const std::vector<T> &values,
+                                const U &operand,
+                                CompareType comp,
+                                bool combine)
+        {
+            if(combine)
+            {
+                compareInto<true>(result.data(), values.data(), values.size(), operand, comp);
+            }
+            else
+            {
+                compareInto<false>(result.data(), values.data(), values.size(), operand, comp);
+            }
+        }
+
+        template<bool Combine, typename T, typename U, typename CompareType>
+        static void compareInto(uint8_t *__restrict out,
+                                const T *__restrict values,
+                                SizeType size,
+                                const U operand,
+                                CompareType comp)
+        {
+            for(SizeType i = 0; i < size; ++i)
+            {
+                if constexpr(Combine)
+                {
+                    out[i] &= uint8_t(comp(values[i], operand));
+                }
+                else
+                {
+                    out[i] = uint8_t(comp(values[i], operand));
+                }
+            }
+        }
+
+        template<typename CompareType>
+        DynamicVariable extreme(const Column &col, const MaskType *mask, CompareType comp) const
+        {
+            MaskType rows = selected(col, mask);
+            SizeType best = m_rows;
+            auto pick = [&](const auto &values, const auto &key) {
+                for(SizeType i = 0; i < m_rows; ++i)
+                {
+                    if(rows[i] && (best == m_rows || comp(key(values[i]), key(values[best]))))
+                    {
+                        best = i;
+                    }
+                }
+            };
+
+            auto identity = [](const auto &value) -> const auto & { return value; };
+            switch(col.m_kind)
+            {
+                case Column::Kind::Integer:
+                    pick(col.m_integers, identity);
+                    break;
+                case Column::Kind::Float:
+                    pick(col.m_floats, identity);
+                    break;
+                case Column::Kind::Boolean:
+                    pick(col.m_booleans, identity);
+                    break;
+                case Column::Kind::String:
+                    pick(col.m_codes,
+                         [&col](CodeType code) -> const StringType & {
+                             return col.m_dictionary[code];
+                         });
+                    break;
+                default:
+                    break;
+            }
+
+            return best == m_rows ? DynamicVariable() : col.value(best);
+        }
+
+        static void pad(Column &column, SizeType rows)
+        {
+            if(column.m_states.size() >= rows)
+            {
+                return;
+            }
+
+            column.m_states.resize(rows, Column::State::Missing);
+            switch(column.m_kind)
+            {
+                case Column::Kind::Integer:
+                    column.m_integers.resize(rows);
+                    break;
+                case Column::Kind::Float:
+                    column.m_floats.resize(rows);
+                    break;
+                case Column::Kind::Boolean:
+                    column.m_booleans.resize(rows);
+                    break;
+                case Column::Kind::String:
+                    column.m_codes.resize(rows);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        static void append(Builder &builder, const AbstractValue::Ptr &value)
+        {
+            Column &column = builder.column;
+            SizeType row = column.m_states.size();
+            ValueType type = value ? value->getValueType() : ValueType::None;
+            if(type == ValueType::None)
+            {
+                pad(column, row + 1);
+                column.m_states[row] = Column::State::Null;
+                return;
+            }
+
+            Column::Kind kind = kindOf(type);
+            if(column.m_kind == Column::Kind::Null)
+            {
+                column.m_kind = kind;
+            }
+            else if(column.m_kind == Column::Kind::Integer && kind == Column::Kind::Float)
+            {
+                column.m_kind = Column::Kind::Float;
+                column.m_floats.assign(column.m_integers.begin(), column.m_integers.end());
+                column.m_integers = std::vector<IntType>();
+            }
+            else if(column.m_kind != kind &&
+                    !(column.m_kind == Column::Kind::Float && kind == Column::Kind::Integer))
+            {
+                throw std::invalid_argument("ColumnarTable: column mixes value types");
+            }
+
+            pad(column, row + 1);
+            column.m_states[row] = Column::State::Value;
+            switch(type)
+            {
+                case ValueType::Integer:
+                {
+                    auto number =
+                      static_cast<IntType>(static_cast<const IntValue &>(*value));
+                    if(column.m_kind == Column::Kind::Float)
+                    {
+                        column.m_floats[row] = FloatType(number);
+                    }
+                    else
+                    {
+                        column.m_integers[row] = number;
+                    }
+
+                    break;
+                }
+
+                case ValueType::Float:
+                    column.m_floats[row] =
+                      static_cast<FloatType>(static_cast<const FloatValue &>(*value));
+                    break;
+
+                case ValueType::Boolean:
+                    column.m_booleans[row] =
+                      uint8_t(static_cast<bool>(static_cast<const BoolValue &>(*value)));
+                    break;
+
+                default:
+                {
+                    StringType text(static_cast<const StringValue &>(*value).view());
+                    auto where = builder.codes.find(text);
+                    if(where == builder.codes.end())
+                    {
+                        if(column.m_dictionary.size() > std::numeric_limits<CodeType>::max())
+                        {
+                            throw std::overflow_error("ColumnarTable: too many distinct strings");
+                        }
+
+                        where = builder.codes
+                                  .emplace(text, static_cast<CodeType>(column.m_dictionary.size()))
+                                  .first;
+                        column.m_dictionary.push_back(std::move(text));
+                    }
+
+                    column.m_codes[row] = where->second;
+                    break;
+                }
+            }
+        }
+
+        static Column::Kind kindOf(ValueType type)
+        {
+            switch(type)
+            {
+                case ValueType::Integer:
+                    return Column::Kind::Integer;
+                case ValueType::Float:
+                    return Column::Kind::Float;
+                case ValueType::Boolean:
+                    return Column::Kind::Boolean;
+                case ValueType::String:
+                    return Column::Kind::String;
+                default:
+                    throw std::invalid_argument("ColumnarTable: unsupported value type " +
+                                                std::to_string(type));
+            }
+        }
+    };
+
+    inline ColumnarTable toColumnar(const DynamicVariable &array) { return ColumnarTable(array); }
+
+    // Rebuilds the array of objects, or only the rows in mask. Missing members stay missing and
+    // Null ones come back as None; Integer values of a Float column come back as Float.
+    inline DynamicVariable fromColumnar(const ColumnarTable &table,
+                                        const ColumnarTable::MaskType *mask = nullptr)
+    {
+        typedef ColumnarTable::Column Column;
+        if(mask != nullptr && mask->size() != table.rows())
+        {
+            throw std::invalid_argument("fromColumnar: mask size does not match the rows");
+        }
+
+        DynamicVariable::ArrayType rows;
+        rows.reserve(table.rows());
+        for(ColumnarTable::SizeType row = 0; row < table.rows(); ++row)
+        {
+            if(mask != nullptr && !(*mask)[row])
+            {
+                continue;
+            }
+
+            DynamicVariable::ObjectType members;
+            for(const Column &column: table.columns())
+            {
+                if(column.states()[row] != Column::State::Missing)
+                {
+                    members.emplace(column.name(), column.value(row).internalValue());
+                }
+            }
+
+            rows.push_back(DynamicVariable(std::move(members)).internalValue());
+        }
+
+        return DynamicVariable(std::move(rows));
+    }
+} // namespace FDVar
+
+#endif // FDVAR_COLUMNARTABLE_H
@@ -0,0 +1,484 @@
+#ifndef FDVAR_DECIMALVALUE_H
+#define FDVAR_DECIMALVALUE_H
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <FDVar/AbstractValue.h>
+#include <FDVar/ArithmeticPolicy.h>
+#include <FDVar/BigIntegerValue.h>
+#include <FDVar/IntValue.h>
+
+namespace FDVar
+{
+    namespace detail
+    {
+        template<typename T, size_t N>
+        constexpr std::array<T, N> powersOfTen()
+        {
+            std::array<T, N> powers {};
+            T power = 1;
+            for(size_t i = 0; i < N; ++i)
+            {
+                powers[i] = power;
+                power = i + 1 < N ? power * 10 : power;
+            }
+
+            return powers;
+        }
+    } // namespace detail
+
+    // Exact decimal number: an IntType coefficient scaled by 10^-scale, so 19.99 is {1999, 2}.
+    // The scale a value was written with is kept (1.50 has scale 2) but does not affect
+    // equality or ordering. A result whose coefficient does not fit in IntType throws
+    // std::overflow_error; only division and scales beyond MAX_SCALE round, half to even.
+    class DecimalValue : public AbstractValue
+    {
+      public:
+        typedef IntValue::IntType IntType;
+        typedef uint8_t ScaleType;
+
+        static constexpr ScaleType MAX_SCALE = std::numeric_limits<IntType>::digits10;
+
+      private:
+        typedef std::make_unsigned_t<IntType> UnsignedType;
+        typedef arithmetic::Operation Operation;
+
+        static constexpr std::array<IntType, MAX_SCALE + 1> POWERS =
+          detail::powersOfTen<IntType, MAX_SCALE + 1>();
+
+        IntType m_coefficient;
+        ScaleType m_scale;
+
+      public:
+        DecimalValue() : m_coefficient(0), m_scale(0) {}
+
+        template<
+          typename T,
+          typename U = std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, T>>
+        explicit DecimalValue(T value) : m_coefficient(static_cast<IntType>(value)), m_scale(0)
+        {
+            if constexpr(std::is_unsigned_v<T> && sizeof(T) >= sizeof(IntType))
+            {
+                if(value > static_cast<T>(std::numeric_limits<IntType>::max()))
+                {
+                    throw std::overflow_error("DecimalValue: value does not fit in IntType");
+                }
+            }
+        }
+
+        DecimalValue(IntType coefficient, ScaleType scale) :
+            m_coefficient(coefficient),
+            m_scale(scale)
+        {
+            if(scale > MAX_SCALE)
+            {
+                throw std::invalid_argument("DecimalValue: scale out of range");
+            }
+        }
+
+        DecimalValue(DecimalValue &&) noexcept = default;
+        DecimalValue(const DecimalValue &) = default;
+
+        ~DecimalValue() noexcept override = default;
+
+        DecimalValue &operator=(DecimalValue &&) noexcept = default;
+        DecimalValue &operator=(const DecimalValue &) = default;
+
+        ValueType getValueType() const override { return ValueType::Decimal; }
+
+        // Accepts an optional sign, digits with an optional fraction and an optional exponent,
+        // as in "-12.50" or "1.5e3", in a single pass without allocating.
+        static DecimalValue parse(std::string_view text)
+        {
+            const char *it = text.data();
+            const char *end = it + text.size();
+            bool negative = false;
+            if(it != end && (*it == '-' || *it == '+'))
+            {
+                negative = *it == '-';
+                ++it;
+            }
+
+            UnsignedType limit = static_cast<UnsignedType>(std::numeric_limits<IntType>::max()) +
+                                 (negative ? 1 : 0);
+            UnsignedType magnitude = 0;
+            int scale = 0;
+            bool digits = false;
+            bool fraction = false;
+            for(; it != end; ++it)
+            {
+                if(*it == '.' && !fraction)
+                {
+                    fraction = true;
+                    continue;
+                }
+
+                if(*it < '0' || *it > '9')
+                {
+                    break;
+                }
+
+                auto digit = static_cast<UnsignedType>(*it - '0');
+                if(magnitude > (limit - digit) / 10)
+                {
+                    throw std::overflow_error("DecimalValue::parse: too many digits");
+                }
+
+                magnitude = magnitude * 10 + digit;
+                scale += fraction ? 1 : 0;
+                digits = true;
+            }
+
+            if(!digits)
+            {
+                throw std::invalid_argument("DecimalValue::parse: no digits");
+            }
+
+            if(it != end && (*it == 'e' || *it == 'E'))
+            {
+                int exponent = 0;
+                auto result = std::from_chars(it + 1 + (it + 1 != end && it[1] == '+'), end,
+                                              exponent);
+                if(result.ec != std::errc() || result.ptr == it + 1)
+                {
+                    throw std::invalid_argument("DecimalValue::parse: invalid exponent");
+                }
+
+                if(exponent > MAX_SCALE || exponent < -MAX_SCALE)
+                {
+                    throw std::overflow_error("DecimalValue::parse: exponent out of range");
+                }
+
+                scale -= exponent;
+                it = result.ptr;
+            }
+
+            if(it != end)
+            {
+                throw std::invalid_argument("DecimalValue::parse: unexpected character");
+            }
+
+            for(; scale < 0; ++scale)
+            {
+                if(magnitude > limit / 10)
+                {
+                    throw std::overflow_error("DecimalValue::parse: value out of range");
+                }
+
+                magnitude *= 10;
+            }
+
+            if(scale > MAX_SCALE)
+            {
+                throw std::overflow_error("DecimalValue::parse: too many fraction digits");
+            }
+
+            auto coefficient = static_cast<IntType>(negative ? UnsignedType(0) - magnitude
+                                                             : magnitude);
+            return DecimalValue(coefficient, static_cast<ScaleType>(scale));
+        }
+
+        IntType coefficient() const { return m_coefficient; }
+
+        ScaleType scale() const { return m_scale; }
+
+        bool isZero() const { return m_coefficient == 0; }
+
+        // Truncates toward zero, as converting a Float does.
+        IntType toInteger() const { return m_coefficient / POWERS[m_scale]; }
+
+        double toFloat() const
+        {
+            return static_cast<double>(m_coefficient) / static_cast<double>(POWERS[m_scale]);
+        }
+
+        std::string toString() const
+        {
+            char digits[std::numeric_limits<UnsignedType>::digits10 + 2];
+            auto magnitude = static_cast<UnsignedType>(m_coefficient);
+            if(m_coefficient < 0)
+            {
+                magnitude = UnsignedType(0) - magnitude;
+            }
+
+            auto count = static_cast<size_t>(
+              std::to_chars(digits, digits + sizeof(digits), magnitude).ptr - digits);
+
+            std::string result;
+            result.reserve(count + m_scale + 3);
+            if(m_coefficient < 0)
+            {
+                result += '-';
+            }
+
+            if(count <= m_scale)
+            {
+                result += "0.";
+                result.append(m_scale - count, '0');
+                result.append(digits, count);
+            }
+            else
+            {
+                result.append(digits, count - m_scale);
+                if(m_scale > 0)
+                {
+                    result += '.';
+                    result.append(digits + count - m_scale, m_scale);
+                }
+            }
+
+            return result;
+        }
+
+        // The same value with the given number of fraction digits.
+        DecimalValue rescale(ScaleType scale) const
+        {
+            if(scale > MAX_SCALE)
+            {
+                throw std::invalid_argument("DecimalValue: scale out of range");
+            }
+
+            if(scale >= m_scale)
+            {
+                return DecimalValue(scaleUp(m_coefficient, scale - m_scale), scale);
+            }
+
+            return DecimalValue(roundedQuotient(m_coefficient, POWERS[m_scale - scale]), scale);
+        }
+
+        // The same value without trailing fraction zeros; equal values normalize identically.
+        DecimalValue normalized() const
+        {
+            DecimalValue result(*this);
+            while(result.m_scale > 0 && result.m_coefficient % 10 == 0)
+            {
+                result.m_coefficient /= 10;
+                --result.m_scale;
+            }
+
+            return result;
+        }
+
+        int compare(const DecimalValue &other) const
+        {
+            if(m_scale == other.m_scale)
+            {
+                return threeWay(m_coefficient, other.m_coefficient);
+            }
+
+            bool finer = m_scale > other.m_scale;
+            const DecimalValue &coarse = finer ? other : *this;
+            const DecimalValue &fine = finer ? *this : other;
+            IntType scaled;
+            int result = 0;
+            if(arithmetic::overflow<Operation::Multiply>(
+                 coarse.m_coefficient, POWERS[fine.m_scale - coarse.m_scale], scaled))
+            {
+                // The coarse value lies beyond the range the fine one can reach.
+                result = coarse.m_coefficient < 0 ? -1 : 1;
+            }
+            else
+            {
+                result = threeWay(scaled, fine.m_coefficient);
+            }
+
+            return finer ? -result : result;
+        }
+
+        bool operator==(const DecimalValue &other) const { return compare(other) == 0; }
+        bool operator!=(const DecimalValue &other) const { return compare(other) != 0; }
+        bool operator<(const DecimalValue &other) const { return compare(other) < 0; }
+        bool operator<=(const DecimalValue &other) const { return compare(other) <= 0; }
+        bool operator>(const DecimalValue &other) const { return compare(other) > 0; }
+        bool operator>=(const DecimalValue &other) const { return compare(other) >= 0; }
+
+        DecimalValue operator-() const
+        {
+            return DecimalValue(checked<Operation::Subtract>(0, m_coefficient), m_scale);
+        }
+
+        DecimalValue operator+(const DecimalValue &other) const
+        {
+            ScaleType scale = std::max(m_scale, other.m_scale);
+            return DecimalValue(checked<Operation::Add>(scaleUp(m_coefficient, scale - m_scale),
+                                                        scaleUp(other.m_coefficient,
+                                                                scale - other.m_scale)),
+                                scale);
+        }
+
+        DecimalValue operator-(const DecimalValue &other) const
+        {
+            ScaleType scale = std::max(m_scale, other.m_scale);
+            return DecimalValue(
+              checked<Operation::Subtract>(scaleUp(m_coefficient, scale - m_scale),
+                                           scaleUp(other.m_coefficient, scale - other.m_scale)),
+              scale);
+        }
+
+        // Exact; the scales add up and round to MAX_SCALE beyond it.
+        DecimalValue operator*(const DecimalValue &other) const
+        {
+            IntType product;
+            if(arithmetic::overflow<Operation::Multiply>(m_coefficient, other.m_coefficient,
+                                                         product))
+            {
+                DecimalValue lhs = normalized();
+                DecimalValue rhs = other.normalized();
+                if(lhs.m_scale == m_scale && rhs.m_scale == other.m_scale)
+                {
+                    throw std::overflow_error("DecimalValue: product out of range");
+                }
+
+                return lhs * rhs;
+            }
+
+            unsigned scale = unsigned(m_scale) + other.m_scale;
+            if(scale <= MAX_SCALE)
+            {
+                return DecimalValue(product, static_cast<ScaleType>(scale));
+            }
+
+            return DecimalValue(roundedQuotient(product, POWERS[scale - MAX_SCALE]), MAX_SCALE);
+        }
+
+        // Rounds half to even at the larger of the two scales; divide() picks another scale.
+        DecimalValue operator/(const DecimalValue &other) const
+        {
+            return divide(other, std::max(m_scale, other.m_scale));
+        }
+
+        DecimalValue operator%(const DecimalValue &other) const
+        {
+            ScaleType scale = std::max(m_scale, other.m_scale);
+            return DecimalValue(checked<Operation::Modulo>(scaleUp(m_coefficient, scale - m_scale),
+                                                           scaleUp(other.m_coefficient,
+                                                                   scale - other.m_scale)),
+                                scale);
+        }
+
+        DecimalValue &operator+=(const DecimalValue &other) { return *this = *this + other; }
+        DecimalValue &operator-=(const DecimalValue &other) { return *this = *this - other; }
+        DecimalValue &operator*=(const DecimalValue &other) { return *this = *this * other; }
+        DecimalValue &operator/=(const DecimalValue &other) { return *this = *this / other; }
+        DecimalValue &operator%=(const DecimalValue &other) { return *this = *this % other; }
+
+        DecimalValue divide(const DecimalValue &other, ScaleType scale) const
+        {
+            if(other.m_coefficient == 0)
+            {
+                throw std::domain_error("DecimalValue: division by zero");
+            }
+
+            if(scale > MAX_SCALE)
+            {
+                throw std::invalid_argument("DecimalValue: scale out of range");
+            }
+
+            // coefficient = this * 10^shift / other, shifting whichever side needs it.
+            int shift = int(scale) + other.m_scale - m_scale;
+            IntType numerator = m_coefficient;
+            IntType divisor = other.m_coefficient;
+            bool narrow = shift >= 0
+                            ? shift <= MAX_SCALE &&
+                                !arithmetic::overflow<Operation::Multiply>(
+                                  m_coefficient, POWERS[shift], numerator)
+                            : !arithmetic::overflow<Operation::Multiply>(
+                                other.m_coefficient, POWERS[-shift], divisor);
+            if(narrow && (divisor != -1 || numerator != std::numeric_limits<IntType>::min()))
+            {
+                return DecimalValue(roundedQuotient(numerator, divisor), scale);
+            }
+
+            return DecimalValue(roundedWideQuotient(m_coefficient, other.m_coefficient, shift),
+                                scale);
+        }
+
+      private:
+        template<typename T>
+        static int threeWay(T lhs, T rhs)
+        {
+            return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+        }
+
+        template<Operation O>
+        static IntType checked(IntType lhs, IntType rhs)
+        {
+            return arithmetic::apply<ArithmeticPolicy::Checked, O>(lhs, rhs);
+        }
+
+        static IntType scaleUp(IntType coefficient, unsigned digits)
+        {
+            return digits == 0 ? coefficient
+                               : checked<Operation::Multiply>(coefficient, POWERS[digits]);
+        }
+
+        static UnsignedType magnitudeOf(IntType value)
+        {
+            auto magnitude = static_cast<UnsignedType>(value);
+            return value < 0 ? UnsignedType(0) - magnitude : magnitude;
+        }
+
+        // numerator / divisor rounded half to even; the quotient must not overflow.
+        static IntType roundedQuotient(IntType numerator, IntType divisor)
+        {
+            IntType quotient = numerator / divisor;
+            IntType remainder = numerator % divisor;
+            if(remainder == 0)
+            {
+                return quotient;
+            }
+
+            UnsignedType twice = magnitudeOf(remainder) * 2;
+            UnsignedType limit = magnitudeOf(divisor);
+            if(twice > limit || (twice == limit && quotient % 2 != 0))
+            {
+                quotient += (numerator < 0) != (divisor < 0) ? -1 : 1;
+            }
+
+            return quotient;
+        }
+
+        // roundedQuotient for operands scaled past IntType; the result must still fit.
+        static IntType roundedWideQuotient(IntType numerator, IntType divisor, int shift)
+        {
+            BigIntegerValue lhs(numerator);
+            BigIntegerValue rhs(divisor);
+            BigIntegerValue &scaled = shift >= 0 ? lhs : rhs;
+            for(int digits = shift >= 0 ? shift : -shift; digits > 0; digits -= MAX_SCALE)
+            {
+                scaled *= BigIntegerValue(POWERS[std::min<int>(digits, MAX_SCALE)]);
+            }
+
+            BigIntegerValue quotient = lhs / rhs;
+            BigIntegerValue remainder = lhs % rhs;
+            if(!remainder.isZero())
+            {
+                BigIntegerValue twice = remainder * BigIntegerValue(2);
+                int order = (twice.isNegative() ? -twice : twice)
+                              .compare(rhs.isNegative() ? -rhs : rhs);
+                bool odd = !quotient.isZero() && (quotient.limbs()[0] & 1) != 0;
+                if(order > 0 || (order == 0 && odd))
+                {
+                    quotient += BigIntegerValue(lhs.isNegative() != rhs.isNegative() ? -1 : 1);
+                }
+            }
+
+            if(!quotient.fitsInteger())
+            {
+                throw std::overflow_error("DecimalValue: quotient out of range");
+            }
+
+            return quotient.toInteger();
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_DECIMALVALUE_H
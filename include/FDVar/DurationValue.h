@@ -0,0 +1,292 @@
+#ifndef FDVAR_DURATIONVALUE_H
+#define FDVAR_DURATIONVALUE_H
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <FDVar/AbstractValue.h>
+#include <FDVar/ArithmeticPolicy.h>
+#include <FDVar/IntValue.h>
+
+namespace FDVar
+{
+    namespace detail
+    {
+        constexpr int64_t MICROSECONDS_PER_SECOND = 1000000;
+
+        // Reads the digits after a decimal sign as microseconds; digits past the sixth are
+        // validated and truncated.
+        inline const char *parseFraction(const char *it, const char *end, int64_t &microseconds)
+        {
+            const char *start = it;
+            int64_t scale = MICROSECONDS_PER_SECOND;
+            microseconds = 0;
+            for(; it != end && static_cast<unsigned>(*it - '0') <= 9; ++it)
+            {
+                scale /= 10;
+                microseconds += (*it - '0') * scale;
+            }
+
+            if(it == start)
+            {
+                throw std::invalid_argument("parse: no fraction digits");
+            }
+
+            return it;
+        }
+
+        // Writes '.' and the fraction digits without trailing zeros, or nothing for zero.
+        inline char *writeFraction(char *out, int64_t microseconds)
+        {
+            if(microseconds == 0)
+            {
+                return out;
+            }
+
+            *out++ = '.';
+            for(int64_t scale = MICROSECONDS_PER_SECOND / 10; microseconds != 0; scale /= 10)
+            {
+                *out++ = static_cast<char>('0' + microseconds / scale);
+                microseconds %= scale;
+            }
+
+            return out;
+        }
+    } // namespace detail
+
+    // Signed span of time with microsecond resolution. Text uses the ISO 8601 duration form
+    // with fixed-length units only: weeks, days (24 hours), hours, minutes and seconds.
+    class DurationValue : public AbstractValue
+    {
+      public:
+        typedef IntValue::IntType IntType;
+        typedef std::chrono::duration<IntType, std::micro> DurationType;
+
+      private:
+        typedef arithmetic::Operation Operation;
+        typedef std::make_unsigned_t<IntType> UnsignedType;
+
+        DurationType m_value;
+
+      public:
+        DurationValue() : m_value(0) {}
+
+        template<typename Rep, typename Period>
+        explicit DurationValue(std::chrono::duration<Rep, Period> value) :
+            m_value(std::chrono::duration_cast<DurationType>(value))
+        {
+        }
+
+        DurationValue(DurationValue &&) noexcept = default;
+        DurationValue(const DurationValue &) = default;
+
+        ~DurationValue() noexcept override = default;
+
+        DurationValue &operator=(DurationValue &&) noexcept = default;
+        DurationValue &operator=(const DurationValue &) = default;
+
+        ValueType getValueType() const override { return ValueType::Duration; }
+
+        // Accepts an optional sign and "P[nW][nD][T[nH][nM][n[.f]S]]", as in "PT1H30M" or
+        // "-P2DT0.5S". Years and months have no fixed length and are rejected.
+        static DurationValue parse(std::string_view text)
+        {
+            constexpr char DESIGNATORS[] = "WDHMS";
+            constexpr IntType UNITS[] = { 604800 * detail::MICROSECONDS_PER_SECOND,
+                                          86400 * detail::MICROSECONDS_PER_SECOND,
+                                          3600 * detail::MICROSECONDS_PER_SECOND,
+                                          60 * detail::MICROSECONDS_PER_SECOND,
+                                          detail::MICROSECONDS_PER_SECOND };
+
+            const char *it = text.data();
+            const char *end = it + text.size();
+            bool negative = false;
+            if(it != end && (*it == '-' || *it == '+'))
+            {
+                negative = *it == '-';
+                ++it;
+            }
+
+            if(it == end || *it != 'P')
+            {
+                throw std::invalid_argument("DurationValue::parse: expected 'P'");
+            }
+
+            IntType total = 0;
+            size_t next = 0;
+            bool time = false;
+            bool empty = true;
+            for(++it; it != end;)
+            {
+                if(*it == 'T' && !time)
+                {
+                    time = true;
+                    next = 2;
+                    empty = true;
+                    ++it;
+                    continue;
+                }
+
+                const char *start = it;
+                IntType number = 0;
+                for(; it != end && static_cast<unsigned>(*it - '0') <= 9; ++it)
+                {
+                    number = checked<Operation::Add>(checked<Operation::Multiply>(number, 10),
+                                                     *it - '0');
+                }
+
+                int64_t fraction = 0;
+                bool fractional = it != end && (*it == '.' || *it == ',') && it != start;
+                if(fractional)
+                {
+                    it = detail::parseFraction(it + 1, end, fraction);
+                }
+
+                if(it == start || it == end)
+                {
+                    throw std::invalid_argument("DurationValue::parse: expected a number and unit");
+                }
+
+                if(!time && (*it == 'Y' || *it == 'M'))
+                {
+                    throw std::invalid_argument(
+                      "DurationValue::parse: years and months have no fixed length");
+                }
+
+                size_t unit = next;
+                while(unit < 5 && DESIGNATORS[unit] != *it)
+                {
+                    ++unit;
+                }
+
+                if(unit == 5 || (unit >= 2) != time || (fractional && unit != 4))
+                {
+                    throw std::invalid_argument("DurationValue::parse: unexpected designator");
+                }
+
+                total = checked<Operation::Add>(
+                  total, checked<Operation::Add>(checked<Operation::Multiply>(number, UNITS[unit]),
+                                                 fraction));
+                next = unit + 1;
+                empty = false;
+                ++it;
+            }
+
+            if(empty)
+            {
+                throw std::invalid_argument("DurationValue::parse: no components");
+            }
+
+            return DurationValue(DurationType(negative ? -total : total));
+        }
+
+        // Hours, minutes and seconds, as in "PT26H3M4.5S"; zero is "PT0S".
+        std::string toString() const
+        {
+            IntType count = m_value.count();
+            if(count == 0)
+            {
+                return "PT0S";
+            }
+
+            auto magnitude = static_cast<UnsignedType>(count);
+            magnitude = count < 0 ? UnsignedType(0) - magnitude : magnitude;
+            UnsignedType seconds = magnitude / detail::MICROSECONDS_PER_SECOND;
+
+            char buffer[48];
+            char *out = buffer;
+            char *last = buffer + sizeof(buffer);
+            if(count < 0)
+            {
+                *out++ = '-';
+            }
+
+            *out++ = 'P';
+            *out++ = 'T';
+            if(seconds >= 3600)
+            {
+                out = std::to_chars(out, last, seconds / 3600).ptr;
+                *out++ = 'H';
+            }
+
+            if(seconds / 60 % 60 != 0)
+            {
+                out = std::to_chars(out, last, seconds / 60 % 60).ptr;
+                *out++ = 'M';
+            }
+
+            auto microseconds = static_cast<int64_t>(magnitude % detail::MICROSECONDS_PER_SECOND);
+            if(seconds % 60 != 0 || microseconds != 0)
+            {
+                out = std::to_chars(out, last, seconds % 60).ptr;
+                out = detail::writeFraction(out, microseconds);
+                *out++ = 'S';
+            }
+
+            return std::string(buffer, out);
+        }
+
+        DurationType value() const { return m_value; }
+        IntType count() const { return m_value.count(); }
+
+        int compare(const DurationValue &other) const
+        {
+            return m_value < other.m_value ? -1 : (other.m_value < m_value ? 1 : 0);
+        }
+
+        bool operator==(const DurationValue &other) const { return m_value == other.m_value; }
+        bool operator!=(const DurationValue &other) const { return m_value != other.m_value; }
+        bool operator<(const DurationValue &other) const { return m_value < other.m_value; }
+        bool operator<=(const DurationValue &other) const { return m_value <= other.m_value; }
+        bool operator>(const DurationValue &other) const { return m_value > other.m_value; }
+        bool operator>=(const DurationValue &other) const { return m_value >= other.m_value; }
+
+        DurationValue operator-() const
+        {
+            return DurationValue(DurationType(checked<Operation::Subtract>(0, count())));
+        }
+
+        DurationValue operator+(const DurationValue &other) const
+        {
+            return DurationValue(DurationType(checked<Operation::Add>(count(), other.count())));
+        }
+
+        DurationValue operator-(const DurationValue &other) const
+        {
+            return DurationValue(
+              DurationType(checked<Operation::Subtract>(count(), other.count())));
+        }
+
+        DurationValue operator*(IntType factor) const
+        {
+            return DurationValue(DurationType(checked<Operation::Multiply>(count(), factor)));
+        }
+
+        // Truncates toward zero.
+        DurationValue operator/(IntType divisor) const
+        {
+            return DurationValue(DurationType(checked<Operation::Divide>(count(), divisor)));
+        }
+
+        // How many whole times other fits in this duration, truncated toward zero.
+        IntType operator/(const DurationValue &other) const
+        {
+            return checked<Operation::Divide>(count(), other.count());
+        }
+
+      private:
+        template<Operation O>
+        static IntType checked(IntType lhs, IntType rhs)
+        {
+            return arithmetic::apply<ArithmeticPolicy::Checked, O>(lhs, rhs);
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_DURATIONVALUE_H
@@ -3,6 +3,11 @@
 
 #include <math.h>
 
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
 #include <FDVar/DynamicVariable_ctors.h>
 #include <FDVar/DynamicVariable_fwd.h>
 #include <FDVar/DynamicVariable_stl.h>
@@ -21,6 +26,14 @@ namespace FDVar
         {
             result = static_cast<T>(toFloat());
         }
+        else if(isType(ValueType::BigInteger))
+        {
+            result = static_cast<T>(toBigInteger().toInteger());
+        }
+        else if(isType(ValueType::Decimal))
+        {
+            result = static_cast<T>(toDecimal().toInteger());
+        }
         else
         {
             throw generateCastException(__func__);
@@ -38,6 +51,14 @@ namespace FDVar
         {
             result = static_cast<T>(toFloat());
         }
+        else if(isType(ValueType::BigInteger))
+        {
+            result = static_cast<T>(toBigInteger().toFloat());
+        }
+        else if(isType(ValueType::Decimal))
+        {
+            result = static_cast<T>(toDecimal().toFloat());
+        }
         else
         {
             throw generateCastException(__func__);
@@ -58,6 +79,16 @@ namespace FDVar
             return toFloat() == value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().compare(BigIntegerValue(value)) == 0;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().compare(DecimalValue(value)) == 0;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -70,6 +101,16 @@ namespace FDVar
             return toFloat() == value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().toFloat() == value;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().toFloat() == value;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -87,6 +128,16 @@ namespace FDVar
             return toFloat() != value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().compare(BigIntegerValue(value)) != 0;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().compare(DecimalValue(value)) != 0;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -99,6 +150,16 @@ namespace FDVar
             return toFloat() != value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().toFloat() != value;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().toFloat() != value;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -116,6 +177,16 @@ namespace FDVar
             return toFloat() <= value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().compare(BigIntegerValue(value)) <= 0;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().compare(DecimalValue(value)) <= 0;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -128,6 +199,16 @@ namespace FDVar
             return toFloat() <= value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().toFloat() <= value;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().toFloat() <= value;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -145,6 +226,16 @@ namespace FDVar
             return toFloat() < value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().compare(BigIntegerValue(value)) < 0;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().compare(DecimalValue(value)) < 0;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -162,6 +253,16 @@ namespace FDVar
             return toFloat() < value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().toFloat() < value;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().toFloat() < value;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -179,6 +280,16 @@ namespace FDVar
             return toFloat() >= value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().compare(BigIntegerValue(value)) >= 0;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().compare(DecimalValue(value)) >= 0;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -191,6 +302,16 @@ namespace FDVar
             return toFloat() >= value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().toFloat() >= value;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().toFloat() >= value;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -208,6 +329,16 @@ namespace FDVar
             return toFloat() > value;
         }
 
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().compare(BigIntegerValue(value)) > 0;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().compare(DecimalValue(value)) > 0;
+        }
+
         throw generateCastException(__func__);
     }
 
@@ -215,6 +346,16 @@ namespace FDVar
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, bool>
       DynamicVariable::operator>(const T &value) const
     {
+        if(isType(ValueType::BigInteger))
+        {
+            return toBigInteger().toFloat() > value;
+        }
+
+        if(isType(ValueType::Decimal))
+        {
+            return toDecimal().toFloat() > value;
+        }
+
         if(!isType(ValueType::Float))
         {
             throw generateCastException(__func__);
@@ -230,10 +371,12 @@ namespace FDVar
         switch(getValueType())
         {
             case ValueType::Integer:
-            {
-                toInteger() += value;
-                return *this;
-            }
+                return assignInteger<arithmetic::Operation::Add>(static_cast<IntType>(value));
+
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return assignExact(arithmetic::Operation::Add,
+                                   DynamicVariable(static_cast<IntType>(value)));
 
             case ValueType::Float:
             {
@@ -260,6 +403,11 @@ namespace FDVar
                 toFloat() += value;
                 return *this;
 
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return assignExact(arithmetic::Operation::Add,
+                                   DynamicVariable(static_cast<FloatType>(value)));
+
             default:
                 throw generateCastException(__func__);
         }
@@ -272,10 +420,12 @@ namespace FDVar
         switch(getValueType())
         {
             case ValueType::Integer:
-            {
-                toInteger() -= value;
-                return *this;
-            }
+                return assignInteger<arithmetic::Operation::Subtract>(static_cast<IntType>(value));
+
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return assignExact(arithmetic::Operation::Subtract,
+                                   DynamicVariable(static_cast<IntType>(value)));
 
             case ValueType::Float:
             {
@@ -302,6 +452,11 @@ namespace FDVar
                 toFloat() -= value;
                 return *this;
 
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return assignExact(arithmetic::Operation::Subtract,
+                                   DynamicVariable(static_cast<FloatType>(value)));
+
             default:
                 throw generateCastException(__func__);
         }
@@ -309,12 +464,18 @@ namespace FDVar
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-      DynamicVariable::operator+(const T &value) const
+      DynamicVariable::operator+(const T &value) const &
     {
         switch(getValueType())
         {
             case ValueType::Integer:
-                return toInteger() + value;
+                return combineInteger<arithmetic::Operation::Add>(static_cast<IntType>(value));
+
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return combineExact(arithmetic::Operation::Add,
+                                    DynamicVariable(static_cast<IntType>(value)));
+
             case ValueType::Float:
                 return toFloat() + static_cast<FloatType>(value);
 
@@ -325,7 +486,7 @@ namespace FDVar
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
-      DynamicVariable::operator+(const T &value) const
+      DynamicVariable::operator+(const T &value) const &
     {
         switch(getValueType())
         {
@@ -335,6 +496,11 @@ namespace FDVar
             case ValueType::Float:
                 return toFloat() + value;
 
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return combineExact(arithmetic::Operation::Add,
+                                    DynamicVariable(static_cast<FloatType>(value)));
+
             default:
                 throw generateCastException(__func__);
         }
@@ -342,12 +508,17 @@ namespace FDVar
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-      DynamicVariable::operator-(const T &value) const
+      DynamicVariable::operator-(const T &value) const &
     {
         switch(getValueType())
         {
             case ValueType::Integer:
-                return toInteger() - value;
+                return combineInteger<arithmetic::Operation::Subtract>(static_cast<IntType>(value));
+
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return combineExact(arithmetic::Operation::Subtract,
+                                    DynamicVariable(static_cast<IntType>(value)));
 
             case ValueType::Float:
                 return toFloat() - static_cast<FloatType>(value);
@@ -359,7 +530,7 @@ namespace FDVar
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
-      DynamicVariable::operator-(const T &value) const
+      DynamicVariable::operator-(const T &value) const &
     {
         switch(getValueType())
         {
@@ -369,6 +540,11 @@ namespace FDVar
             case ValueType::Float:
                 return toFloat() - value;
 
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return combineExact(arithmetic::Operation::Subtract,
+                                    DynamicVariable(static_cast<FloatType>(value)));
+
             default:
                 throw generateCastException(__func__);
         }
@@ -378,25 +554,36 @@ namespace FDVar
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
       &DynamicVariable::operator%=(const T &value)
     {
+        if(isType(ValueType::BigInteger) || isType(ValueType::Decimal))
+        {
+            return assignExact(arithmetic::Operation::Modulo,
+                               DynamicVariable(static_cast<IntType>(value)));
+        }
+
         if(!isType(ValueType::Integer))
         {
             throw generateCastException(__func__);
         }
 
-        toInteger() %= value;
-        return *this;
+        return assignInteger<arithmetic::Operation::Modulo>(static_cast<IntType>(value));
     }
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-      DynamicVariable::operator%(const T &value) const
+      DynamicVariable::operator%(const T &value) const &
     {
+        if(isType(ValueType::BigInteger) || isType(ValueType::Decimal))
+        {
+            return combineExact(arithmetic::Operation::Modulo,
+                                DynamicVariable(static_cast<IntType>(value)));
+        }
+
         if(!isType(ValueType::Integer))
         {
             throw generateCastException(__func__);
         }
 
-        return toInteger() % value;
+        return combineInteger<arithmetic::Operation::Modulo>(static_cast<IntType>(value));
     }
 
     template<typename T>
@@ -406,10 +593,16 @@ namespace FDVar
         switch(getValueType())
         {
             case ValueType::Integer:
-            {
-                toInteger() *= value;
-                return *this;
-            }
+                return assignInteger<arithmetic::Operation::Multiply>(static_cast<IntType>(value));
+
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return assignExact(arithmetic::Operation::Multiply,
+                                   DynamicVariable(static_cast<IntType>(value)));
+
+            case ValueType::Duration:
+                return *this = combineTime(arithmetic::Operation::Multiply,
+                                           DynamicVariable(static_cast<IntType>(value)));
 
             case ValueType::Float:
             {
@@ -436,6 +629,11 @@ namespace FDVar
                 toFloat() *= value;
                 return *this;
 
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return assignExact(arithmetic::Operation::Multiply,
+                                   DynamicVariable(static_cast<FloatType>(value)));
+
             default:
                 throw generateCastException(__func__);
         }
@@ -443,12 +641,21 @@ namespace FDVar
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-      DynamicVariable::operator*(const T &value) const
+      DynamicVariable::operator*(const T &value) const &
     {
         switch(getValueType())
         {
             case ValueType::Integer:
-                return toInteger() * value;
+                return combineInteger<arithmetic::Operation::Multiply>(static_cast<IntType>(value));
+
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return combineExact(arithmetic::Operation::Multiply,
+                                    DynamicVariable(static_cast<IntType>(value)));
+
+            case ValueType::Duration:
+                return combineTime(arithmetic::Operation::Multiply,
+                                   DynamicVariable(static_cast<IntType>(value)));
 
             case ValueType::Float:
                 return toFloat() * static_cast<FloatType>(value);
@@ -460,7 +667,7 @@ namespace FDVar
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
-      DynamicVariable::operator*(const T &value) const
+      DynamicVariable::operator*(const T &value) const &
     {
         switch(getValueType())
         {
@@ -470,6 +677,11 @@ namespace FDVar
             case ValueType::Float:
                 return toFloat() * value;
 
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return combineExact(arithmetic::Operation::Multiply,
+                                    DynamicVariable(static_cast<FloatType>(value)));
+
             default:
                 throw generateCastException(__func__);
         }
@@ -482,10 +694,16 @@ namespace FDVar
         switch(getValueType())
         {
             case ValueType::Integer:
-            {
-                toInteger() /= value;
-                return *this;
-            }
+                return assignInteger<arithmetic::Operation::Divide>(static_cast<IntType>(value));
+
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return assignExact(arithmetic::Operation::Divide,
+                                   DynamicVariable(static_cast<IntType>(value)));
+
+            case ValueType::Duration:
+                return *this = combineTime(arithmetic::Operation::Divide,
+                                           DynamicVariable(static_cast<IntType>(value)));
 
             case ValueType::Float:
             {
@@ -512,6 +730,11 @@ namespace FDVar
                 toFloat() /= value;
                 return *this;
 
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return assignExact(arithmetic::Operation::Divide,
+                                   DynamicVariable(static_cast<FloatType>(value)));
+
             default:
                 throw generateCastException(__func__);
         }
@@ -519,12 +742,21 @@ namespace FDVar
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-      DynamicVariable::operator/(const T &value) const
+      DynamicVariable::operator/(const T &value) const &
     {
         switch(getValueType())
         {
             case ValueType::Integer:
-                return toInteger() / value;
+                return combineInteger<arithmetic::Operation::Divide>(static_cast<IntType>(value));
+
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return combineExact(arithmetic::Operation::Divide,
+                                    DynamicVariable(static_cast<IntType>(value)));
+
+            case ValueType::Duration:
+                return combineTime(arithmetic::Operation::Divide,
+                                   DynamicVariable(static_cast<IntType>(value)));
 
             case ValueType::Float:
                 return toFloat() / static_cast<FloatType>(value);
@@ -536,7 +768,7 @@ namespace FDVar
 
     template<typename T>
     std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
-      DynamicVariable::operator/(const T &value) const
+      DynamicVariable::operator/(const T &value) const &
     {
         switch(getValueType())
         {
@@ -546,11 +778,142 @@ namespace FDVar
             case ValueType::Float:
                 return toFloat() / value;
 
+            case ValueType::BigInteger:
+            case ValueType::Decimal:
+                return combineExact(arithmetic::Operation::Divide,
+                                    DynamicVariable(static_cast<FloatType>(value)));
+
             default:
                 throw generateCastException(__func__);
         }
     }
 
+    template<typename T>
+    std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, DynamicVariable>
+      DynamicVariable::operator+(const T &value) &&
+    {
+        if(!isUnique())
+        {
+            return std::as_const(*this) + value;
+        }
+
+        return std::move(*this += value);
+    }
+
+    template<typename T>
+    std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, DynamicVariable>
+      DynamicVariable::operator-(const T &value) &&
+    {
+        if(!isUnique())
+        {
+            return std::as_const(*this) - value;
+        }
+
+        return std::move(*this -= value);
+    }
+
+    template<typename T>
+    std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, DynamicVariable>
+      DynamicVariable::operator*(const T &value) &&
+    {
+        if(!isUnique())
+        {
+            return std::as_const(*this) * value;
+        }
+
+        return std::move(*this *= value);
+    }
+
+    template<typename T>
+    std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, DynamicVariable>
+      DynamicVariable::operator/(const T &value) &&
+    {
+        if(!isUnique())
+        {
+            return std::as_const(*this) / value;
+        }
+
+        return std::move(*this /= value);
+    }
+
+    template<typename T>
+    std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
+      DynamicVariable::operator%(const T &value) &&
+    {
+        if(!isUnique())
+        {
+            return std::as_const(*this) % value;
+        }
+
+        return std::move(*this %= value);
+    }
+
+    template<arithmetic::Operation O, ArithmeticPolicy P>
+    DynamicVariable &DynamicVariable::assignInteger(IntType value)
+    {
+        IntValue &node = toInteger();
+        auto current = static_cast<IntType>(node);
+        if constexpr(P == ArithmeticPolicy::PromoteToFloat)
+        {
+            IntType result;
+            FloatType real;
+            if(!arithmetic::promote<O>(current, value, result, real))
+            {
+                *this = FloatValue(real);
+                return *this;
+            }
+
+            node = result;
+        }
+        else if constexpr(P == ArithmeticPolicy::PromoteToBigInteger)
+        {
+            IntType result;
+            if(!arithmetic::fits<O>(current, value, result))
+            {
+                return assignExact(O, DynamicVariable(value));
+            }
+
+            node = result;
+        }
+        else
+        {
+            node = arithmetic::apply<P, O>(current, value);
+        }
+
+        return *this;
+    }
+
+    template<arithmetic::Operation O, ArithmeticPolicy P>
+    DynamicVariable DynamicVariable::combineInteger(IntType value) const
+    {
+        auto current = static_cast<IntType>(toInteger());
+        if constexpr(P == ArithmeticPolicy::PromoteToFloat)
+        {
+            IntType result;
+            FloatType real;
+            if(!arithmetic::promote<O>(current, value, result, real))
+            {
+                return FloatValue(real);
+            }
+
+            return IntValue(result);
+        }
+        else if constexpr(P == ArithmeticPolicy::PromoteToBigInteger)
+        {
+            IntType result;
+            if(!arithmetic::fits<O>(current, value, result))
+            {
+                return combineExact(O, DynamicVariable(value));
+            }
+
+            return IntValue(result);
+        }
+        else
+        {
+            return IntValue(arithmetic::apply<P, O>(current, value));
+        }
+    }
+
     DynamicVariable operator""_var(unsigned long long value) { return DynamicVariable(value); }
 
     DynamicVariable operator""_var(long double value) { return DynamicVariable(value); }
@@ -612,6 +975,22 @@ namespace FDVar
                 ::operator<<(stream, toFloat());
                 break;
 
+            case ValueType::BigInteger:
+                stream << toBigInteger().toString();
+                break;
+
+            case ValueType::Decimal:
+                stream << toDecimal().toString();
+                break;
+
+            case ValueType::Timestamp:
+                stream << toTimestamp().toString();
+                break;
+
+            case ValueType::Duration:
+                stream << toDuration().toString();
+                break;
+
             default:
                 throw generateCastException(__func__);
         }
@@ -825,6 +1204,23 @@ std::enable_if_t<!std::is_integral_v<StreamType> &&
             stream << static_cast<FDVar::DynamicVariable::FloatType>(value);
             break;
 
+        case FDVar::ValueType::BigInteger:
+            stream << static_cast<const FDVar::BigIntegerValue &>(*value.internalValue())
+                        .toString();
+            break;
+
+        case FDVar::ValueType::Decimal:
+            stream << static_cast<const FDVar::DecimalValue &>(*value.internalValue()).toString();
+            break;
+
+        case FDVar::ValueType::Timestamp:
+            stream << static_cast<const FDVar::TimestampValue &>(value).toString();
+            break;
+
+        case FDVar::ValueType::Duration:
+            stream << static_cast<const FDVar::DurationValue &>(value).toString();
+            break;
+
         case FDVar::ValueType::String:
             stream << static_cast<const FDVar::DynamicVariable::StringType &>(value);
             break;
@@ -883,4 +1279,19 @@ std::enable_if_t<!std::is_integral_v<StreamType> &&
     return stream;
 }
 
+template<>
+struct std::hash<FDVar::DynamicVariable>
+{
+    size_t operator()(const FDVar::DynamicVariable &value) const
+    {
+        return static_cast<size_t>(value.hash());
+    }
+};
+
+static_assert(sizeof(FDVar::DynamicVariable) == sizeof(FDVar::AbstractValue::Ptr),
+              "DynamicVariable must stay a bare shared_ptr");
+static_assert(std::is_nothrow_move_constructible_v<FDVar::DynamicVariable> &&
+                std::is_nothrow_move_assignable_v<FDVar::DynamicVariable>,
+              "DynamicVariable moves must not throw");
+
 #endif // FDVAR_DYNAMICVARIABLE_H
@@ -1,7 +1,15 @@
 #ifndef FDVAR_DYNAMICVARIABLE_FWD_H
 #define FDVAR_DYNAMICVARIABLE_FWD_H
 
+#ifndef FDVAR_FUNCTION_MAX_ARITY
+    #define FDVAR_FUNCTION_MAX_ARITY 8
+#endif // FDVAR_FUNCTION_MAX_ARITY
+
 #include <algorithm>
+#include <array>
+#if __has_include(<compare>)
+    #include <compare>
+#endif
 #include <deque>
 #include <forward_list>
 #include <initializer_list>
@@ -10,24 +18,60 @@
 #include <memory>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <FDVar/AbstractValue.h>
 
 #include <FDVar/AbstractArrayValue.h>
 #include <FDVar/AbstractObjectValue.h>
+#include <FDVar/ArithmeticPolicy.h>
 #include <FDVar/ArrayValue.h>
+#include <FDVar/BigIntegerValue.h>
 #include <FDVar/BoolValue.h>
+#include <FDVar/BytesValue.h>
+#include <FDVar/DecimalValue.h>
+#include <FDVar/DurationValue.h>
 #include <FDVar/FloatValue.h>
 #include <FDVar/FunctionValue.h>
 #include <FDVar/IntValue.h>
 #include <FDVar/ObjectValue.h>
 #include <FDVar/StringValue.h>
+#include <FDVar/TimestampValue.h>
 
 namespace FDVar
 {
     class DynamicVariable;
 
+    namespace detail
+    {
+        template<size_t, typename T>
+        using Repeat = T;
+
+        template<typename F, typename Sequence>
+        struct is_invocable_with_variables;
+
+        template<typename F, size_t... I>
+        struct is_invocable_with_variables<F, std::index_sequence<I...>>
+        {
+            constexpr static bool value = std::is_invocable_v<F &, Repeat<I, DynamicVariable>...>;
+        };
+
+        template<typename F, size_t Arity = 0>
+        constexpr size_t function_arity()
+        {
+            if constexpr(Arity > FDVAR_FUNCTION_MAX_ARITY ||
+                         is_invocable_with_variables<F, std::make_index_sequence<Arity>>::value)
+            {
+                return Arity;
+            }
+            else
+            {
+                return function_arity<F, Arity + 1>();
+            }
+        }
+    } // namespace detail
+
     template<typename T, typename U = void>
     struct is_DynamicVariable_constructible
     {
@@ -110,7 +154,7 @@ namespace FDVar
         constexpr static bool value = true;
     };
 
-    class DynamicVariable
+    class DynamicVariable final
     {
       public:
         typedef IntValue::IntType IntType;
@@ -129,7 +173,7 @@ namespace FDVar
         DynamicVariable();
         DynamicVariable(ValueType type);
 
-        DynamicVariable(DynamicVariable &&) = default;
+        DynamicVariable(DynamicVariable &&) noexcept = default;
         DynamicVariable(const DynamicVariable &);
 
         DynamicVariable(AbstractValue::Ptr &&value);
@@ -163,7 +207,7 @@ namespace FDVar
 
         explicit DynamicVariable(const FunctionType &value);
 
-        virtual ~DynamicVariable() = default;
+        ~DynamicVariable() = default;
 
         ValueType getValueType() const
         {
@@ -173,7 +217,7 @@ namespace FDVar
         bool isType(ValueType type) const { return type == getValueType(); }
 
         DynamicVariable &operator=(const DynamicVariable &);
-        DynamicVariable &operator=(DynamicVariable &&) = default;
+        DynamicVariable &operator=(DynamicVariable &&) noexcept = default;
 
         DynamicVariable &operator=(StringViewType str);
 
@@ -194,6 +238,9 @@ namespace FDVar
         explicit operator const StringType &() const;
         explicit operator const ArrayType &() const;
         explicit operator const ObjectType &() const;
+        explicit operator const BytesValue &() const;
+        explicit operator const TimestampValue &() const;
+        explicit operator const DurationValue &() const;
 
         template<typename T>
         explicit operator T() const
@@ -207,6 +254,28 @@ namespace FDVar
 
         bool operator!=(const DynamicVariable &value) const;
 
+        int compare(const DynamicVariable &value) const;
+
+        // Exact comparison of two numbers by value, whatever their numeric types: unlike
+        // compare(), Integer 1 and Float 1.0 compare equal. NaN sorts above every other number.
+        // Throws std::runtime_error when either value is not a number.
+        int compareNumber(const DynamicVariable &value) const;
+
+        bool operator<(const DynamicVariable &value) const { return compare(value) < 0; }
+
+        bool operator<=(const DynamicVariable &value) const { return compare(value) <= 0; }
+
+        bool operator>(const DynamicVariable &value) const { return compare(value) > 0; }
+
+        bool operator>=(const DynamicVariable &value) const { return compare(value) >= 0; }
+
+#ifdef __cpp_lib_three_way_comparison
+        std::weak_ordering operator<=>(const DynamicVariable &value) const
+        {
+            return compare(value) <=> 0;
+        }
+#endif // __cpp_lib_three_way_comparison
+
         bool operator==(std::nullptr_t) const;
 
         bool operator!=(std::nullptr_t) const;
@@ -287,6 +356,21 @@ namespace FDVar
 
         DynamicVariable operator()(const DynamicVariable &var) { return toFunction()(var.m_value); }
 
+        template<typename... Args>
+        std::enable_if_t<sizeof...(Args) != 1, DynamicVariable> operator()(Args &&...args)
+        {
+            std::array<AbstractValue::Ptr, sizeof...(Args)> arguments { toArgument(
+              std::forward<Args>(args))... };
+            return toFunction().call(arguments.data(), arguments.size());
+        }
+
+        template<typename F>
+        static DynamicVariable makeFunction(F &&func)
+        {
+            return DynamicVariable(
+              std::make_shared<FunctionValue>(makeCallable(std::forward<F>(func))));
+        }
+
         bool operator&&(bool other) const { return toBoolean() && other; }
         bool operator&&(const DynamicVariable &other) const
         {
@@ -337,27 +421,41 @@ namespace FDVar
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
           &operator-=(const T &value);
 
-        DynamicVariable operator+(StringViewType value) const;
+        DynamicVariable operator+(StringViewType value) const &;
 
-        DynamicVariable operator+(const DynamicVariable &value) const;
+        DynamicVariable operator+(const DynamicVariable &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-          operator+(const T &value) const;
+          operator+(const T &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
-          operator+(const T &value) const;
+          operator+(const T &value) const &;
 
-        DynamicVariable operator-(const DynamicVariable &value) const;
+        DynamicVariable operator+(StringViewType value) &&;
+
+        DynamicVariable operator+(const DynamicVariable &value) &&;
+
+        template<typename T>
+        std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, DynamicVariable>
+          operator+(const T &value) &&;
+
+        DynamicVariable operator-(const DynamicVariable &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-          operator-(const T &value) const;
+          operator-(const T &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
-          operator-(const T &value) const;
+          operator-(const T &value) const &;
+
+        DynamicVariable operator-(const DynamicVariable &value) &&;
+
+        template<typename T>
+        std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, DynamicVariable>
+          operator-(const T &value) &&;
 
         DynamicVariable &operator*=(const DynamicVariable &value);
 
@@ -369,15 +467,21 @@ namespace FDVar
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
           &operator*=(const T &value);
 
-        DynamicVariable operator*(const DynamicVariable &value) const;
+        DynamicVariable operator*(const DynamicVariable &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-          operator*(const T &value) const;
+          operator*(const T &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
-          operator*(const T &value) const;
+          operator*(const T &value) const &;
+
+        DynamicVariable operator*(const DynamicVariable &value) &&;
+
+        template<typename T>
+        std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, DynamicVariable>
+          operator*(const T &value) &&;
 
         DynamicVariable &operator/=(const DynamicVariable &value);
 
@@ -389,15 +493,21 @@ namespace FDVar
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
           &operator/=(const T &value);
 
-        DynamicVariable operator/(const DynamicVariable &value) const;
+        DynamicVariable operator/(const DynamicVariable &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-          operator/(const T &value) const;
+          operator/(const T &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_floating_point_v<T>, DynamicVariable>
-          operator/(const T &value) const;
+          operator/(const T &value) const &;
+
+        DynamicVariable operator/(const DynamicVariable &value) &&;
+
+        template<typename T>
+        std::enable_if_t<!std::is_same_v<T, bool> && std::is_arithmetic_v<T>, DynamicVariable>
+          operator/(const T &value) &&;
 
         DynamicVariable &operator%=(const DynamicVariable &value);
 
@@ -405,11 +515,17 @@ namespace FDVar
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
           &operator%=(const T &value);
 
-        DynamicVariable operator%(const DynamicVariable &value) const;
+        DynamicVariable operator%(const DynamicVariable &value) const &;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
-          operator%(const T &value) const;
+          operator%(const T &value) const &;
+
+        DynamicVariable operator%(const DynamicVariable &value) &&;
+
+        template<typename T>
+        std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
+          operator%(const T &value) &&;
 
         template<typename T>
         std::enable_if_t<!std::is_same_v<T, bool> && std::is_integral_v<T>, DynamicVariable>
@@ -565,6 +681,16 @@ namespace FDVar
             return *this;
         }
 
+        // Integer arithmetic under an explicit policy; other operand types behave as the
+        // operators do.
+        DynamicVariable add(const DynamicVariable &value, ArithmeticPolicy policy) const;
+        DynamicVariable subtract(const DynamicVariable &value, ArithmeticPolicy policy) const;
+        DynamicVariable multiply(const DynamicVariable &value, ArithmeticPolicy policy) const;
+        DynamicVariable divide(const DynamicVariable &value, ArithmeticPolicy policy) const;
+        DynamicVariable modulo(const DynamicVariable &value, ArithmeticPolicy policy) const;
+
+        uint64_t hash() const;
+
         SizeType size() const;
         bool isEmpty() const;
         DynamicVariable operator[](SizeType pos);
@@ -577,18 +703,35 @@ namespace FDVar
         DynamicVariable keys() const;
         DynamicVariable get(StringViewType member);
         void set(StringViewType key, const DynamicVariable &value);
+        void set(StringViewType key, DynamicVariable &&value);
+        void set(SizeType pos, const DynamicVariable &value);
+        void set(SizeType pos, DynamicVariable &&value);
         void unset(StringViewType key);
 
         void push(const DynamicVariable &value);
+        void push(DynamicVariable &&value);
         DynamicVariable pop();
 
         void insert(const DynamicVariable &value, SizeType pos);
+        void insert(DynamicVariable &&value, SizeType pos);
         DynamicVariable removeAt(SizeType pos);
         void clear();
 
-        void append(const DynamicVariable &str) { append(static_cast<const StringType &>(str)); };
+        void append(const DynamicVariable &str) { append(str.view()); };
         void append(StringViewType str);
         DynamicVariable subString(SizeType from, SizeType count);
+        StringViewType view() const;
+        SizeType length() const;
+        StringViewType charAt(SizeType pos) const;
+
+        // Iterates code points without allocating; valid while this string is not modified.
+        // Prefer this, view() or charAt() over operator[] in scanning loops, since operator[]
+        // returns each character as a new string value.
+        utf8::CodePointRange<StringType::value_type> codePoints() const;
+        DynamicVariable substr(SizeType from, SizeType count);
+
+        // Bytes that share this variable's buffer.
+        DynamicVariable slice(SizeType from, SizeType count = BytesValue::npos) const;
 
         template<typename StreamType,
                  typename U = std::enable_if_t<!std::is_integral_v<StreamType> &&
@@ -604,19 +747,117 @@ namespace FDVar
         void write(StreamType &stream) const;
 
         AbstractValue::Ptr internalValue() { return m_value; }
+        const AbstractValue::Ptr &internalValue() const { return m_value; }
 
       private:
+        // A temporary may be updated in place only when no container or copy shares its node.
+        bool isUnique() const { return m_value.use_count() == 1; }
+
+        template<arithmetic::Operation O, ArithmeticPolicy P = DEFAULT_ARITHMETIC_POLICY>
+        DynamicVariable &assignInteger(IntType value);
+
+        template<arithmetic::Operation O, ArithmeticPolicy P = DEFAULT_ARITHMETIC_POLICY>
+        DynamicVariable combineInteger(IntType value) const;
+
+        template<arithmetic::Operation O>
+        DynamicVariable combine(const DynamicVariable &value, ArithmeticPolicy policy) const;
+
+        // Arithmetic with a BigInteger or Decimal operand: Float when either side is a Float,
+        // otherwise Decimal when either side is a Decimal, otherwise an exact integer that comes
+        // back as an Integer when it fits in IntType.
+        DynamicVariable combineExact(arithmetic::Operation operation,
+                                     const DynamicVariable &value) const;
+
+        // combineExact into this variable; a Decimal is updated in place.
+        DynamicVariable &assignExact(arithmetic::Operation operation, const DynamicVariable &value);
+
+        // Timestamp and Duration arithmetic: Timestamp - Timestamp is a Duration, a Timestamp
+        // moves by a Duration, and a Duration scales by an Integer.
+        DynamicVariable combineTime(arithmetic::Operation operation,
+                                    const DynamicVariable &value) const;
+
         std::runtime_error generateCastException(const std::string &caller) const
         {
             return std::runtime_error(caller + ": unsupported action on type " +
                                       std::to_string(getValueType()));
         }
 
-        static FunctionValue::FunctionType wrapFunction(const FunctionType &func)
+        template<typename F, SizeType Arity>
+        struct FunctionAdapter
+        {
+            F func;
+
+            AbstractValue::Ptr operator()(const AbstractValue::Ptr *args, SizeType count)
+            {
+                return invoke(args, count, std::make_index_sequence<Arity>());
+            }
+
+            template<size_t... I>
+            AbstractValue::Ptr invoke(const AbstractValue::Ptr *args,
+                                      SizeType count,
+                                      std::index_sequence<I...> /*unused*/)
+            {
+                if(count == Arity)
+                {
+                    return DynamicVariable(func(DynamicVariable(args[I])...)).m_value;
+                }
+
+                if constexpr(Arity == 1)
+                {
+                    return DynamicVariable(
+                             func(DynamicVariable(FunctionValue::packArguments(args, count))))
+                      .m_value;
+                }
+                else
+                {
+                    if(count == 1 && args[0] && args[0]->isType(ValueType::Array))
+                    {
+                        const auto &arr = static_cast<const AbstractArrayValue &>(*args[0]);
+                        if(arr.size() == Arity)
+                        {
+                            return DynamicVariable(func(DynamicVariable(arr[I])...)).m_value;
+                        }
+                    }
+
+                    throw std::invalid_argument("function called with " + std::to_string(count) +
+                                                " arguments, expected " + std::to_string(Arity));
+                }
+            }
+        };
+
+        template<typename F>
+        static FunctionValue::CallableType makeCallable(F &&func)
+        {
+            typedef std::decay_t<F> DecayType;
+            constexpr SizeType arity = detail::function_arity<DecayType>();
+            static_assert(arity <= FDVAR_FUNCTION_MAX_ARITY,
+                          "function must be invocable with DynamicVariable arguments");
+
+            return FunctionValue::CallableType(
+              FunctionAdapter<DecayType, arity> { std::forward<F>(func) });
+        }
+
+        static FunctionValue wrapFunction(const FunctionType &func)
         {
-            return [func](AbstractValue::Ptr var) -> AbstractValue::Ptr {
-                return func(DynamicVariable(std::move(var))).m_value;
-            };
+            if(!func)
+            {
+                return FunctionValue();
+            }
+
+            return FunctionValue(makeCallable(func));
+        }
+
+        template<typename T>
+        static AbstractValue::Ptr toArgument(T &&value)
+        {
+            if constexpr(std::is_same_v<std::decay_t<T>, DynamicVariable>)
+            {
+                return std::forward<T>(value).m_value;
+            }
+            else
+            {
+                return DynamicVariable(std::forward<T>(value)).m_value;
+            }
         }
 
         BoolValue &toBoolean()
@@ -682,6 +923,56 @@ namespace FDVar
             return static_cast<const FloatValue &>(*m_value);
         }
 
+        const BigIntegerValue &toBigInteger() const
+        {
+            if(!isType(ValueType::BigInteger))
+            {
+                throw generateCastException(__func__);
+            }
+
+            return static_cast<const BigIntegerValue &>(*m_value);
+        }
+
+        const DecimalValue &toDecimal() const
+        {
+            if(!isType(ValueType::Decimal))
+            {
+                throw generateCastException(__func__);
+            }
+
+            return static_cast<const DecimalValue &>(*m_value);
+        }
+
+        const BytesValue &toBytes() const
+        {
+            if(!isType(ValueType::Bytes))
+            {
+                throw generateCastException(__func__);
+            }
+
+            return static_cast<const BytesValue &>(*m_value);
+        }
+
+        const TimestampValue &toTimestamp() const
+        {
+            if(!isType(ValueType::Timestamp))
+            {
+                throw generateCastException(__func__);
+            }
+
+            return static_cast<const TimestampValue &>(*m_value);
+        }
+
+        const DurationValue &toDuration() const
+        {
+            if(!isType(ValueType::Duration))
+            {
+                throw generateCastException(__func__);
+            }
+
+            return static_cast<const DurationValue &>(*m_value);
+        }
+
         StringValue &toString()
         {
             if(!isType(ValueType::String))
@@ -0,0 +1,1178 @@
+#ifndef FDVAR_EXPRESSION_H
+#define FDVAR_EXPRESSION_H
+
+#ifndef FDVAR_EXPRESSION_STACK_REGISTERS
+    #define FDVAR_EXPRESSION_STACK_REGISTERS 32
+#endif // FDVAR_EXPRESSION_STACK_REGISTERS
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+
+namespace FDVar
+{
+    class CompiledExpression;
+
+    class Expression
+    {
+      public:
+        typedef size_t SizeType;
+
+        enum class Operation : uint8_t
+        {
+            Constant,
+            Argument,
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Modulo,
+            Negate,
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual,
+            Equal,
+            NotEqual,
+            And,
+            Or,
+            Not
+        };
+
+      private:
+        friend class CompiledExpression;
+
+        struct Node
+        {
+            Operation operation;
+            SizeType index;
+            DynamicVariable value;
+            std::shared_ptr<const Node> lhs;
+            std::shared_ptr<const Node> rhs;
+        };
+
+        std::shared_ptr<const Node> m_node;
+
+        explicit Expression(std::shared_ptr<const Node> node) : m_node(std::move(node)) {}
+
+      public:
+        Expression(const DynamicVariable &value) :
+            m_node(std::make_shared<const Node>(Node { Operation::Constant, 0, value, {}, {} }))
+        {
+        }
+
+        template<typename T, typename U = std::enable_if_t<std::is_arithmetic_v<T>, T>>
+        Expression(T value) : Expression(DynamicVariable(value))
+        {
+        }
+
+        Expression(Expression &&) = default;
+        Expression(const Expression &) = default;
+
+        ~Expression() = default;
+
+        Expression &operator=(Expression &&) = default;
+        Expression &operator=(const Expression &) = default;
+
+        static Expression argument(SizeType index)
+        {
+            return Expression(
+              std::make_shared<const Node>(Node { Operation::Argument, index, {}, {}, {} }));
+        }
+
+        static Expression constant(const DynamicVariable &value) { return Expression(value); }
+
+        Operation getOperation() const { return m_node->operation; }
+
+        CompiledExpression compile(const std::vector<ValueType> &signature = {}) const;
+
+        friend Expression operator+(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Add, lhs, rhs);
+        }
+
+        friend Expression operator-(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Subtract, lhs, rhs);
+        }
+
+        friend Expression operator*(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Multiply, lhs, rhs);
+        }
+
+        friend Expression operator/(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Divide, lhs, rhs);
+        }
+
+        friend Expression operator%(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Modulo, lhs, rhs);
+        }
+
+        friend Expression operator<(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Less, lhs, rhs);
+        }
+
+        friend Expression operator<=(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::LessEqual, lhs, rhs);
+        }
+
+        friend Expression operator>(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Greater, lhs, rhs);
+        }
+
+        friend Expression operator>=(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::GreaterEqual, lhs, rhs);
+        }
+
+        friend Expression operator==(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Equal, lhs, rhs);
+        }
+
+        friend Expression operator!=(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::NotEqual, lhs, rhs);
+        }
+
+        friend Expression operator&&(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::And, lhs, rhs);
+        }
+
+        friend Expression operator||(const Expression &lhs, const Expression &rhs)
+        {
+            return binary(Operation::Or, lhs, rhs);
+        }
+
+        Expression operator-() const
+        {
+            return Expression(
+              std::make_shared<const Node>(Node { Operation::Negate, 0, {}, m_node, {} }));
+        }
+
+        Expression operator!() const
+        {
+            return Expression(
+              std::make_shared<const Node>(Node { Operation::Not, 0, {}, m_node, {} }));
+        }
+
+      private:
+        static Expression binary(Operation operation, const Expression &lhs, const Expression &rhs)
+        {
+            return Expression(
+              std::make_shared<const Node>(Node { operation, 0, {}, lhs.m_node, rhs.m_node }));
+        }
+    };
+
+    class CompiledExpression
+    {
+      public:
+        typedef Expression::SizeType SizeType;
+        typedef Expression::Operation Operation;
+        typedef DynamicVariable::IntType IntType;
+        typedef DynamicVariable::FloatType FloatType;
+
+        enum class Opcode : uint8_t
+        {
+            ArgumentInt,
+            ArgumentFloat,
+            ArgumentBool,
+            ConstantInt,
+            ConstantFloat,
+            ConstantBool,
+            IntToFloat,
+            AddInt,
+            AddFloat,
+            SubtractInt,
+            SubtractFloat,
+            MultiplyInt,
+            MultiplyFloat,
+            DivideInt,
+            DivideFloat,
+            ModuloInt,
+            NegateInt,
+            NegateFloat,
+            LessInt,
+            LessFloat,
+            LessIntFloat,
+            LessFloatInt,
+            LessEqualInt,
+            LessEqualFloat,
+            LessEqualIntFloat,
+            LessEqualFloatInt,
+            EqualInt,
+            EqualFloat,
+            EqualBool,
+            NotEqualInt,
+            NotEqualFloat,
+            NotEqualBool,
+            And,
+            Or,
+            Not
+        };
+
+        union Register
+        {
+            IntType i;
+            FloatType f;
+            bool b;
+        };
+
+      private:
+        friend class Expression;
+
+        template<typename OpcodeType>
+        struct Instruction
+        {
+            OpcodeType opcode;
+            uint32_t destination;
+            uint32_t lhs;
+            uint32_t rhs;
+        };
+
+        std::vector<Instruction<Operation>> m_generic;
+        std::vector<DynamicVariable> m_constants;
+        std::vector<Instruction<Opcode>> m_code;
+        std::vector<Register> m_immediates;
+        std::vector<ValueType> m_signature;
+        SizeType m_registerCount;
+        SizeType m_argumentCount;
+        uint32_t m_result;
+        ValueType m_resultType;
+
+        CompiledExpression(const Expression &expression, const std::vector<ValueType> &signature) :
+            m_registerCount(0),
+            m_argumentCount(0),
+            m_result(0),
+            m_resultType(ValueType::None)
+        {
+            flatten(expression.m_node.get());
+            if(!signature.empty() && !specialize(signature))
+            {
+                m_code.clear();
+                m_immediates.clear();
+                m_registerCount = m_generic.size();
+                m_resultType = ValueType::None;
+            }
+        }
+
+      public:
+        CompiledExpression(CompiledExpression &&) = default;
+        CompiledExpression(const CompiledExpression &) = default;
+
+        ~CompiledExpression() = default;
+
+        CompiledExpression &operator=(CompiledExpression &&) = default;
+        CompiledExpression &operator=(const CompiledExpression &) = default;
+
+        bool isSpecialized() const { return m_resultType != ValueType::None; }
+        const std::vector<ValueType> &signature() const { return m_signature; }
+        SizeType argumentCount() const { return m_argumentCount; }
+
+        DynamicVariable call(const AbstractValue::Ptr *args, SizeType count) const
+        {
+            checkArguments(count);
+            if(!isSpecialized())
+            {
+                return evaluateGeneric(args);
+            }
+
+            if(m_registerCount <= FDVAR_EXPRESSION_STACK_REGISTERS)
+            {
+                std::array<Register, FDVAR_EXPRESSION_STACK_REGISTERS> registers;
+                return evaluate(args, registers.data());
+            }
+
+            std::vector<Register> registers(m_registerCount);
+            return evaluate(args, registers.data());
+        }
+
+        template<typename... Args>
+        DynamicVariable operator()(Args &&...args) const
+        {
+            std::array<AbstractValue::Ptr, sizeof...(Args)> arguments { toArgument(
+              std::forward<Args>(args))... };
+            return call(arguments.data(), arguments.size());
+        }
+
+        DynamicVariable map(const DynamicVariable &rows) const
+        {
+            if(!rows.isType(ValueType::Array))
+            {
+                throw std::runtime_error(std::string(__func__) + ": unsupported action on type " +
+                                         std::to_string(rows.getValueType()));
+            }
+
+            const auto &arr = static_cast<const AbstractArrayValue &>(*rows.internalValue());
+            std::vector<Register> registers(isSpecialized() ? m_registerCount : 0);
+            std::vector<AbstractValue::Ptr> arguments;
+            DynamicVariable::ArrayType result;
+            result.reserve(arr.size());
+            for(SizeType i = 0; i < arr.size(); ++i)
+            {
+                const AbstractValue::Ptr &row = arr[i];
+                arguments.clear();
+                if(row && row->isType(ValueType::Array))
+                {
+                    const auto &values = static_cast<const AbstractArrayValue &>(*row);
+                    for(SizeType j = 0; j < values.size(); ++j)
+                    {
+                        arguments.push_back(values[j]);
+                    }
+                }
+                else
+                {
+                    arguments.push_back(row);
+                }
+
+                checkArguments(arguments.size());
+                result.push_back((isSpecialized() ? evaluate(arguments.data(), registers.data())
+                                                  : evaluateGeneric(arguments.data()))
+                                   .internalValue());
+            }
+
+            return DynamicVariable(std::move(result));
+        }
+
+        DynamicVariable toFunction() const
+        {
+            return DynamicVariable(std::make_shared<FunctionValue>(FunctionValue::CallableType(
+              [expression = *this](const AbstractValue::Ptr *args, SizeType count) {
+                  return expression.call(args, count).internalValue();
+              })));
+        }
+
+      private:
+        void checkArguments(SizeType count) const
+        {
+            if(count < m_argumentCount)
+            {
+                throw std::invalid_argument("expression called with " + std::to_string(count) +
+                                            " arguments, expected " +
+                                            std::to_string(m_argumentCount));
+            }
+        }
+
+        template<typename T>
+        static AbstractValue::Ptr toArgument(T &&value)
+        {
+            if constexpr(std::is_same_v<std::decay_t<T>, DynamicVariable>)
+            {
+                return value.internalValue();
+            }
+            else
+            {
+                return DynamicVariable(std::forward<T>(value)).internalValue();
+            }
+        }
+
+        void flatten(const Expression::Node *root)
+        {
+            std::unordered_map<const Expression::Node *, uint32_t> registers;
+            std::vector<std::pair<const Expression::Node *, bool>> pending { { root, false } };
+            while(!pending.empty())
+            {
+                auto [node, expanded] = pending.back();
+                pending.pop_back();
+                if(registers.count(node) != 0)
+                {
+                    continue;
+                }
+
+                if(!expanded)
+                {
+                    pending.emplace_back(node, true);
+                    if(node->rhs)
+                    {
+                        pending.emplace_back(node->rhs.get(), false);
+                    }
+
+                    if(node->lhs)
+                    {
+                        pending.emplace_back(node->lhs.get(), false);
+                    }
+
+                    continue;
+                }
+
+                Instruction<Operation> instruction {
+                    node->operation, static_cast<uint32_t>(m_generic.size()), 0, 0
+                };
+                if(node->operation == Operation::Constant)
+                {
+                    instruction.lhs = static_cast<uint32_t>(m_constants.size());
+                    m_constants.push_back(node->value);
+                }
+                else if(node->operation == Operation::Argument)
+                {
+                    instruction.lhs = static_cast<uint32_t>(node->index);
+                    m_argumentCount = std::max(m_argumentCount, node->index + 1);
+                }
+                else
+                {
+                    instruction.lhs = registers.at(node->lhs.get());
+                    instruction.rhs = node->rhs ? registers.at(node->rhs.get()) : 0;
+                }
+
+                registers.emplace(node, instruction.destination);
+                m_generic.push_back(instruction);
+            }
+
+            m_registerCount = m_generic.size();
+            m_result = m_generic.back().destination;
+        }
+
+        static bool isNumber(ValueType type)
+        {
+            return type == ValueType::Integer || type == ValueType::Float;
+        }
+
+        uint32_t emit(Opcode opcode, uint32_t lhs, uint32_t rhs)
+        {
+            uint32_t destination = static_cast<uint32_t>(m_registerCount++);
+            m_code.push_back({ opcode, destination, lhs, rhs });
+            return destination;
+        }
+
+        uint32_t toFloatRegister(const std::vector<ValueType> &types, uint32_t reg)
+        {
+            return types[reg] == ValueType::Float ? reg : emit(Opcode::IntToFloat, reg, 0);
+        }
+
+        bool specializeNumber(std::vector<ValueType> &types,
+                              std::vector<uint32_t> &locations,
+                              const Instruction<Operation> &instruction,
+                              Opcode intOpcode,
+                              Opcode floatOpcode,
+                              ValueType intResult,
+                              ValueType floatResult)
+        {
+            uint32_t lhs = locations[instruction.lhs];
+            uint32_t rhs = locations[instruction.rhs];
+            if(!isNumber(types[lhs]) || !isNumber(types[rhs]))
+            {
+                return false;
+            }
+
+            uint32_t destination;
+            ValueType type;
+            if(types[lhs] == ValueType::Integer && types[rhs] == ValueType::Integer)
+            {
+                destination = emit(intOpcode, lhs, rhs);
+                type = intResult;
+            }
+            else
+            {
+                lhs = toFloatRegister(types, lhs);
+                types.resize(m_registerCount, ValueType::Float);
+                rhs = toFloatRegister(types, rhs);
+                destination = emit(floatOpcode, lhs, rhs);
+                type = floatResult;
+            }
+
+            types.resize(m_registerCount, ValueType::Float);
+            types[destination] = type;
+            locations[instruction.destination] = destination;
+            return true;
+        }
+
+        // An Integer and a Float compare exactly rather than through a conversion to Float, so
+        // the result agrees with the generic path and DynamicVariable::compare.
+        bool specializeOrder(std::vector<ValueType> &types,
+                             std::vector<uint32_t> &locations,
+                             const Instruction<Operation> &instruction,
+                             Opcode intOpcode,
+                             Opcode floatOpcode,
+                             Opcode intFloatOpcode,
+                             Opcode floatIntOpcode)
+        {
+            uint32_t lhs = locations[instruction.lhs];
+            uint32_t rhs = locations[instruction.rhs];
+            Opcode opcode;
+            if(types[lhs] == ValueType::Integer && types[rhs] == ValueType::Float)
+            {
+                opcode = intFloatOpcode;
+            }
+            else if(types[lhs] == ValueType::Float && types[rhs] == ValueType::Integer)
+            {
+                opcode = floatIntOpcode;
+            }
+            else
+            {
+                return specializeNumber(types, locations, instruction, intOpcode, floatOpcode,
+                                        ValueType::Boolean, ValueType::Boolean);
+            }
+
+            uint32_t destination = emit(opcode, lhs, rhs);
+            types.resize(m_registerCount, ValueType::None);
+            types[destination] = ValueType::Boolean;
+            locations[instruction.destination] = destination;
+            return true;
+        }
+
+        bool specialize(const std::vector<ValueType> &signature)
+        {
+            std::vector<ValueType> types;
+            std::vector<uint32_t> locations(m_generic.size());
+            m_registerCount = 0;
+            for(const auto &instruction: m_generic)
+            {
+                bool load = instruction.opcode == Operation::Constant ||
+                            instruction.opcode == Operation::Argument;
+                uint32_t lhs = load ? 0 : locations[instruction.lhs];
+                uint32_t rhs = load ? 0 : locations[instruction.rhs];
+                uint32_t destination = 0;
+                ValueType type = ValueType::None;
+                switch(instruction.opcode)
+                {
+                    case Operation::Argument:
+                    {
+                        type = instruction.lhs < signature.size() ? signature[instruction.lhs]
+                                                                  : ValueType::None;
+                        if(type == ValueType::Integer)
+                        {
+                            destination = emit(Opcode::ArgumentInt, instruction.lhs, 0);
+                        }
+                        else if(type == ValueType::Float)
+                        {
+                            destination = emit(Opcode::ArgumentFloat, instruction.lhs, 0);
+                        }
+                        else if(type == ValueType::Boolean)
+                        {
+                            destination = emit(Opcode::ArgumentBool, instruction.lhs, 0);
+                        }
+                        else
+                        {
+                            return false;
+                        }
+                        break;
+                    }
+
+                    case Operation::Constant:
+                    {
+                        const DynamicVariable &value = m_constants[instruction.lhs];
+                        Register immediate;
+                        type = value.getValueType();
+                        uint32_t index = static_cast<uint32_t>(m_immediates.size());
+                        if(type == ValueType::Integer)
+                        {
+                            immediate.i = static_cast<IntType>(value);
+                            destination = emit(Opcode::ConstantInt, index, 0);
+                        }
+                        else if(type == ValueType::Float)
+                        {
+                            immediate.f = static_cast<FloatType>(value);
+                            destination = emit(Opcode::ConstantFloat, index, 0);
+                        }
+                        else if(type == ValueType::Boolean)
+                        {
+                            immediate.b = static_cast<bool>(value);
+                            destination = emit(Opcode::ConstantBool, index, 0);
+                        }
+                        else
+                        {
+                            return false;
+                        }
+
+                        m_immediates.push_back(immediate);
+                        break;
+                    }
+
+                    case Operation::Add:
+                        if(!specializeNumber(types, locations, instruction, Opcode::AddInt,
+                                             Opcode::AddFloat, ValueType::Integer,
+                                             ValueType::Float))
+                        {
+                            return false;
+                        }
+                        continue;
+
+                    case Operation::Subtract:
+                        if(!specializeNumber(types, locations, instruction, Opcode::SubtractInt,
+                                             Opcode::SubtractFloat, ValueType::Integer,
+                                             ValueType::Float))
+                        {
+                            return false;
+                        }
+                        continue;
+
+                    case Operation::Multiply:
+                        if(!specializeNumber(types, locations, instruction, Opcode::MultiplyInt,
+                                             Opcode::MultiplyFloat, ValueType::Integer,
+                                             ValueType::Float))
+                        {
+                            return false;
+                        }
+                        continue;
+
+                    case Operation::Divide:
+                        if(!specializeNumber(types, locations, instruction, Opcode::DivideInt,
+                                             Opcode::DivideFloat, ValueType::Integer,
+                                             ValueType::Float))
+                        {
+                            return false;
+                        }
+                        continue;
+
+                    case Operation::Less:
+                    case Operation::Greater:
+                    {
+                        Instruction<Operation> ordered = instruction;
+                        if(instruction.opcode == Operation::Greater)
+                        {
+                            std::swap(ordered.lhs, ordered.rhs);
+                        }
+
+                        if(!specializeOrder(types, locations, ordered, Opcode::LessInt,
+                                            Opcode::LessFloat, Opcode::LessIntFloat,
+                                            Opcode::LessFloatInt))
+                        {
+                            return false;
+                        }
+                        continue;
+                    }
+
+                    case Operation::LessEqual:
+                    case Operation::GreaterEqual:
+                    {
+                        Instruction<Operation> ordered = instruction;
+                        if(instruction.opcode == Operation::GreaterEqual)
+                        {
+                            std::swap(ordered.lhs, ordered.rhs);
+                        }
+
+                        if(!specializeOrder(types, locations, ordered, Opcode::LessEqualInt,
+                                            Opcode::LessEqualFloat, Opcode::LessEqualIntFloat,
+                                            Opcode::LessEqualFloatInt))
+                        {
+                            return false;
+                        }
+                        continue;
+                    }
+
+                    case Operation::Modulo:
+                        if(types[lhs] != ValueType::Integer || types[rhs] != ValueType::Integer)
+                        {
+                            return false;
+                        }
+
+                        destination = emit(Opcode::ModuloInt, lhs, rhs);
+                        type = ValueType::Integer;
+                        break;
+
+                    case Operation::Negate:
+                        if(!isNumber(types[lhs]))
+                        {
+                            return false;
+                        }
+
+                        type = types[lhs];
+                        destination = emit(type == ValueType::Integer ? Opcode::NegateInt
+                                                                      : Opcode::NegateFloat,
+                                           lhs, 0);
+                        break;
+
+                    case Operation::Equal:
+                    case Operation::NotEqual:
+                    {
+                        bool equal = instruction.opcode == Operation::Equal;
+                        type = ValueType::Boolean;
+                        if(types[lhs] != types[rhs])
+                        {
+                            Register immediate;
+                            immediate.b = !equal;
+                            destination = emit(Opcode::ConstantBool,
+                                               static_cast<uint32_t>(m_immediates.size()), 0);
+                            m_immediates.push_back(immediate);
+                        }
+                        else if(types[lhs] == ValueType::Integer)
+                        {
+                            destination =
+                              emit(equal ? Opcode::EqualInt : Opcode::NotEqualInt, lhs, rhs);
+                        }
+                        else if(types[lhs] == ValueType::Float)
+                        {
+                            destination =
+                              emit(equal ? Opcode::EqualFloat : Opcode::NotEqualFloat, lhs, rhs);
+                        }
+                        else
+                        {
+                            destination =
+                              emit(equal ? Opcode::EqualBool : Opcode::NotEqualBool, lhs, rhs);
+                        }
+                        break;
+                    }
+
+                    case Operation::And:
+                    case Operation::Or:
+                        if(types[lhs] != ValueType::Boolean || types[rhs] != ValueType::Boolean)
+                        {
+                            return false;
+                        }
+
+                        destination = emit(instruction.opcode == Operation::And ? Opcode::And
+                                                                                   : Opcode::Or,
+                                           lhs, rhs);
+                        type = ValueType::Boolean;
+                        break;
+
+                    case Operation::Not:
+                        if(types[lhs] != ValueType::Boolean)
+                        {
+                            return false;
+                        }
+
+                        destination = emit(Opcode::Not, lhs, 0);
+                        type = ValueType::Boolean;
+                        break;
+                }
+
+                types.resize(m_registerCount, ValueType::None);
+                types[destination] = type;
+                locations[instruction.destination] = destination;
+            }
+
+            m_signature = signature;
+            m_result = locations[m_generic.back().destination];
+            m_resultType = types[m_result];
+            return true;
+        }
+
+        static void checkDivisor(IntType divisor)
+        {
+            if(divisor == 0)
+            {
+                throw std::domain_error("integer division by zero");
+            }
+        }
+
+        // Integer opcodes follow DEFAULT_ARITHMETIC_POLICY like the DynamicVariable operators.
+        // The promoting policies change the result type on overflow, so there run() gives up
+        // and the expression is evaluated generically.
+        template<arithmetic::Operation O>
+        static bool integer(IntType lhs, IntType rhs, IntType &result)
+        {
+            if constexpr(DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::PromoteToFloat ||
+                         DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::PromoteToBigInteger)
+            {
+                return arithmetic::fits<O>(lhs, rhs, result);
+            }
+            else
+            {
+                result = arithmetic::apply<DEFAULT_ARITHMETIC_POLICY, O>(lhs, rhs);
+                return true;
+            }
+        }
+
+        // -1, 0 or 1 as lhs is below, equal to or above rhs, which is not NaN.
+        static int compareIntFloat(IntType lhs, FloatType rhs)
+        {
+            constexpr FloatType limit = -FloatType(std::numeric_limits<IntType>::min());
+            if(rhs >= limit)
+            {
+                return -1;
+            }
+
+            if(rhs < -limit)
+            {
+                return 1;
+            }
+
+            FloatType whole = std::trunc(rhs);
+            IntType integral = static_cast<IntType>(whole);
+            if(lhs != integral)
+            {
+                return lhs < integral ? -1 : 1;
+            }
+
+            return whole < rhs ? -1 : (rhs < whole ? 1 : 0);
+        }
+
+        bool load(const Instruction<Opcode> &instruction,
+                  const AbstractValue::Ptr *args,
+                  Register &destination) const
+        {
+            const AbstractValue::Ptr &value = args[instruction.lhs];
+            switch(instruction.opcode)
+            {
+                case Opcode::ArgumentInt:
+                    if(!value || !value->isType(ValueType::Integer))
+                    {
+                        return false;
+                    }
+
+                    destination.i = static_cast<IntType>(static_cast<const IntValue &>(*value));
+                    return true;
+
+                case Opcode::ArgumentFloat:
+                    if(!value || !value->isType(ValueType::Float))
+                    {
+                        return false;
+                    }
+
+                    destination.f = static_cast<FloatType>(static_cast<const FloatValue &>(*value));
+                    return true;
+
+                default:
+                    if(!value || !value->isType(ValueType::Boolean))
+                    {
+                        return false;
+                    }
+
+                    destination.b = static_cast<bool>(static_cast<const BoolValue &>(*value));
+                    return true;
+            }
+        }
+
+        bool run(const AbstractValue::Ptr *args, Register *registers) const
+        {
+            for(const auto &instruction: m_code)
+            {
+                Register &destination = registers[instruction.destination];
+                if(instruction.opcode <= Opcode::ArgumentBool)
+                {
+                    if(!load(instruction, args, destination))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+
+                if(instruction.opcode <= Opcode::ConstantBool)
+                {
+                    destination = m_immediates[instruction.lhs];
+                    continue;
+                }
+
+                const Register &lhs = registers[instruction.lhs];
+                const Register &rhs = registers[instruction.rhs];
+                switch(instruction.opcode)
+                {
+                    case Opcode::IntToFloat:
+                        destination.f = static_cast<FloatType>(lhs.i);
+                        break;
+
+                    case Opcode::AddInt:
+                        if(!integer<arithmetic::Operation::Add>(lhs.i, rhs.i, destination.i))
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case Opcode::AddFloat:
+                        destination.f = lhs.f + rhs.f;
+                        break;
+
+                    case Opcode::SubtractInt:
+                        if(!integer<arithmetic::Operation::Subtract>(lhs.i, rhs.i, destination.i))
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case Opcode::SubtractFloat:
+                        destination.f = lhs.f - rhs.f;
+                        break;
+
+                    case Opcode::MultiplyInt:
+                        if(!integer<arithmetic::Operation::Multiply>(lhs.i, rhs.i, destination.i))
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case Opcode::MultiplyFloat:
+                        destination.f = lhs.f * rhs.f;
+                        break;
+
+                    case Opcode::DivideInt:
+                        checkDivisor(rhs.i);
+                        if(!integer<arithmetic::Operation::Divide>(lhs.i, rhs.i, destination.i))
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case Opcode::DivideFloat:
+                        destination.f = lhs.f / rhs.f;
+                        break;
+
+                    case Opcode::ModuloInt:
+                        checkDivisor(rhs.i);
+                        if(!integer<arithmetic::Operation::Modulo>(lhs.i, rhs.i, destination.i))
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case Opcode::NegateInt:
+                        if(!integer<arithmetic::Operation::Subtract>(0, lhs.i, destination.i))
+                        {
+                            return false;
+                        }
+
+                        break;
+
+                    case Opcode::NegateFloat:
+                        destination.f = -lhs.f;
+                        break;
+
+                    case Opcode::LessInt:
+                        destination.b = lhs.i < rhs.i;
+                        break;
+
+                    case Opcode::LessFloat:
+                        destination.b = lhs.f < rhs.f;
+                        break;
+
+                    case Opcode::LessIntFloat:
+                        destination.b = !std::isnan(rhs.f) && compareIntFloat(lhs.i, rhs.f) < 0;
+                        break;
+
+                    case Opcode::LessFloatInt:
+                        destination.b = !std::isnan(lhs.f) && compareIntFloat(rhs.i, lhs.f) > 0;
+                        break;
+
+                    case Opcode::LessEqualInt:
+                        destination.b = lhs.i <= rhs.i;
+                        break;
+
+                    case Opcode::LessEqualFloat:
+                        destination.b = lhs.f <= rhs.f;
+                        break;
+
+                    case Opcode::LessEqualIntFloat:
+                        destination.b = !std::isnan(rhs.f) && compareIntFloat(lhs.i, rhs.f) <= 0;
+                        break;
+
+                    case Opcode::LessEqualFloatInt:
+                        destination.b = !std::isnan(lhs.f) && compareIntFloat(rhs.i, lhs.f) >= 0;
+                        break;
+
+                    case Opcode::EqualInt:
+                        destination.b = lhs.i == rhs.i;
+                        break;
+
+                    case Opcode::EqualFloat:
+                        destination.b = lhs.f == rhs.f;
+                        break;
+
+                    case Opcode::EqualBool:
+                        destination.b = lhs.b == rhs.b;
+                        break;
+
+                    case Opcode::NotEqualInt:
+                        destination.b = lhs.i != rhs.i;
+                        break;
+
+                    case Opcode::NotEqualFloat:
+                        destination.b = lhs.f != rhs.f;
+                        break;
+
+                    case Opcode::NotEqualBool:
+                        destination.b = lhs.b != rhs.b;
+                        break;
+
+                    case Opcode::And:
+                        destination.b = lhs.b && rhs.b;
+                        break;
+
+                    case Opcode::Or:
+                        destination.b = lhs.b || rhs.b;
+                        break;
+
+                    case Opcode::Not:
+                        destination.b = !lhs.b;
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            return true;
+        }
+
+        DynamicVariable evaluate(const AbstractValue::Ptr *args, Register *registers) const
+        {
+            if(!run(args, registers))
+            {
+                return evaluateGeneric(args);
+            }
+
+            const Register &result = registers[m_result];
+            switch(m_resultType)
+            {
+                case ValueType::Integer:
+                    return DynamicVariable(result.i);
+
+                case ValueType::Float:
+                    return DynamicVariable(result.f);
+
+                default:
+                    return BoolValue(result.b);
+            }
+        }
+
+        static bool isNaN(const DynamicVariable &value)
+        {
+            return value.isType(ValueType::Float) && std::isnan(static_cast<FloatType>(value));
+        }
+
+        // Numbers compare exactly whatever their types; NaN is unordered like in the Float
+        // opcodes, so every comparison with it is false.
+        static DynamicVariable compare(Operation operation,
+                                       const DynamicVariable &lhs,
+                                       const DynamicVariable &rhs)
+        {
+            if(!rhs.isType(ValueType::Integer) && !rhs.isType(ValueType::Float))
+            {
+                throw std::runtime_error("compare: unsupported action on type " +
+                                         std::to_string(rhs.getValueType()));
+            }
+
+            int order = lhs.compareNumber(rhs);
+            if(isNaN(lhs) || isNaN(rhs))
+            {
+                return BoolValue(false);
+            }
+
+            switch(operation)
+            {
+                case Operation::Less:
+                    return BoolValue(order < 0);
+                case Operation::LessEqual:
+                    return BoolValue(order <= 0);
+                case Operation::Greater:
+                    return BoolValue(order > 0);
+                default:
+                    return BoolValue(order >= 0);
+            }
+        }
+
+        DynamicVariable evaluateGeneric(const AbstractValue::Ptr *args) const
+        {
+            std::vector<DynamicVariable> registers(m_generic.size());
+            for(const auto &instruction: m_generic)
+            {
+                DynamicVariable &destination = registers[instruction.destination];
+                if(instruction.opcode == Operation::Constant)
+                {
+                    destination = DynamicVariable(m_constants[instruction.lhs].internalValue());
+                    continue;
+                }
+
+                if(instruction.opcode == Operation::Argument)
+                {
+                    destination = DynamicVariable(args[instruction.lhs]);
+                    continue;
+                }
+
+                const DynamicVariable &lhs = registers[instruction.lhs];
+                const DynamicVariable &rhs = registers[instruction.rhs];
+                switch(instruction.opcode)
+                {
+                    case Operation::Add:
+                        destination = lhs + rhs;
+                        break;
+
+                    case Operation::Subtract:
+                        destination = lhs - rhs;
+                        break;
+
+                    case Operation::Multiply:
+                        destination = lhs * rhs;
+                        break;
+
+                    case Operation::Divide:
+                        if(lhs.isType(ValueType::Integer) && rhs.isType(ValueType::Integer))
+                        {
+                            checkDivisor(static_cast<IntType>(rhs));
+                        }
+
+                        destination = lhs / rhs;
+                        break;
+
+                    case Operation::Modulo:
+                        if(lhs.isType(ValueType::Integer) && rhs.isType(ValueType::Integer))
+                        {
+                            checkDivisor(static_cast<IntType>(rhs));
+                        }
+
+                        destination = lhs % rhs;
+                        break;
+
+                    case Operation::Negate:
+                        destination = -lhs;
+                        break;
+
+                    case Operation::Less:
+                    case Operation::LessEqual:
+                    case Operation::Greater:
+                    case Operation::GreaterEqual:
+                        destination = compare(instruction.opcode, lhs, rhs);
+                        break;
+
+                    case Operation::Equal:
+                        destination = BoolValue(lhs == rhs);
+                        break;
+
+                    case Operation::NotEqual:
+                        destination = BoolValue(lhs != rhs);
+                        break;
+
+                    case Operation::And:
+                        destination = BoolValue(lhs && rhs);
+                        break;
+
+                    case Operation::Or:
+                        destination = BoolValue(lhs || rhs);
+                        break;
+
+                    case Operation::Not:
+                        destination = !lhs;
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            Operation last = m_generic.back().opcode;
+            if(last == Operation::Constant || last == Operation::Argument)
+            {
+                return DynamicVariable(registers.back());
+            }
+
+            return std::move(registers.back());
+        }
+    };
+
+    inline CompiledExpression Expression::compile(const std::vector<ValueType> &signature) const
+    {
+        return CompiledExpression(*this, signature);
+    }
+} // namespace FDVar
+
+#endif // FDVAR_EXPRESSION_H
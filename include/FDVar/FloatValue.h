@@ -29,14 +29,14 @@ namespace FDVar
         {
         }
 
-        FloatValue(FloatValue &&) = default;
+        FloatValue(FloatValue &&) noexcept = default;
         FloatValue(const FloatValue &) = default;
 
         ~FloatValue() noexcept override = default;
 
         ValueType getValueType() const override { return ValueType::Float; }
 
-        FloatValue &operator=(FloatValue &&) = default;
+        FloatValue &operator=(FloatValue &&) noexcept = default;
         FloatValue &operator=(const FloatValue &) = default;
 
         template<typename T>
@@ -3,7 +3,10 @@
 
 #include <FDVar/AbstractArrayValue.h>
 #include <FDVar/AbstractValue.h>
+#include <FDVar/ArrayValue.h>
+#include <FDVar/SmallFunction.h>
 
+#include <array>
 #include <functional>
 #include <utility>
 
@@ -13,45 +16,148 @@ namespace FDVar
     {
       public:
         typedef std::function<AbstractValue::Ptr(AbstractValue::Ptr)> FunctionType;
+        typedef size_t SizeType;
+        typedef SmallFunction<AbstractValue::Ptr(const AbstractValue::Ptr *, SizeType)>
+          CallableType;
 
       private:
-        FunctionType m_value;
+        template<typename F>
+        struct UnaryAdapter
+        {
+            F func;
+
+            AbstractValue::Ptr operator()(const AbstractValue::Ptr *args, SizeType count)
+            {
+                if(count == 1)
+                {
+                    return func(args[0]);
+                }
+
+                return func(packArguments(args, count));
+            }
+        };
+
+        template<typename F>
+        static constexpr bool isUnary = std::is_invocable_r_v<AbstractValue::Ptr,
+                                                              std::decay_t<F> &,
+                                                              AbstractValue::Ptr>;
+
+        template<typename F>
+        static constexpr bool isCallable =
+          !std::is_same_v<std::decay_t<F>, FunctionValue> &&
+          !std::is_same_v<std::decay_t<F>, CallableType> &&
+          (isUnary<F> || std::is_invocable_r_v<AbstractValue::Ptr,
+                                               std::decay_t<F> &,
+                                               const AbstractValue::Ptr *,
+                                               SizeType>);
+
+        CallableType m_value;
 
       public:
         FunctionValue() = default;
-        FunctionValue(FunctionValue &&) = default;
+        FunctionValue(FunctionValue &&) noexcept = default;
         FunctionValue(const FunctionValue &) = default;
 
-        FunctionValue(FunctionType &&func) : m_value(std::move(func)) {}
-        FunctionValue(const FunctionType &func) : m_value(func) {}
+        FunctionValue(FunctionType &&func) : m_value(makeCallable(std::move(func))) {}
+        FunctionValue(const FunctionType &func) : m_value(makeCallable(func)) {}
+        FunctionValue(CallableType func) : m_value(std::move(func)) {}
+
+        template<typename F, typename U = std::enable_if_t<isCallable<F>, F>>
+        explicit FunctionValue(F &&func) : m_value(makeCallable(std::forward<F>(func)))
+        {
+        }
 
         ~FunctionValue() override = default;
 
-        FunctionValue &operator=(FunctionValue &&) = default;
+        FunctionValue &operator=(FunctionValue &&) noexcept = default;
         FunctionValue &operator=(const FunctionValue &) = default;
 
         FunctionValue &operator=(FunctionType &&func)
         {
-            m_value = std::move(func);
+            m_value = makeCallable(std::move(func));
             return *this;
         }
 
         FunctionValue &operator=(const FunctionType &func)
         {
-            m_value = func;
+            m_value = makeCallable(func);
+            return *this;
+        }
+
+        template<typename F>
+        std::enable_if_t<isCallable<F>, FunctionValue> &operator=(F &&func)
+        {
+            m_value = makeCallable(std::forward<F>(func));
             return *this;
         }
 
         ValueType getValueType() const override { return ValueType::Function; }
 
-        explicit operator FunctionType() const { return m_value; }
+        explicit operator FunctionType() const
+        {
+            if(!m_value)
+            {
+                return FunctionType();
+            }
+
+            return [callable = m_value](AbstractValue::Ptr args) { return callable(&args, 1); };
+        }
+
+        explicit operator const CallableType &() const { return m_value; }
         explicit operator bool() const { return static_cast<bool>(m_value); }
         bool operator!() const { return !m_value; }
 
+        AbstractValue::Ptr operator()(AbstractValue::Ptr args) const { return m_value(&args, 1); }
+
+        template<typename... Args>
+        std::enable_if_t<sizeof...(Args) != 1 &&
+                           (std::is_convertible_v<Args, AbstractValue::Ptr> && ...),
+                         AbstractValue::Ptr>
+          operator()(Args &&...args) const
+        {
+            std::array<AbstractValue::Ptr, sizeof...(Args)> arguments { AbstractValue::Ptr(
+              std::forward<Args>(args))... };
+            return m_value(arguments.data(), arguments.size());
+        }
 
-        AbstractValue::Ptr operator()(AbstractValue::Ptr args) const
+        AbstractValue::Ptr call(const AbstractValue::Ptr *args, SizeType count) const
+        {
+            return m_value(args, count);
+        }
+
+        static AbstractValue::Ptr packArguments(const AbstractValue::Ptr *args, SizeType count)
+        {
+            return AbstractValue::Ptr(new ArrayValue(ArrayValue::ArrayType(args, args + count)));
+        }
+
+      private:
+        template<typename F>
+        static CallableType makeCallable(F &&func)
         {
-            return m_value(std::move(args));
+            typedef std::decay_t<F> DecayType;
+            if constexpr(isUnary<F>)
+            {
+                if constexpr(std::is_pointer_v<DecayType>)
+                {
+                    if(func == nullptr)
+                    {
+                        return CallableType();
+                    }
+                }
+                else if constexpr(std::is_same_v<DecayType, FunctionType>)
+                {
+                    if(!func)
+                    {
+                        return CallableType();
+                    }
+                }
+
+                return CallableType(UnaryAdapter<DecayType> { std::forward<F>(func) });
+            }
+            else
+            {
+                return CallableType(std::forward<F>(func));
+            }
         }
     };
 
@@ -0,0 +1,124 @@
+#ifndef FDVAR_HASH_H
+#define FDVAR_HASH_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace FDVar
+{
+    namespace hash
+    {
+        constexpr uint64_t SECRET[4] = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+                                         0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+
+        inline void multiply(uint64_t &lhs, uint64_t &rhs)
+        {
+#ifdef __SIZEOF_INT128__
+            __uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+            lhs = static_cast<uint64_t>(product);
+            rhs = static_cast<uint64_t>(product >> 64);
+#else
+            uint64_t ha = lhs >> 32, hb = rhs >> 32, la = lhs & 0xFFFFFFFFULL,
+                     lb = rhs & 0xFFFFFFFFULL;
+            uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            uint64_t t = rl + (rm0 << 32);
+            uint64_t carry = t < rl ? 1 : 0;
+            uint64_t lo = t + (rm1 << 32);
+            carry += lo < t ? 1 : 0;
+            lhs = lo;
+            rhs = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif // __SIZEOF_INT128__
+        }
+
+        inline uint64_t mix(uint64_t lhs, uint64_t rhs)
+        {
+            multiply(lhs, rhs);
+            return lhs ^ rhs;
+        }
+
+        inline uint64_t read64(const uint8_t *data)
+        {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        inline uint64_t read32(const uint8_t *data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        inline uint64_t bytes(const void *key, size_t size, uint64_t seed = 0)
+        {
+            const auto *data = static_cast<const uint8_t *>(key);
+            seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+            uint64_t a;
+            uint64_t b;
+            if(size <= 16)
+            {
+                if(size >= 4)
+                {
+                    size_t shift = (size >> 3) << 2;
+                    a = (read32(data) << 32) | read32(data + shift);
+                    b = (read32(data + size - 4) << 32) | read32(data + size - 4 - shift);
+                }
+                else if(size > 0)
+                {
+                    a = (static_cast<uint64_t>(data[0]) << 16) |
+                        (static_cast<uint64_t>(data[size >> 1]) << 8) | data[size - 1];
+                    b = 0;
+                }
+                else
+                {
+                    a = 0;
+                    b = 0;
+                }
+            }
+            else
+            {
+                size_t i = size;
+                if(i > 48)
+                {
+                    uint64_t seed1 = seed;
+                    uint64_t seed2 = seed;
+                    do
+                    {
+                        seed = mix(read64(data) ^ SECRET[1], read64(data + 8) ^ seed);
+                        seed1 = mix(read64(data + 16) ^ SECRET[2], read64(data + 24) ^ seed1);
+                        seed2 = mix(read64(data + 32) ^ SECRET[3], read64(data + 40) ^ seed2);
+                        data += 48;
+                        i -= 48;
+                    } while(i > 48);
+
+                    seed ^= seed1 ^ seed2;
+                }
+
+                while(i > 16)
+                {
+                    seed = mix(read64(data) ^ SECRET[1], read64(data + 8) ^ seed);
+                    data += 16;
+                    i -= 16;
+                }
+
+                a = read64(data + i - 16);
+                b = read64(data + i - 8);
+            }
+
+            a ^= SECRET[1];
+            b ^= seed;
+            multiply(a, b);
+            return mix(a ^ SECRET[0] ^ size, b ^ SECRET[1]);
+        }
+
+        inline uint64_t integer(uint64_t value) { return mix(value ^ SECRET[0], SECRET[1]); }
+
+        inline uint64_t combine(uint64_t seed, uint64_t value)
+        {
+            return mix(seed ^ SECRET[2], value ^ SECRET[3]);
+        }
+    } // namespace hash
+} // namespace FDVar
+
+#endif // FDVAR_HASH_H
@@ -27,14 +27,14 @@ namespace FDVar
         {
         }
 
-        IntValue(IntValue &&) = default;
+        IntValue(IntValue &&) noexcept = default;
         IntValue(const IntValue &) = default;
 
         ~IntValue() noexcept override = default;
 
         ValueType getValueType() const override { return ValueType::Integer; }
 
-        IntValue &operator=(IntValue &&) = default;
+        IntValue &operator=(IntValue &&) noexcept = default;
         IntValue &operator=(const IntValue &) = default;
 
         template<typename T>
@@ -0,0 +1,187 @@
+#ifndef FDVAR_JSONEQUAL_H
+#define FDVAR_JSONEQUAL_H
+
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+
+namespace FDVar
+{
+    namespace json
+    {
+        inline bool isNumber(ValueType type)
+        {
+            return type == ValueType::Integer || type == ValueType::BigInteger ||
+                   type == ValueType::Float || type == ValueType::Decimal;
+        }
+
+        inline double number(const AbstractValue::Ptr &value)
+        {
+            if(value->getValueType() == ValueType::Integer)
+            {
+                return static_cast<double>(
+                  static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*value)));
+            }
+
+            if(value->getValueType() == ValueType::BigInteger)
+            {
+                return static_cast<const BigIntegerValue &>(*value).toFloat();
+            }
+
+            if(value->getValueType() == ValueType::Decimal)
+            {
+                return static_cast<const DecimalValue &>(*value).toFloat();
+            }
+
+            return static_cast<double>(
+              static_cast<DynamicVariable::FloatType>(static_cast<const FloatValue &>(*value)));
+        }
+
+        inline BigIntegerValue bigInteger(const AbstractValue::Ptr &value)
+        {
+            if(value->getValueType() == ValueType::Integer)
+            {
+                return BigIntegerValue(
+                  static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*value)));
+            }
+
+            return static_cast<const BigIntegerValue &>(*value);
+        }
+
+        // Numbers of different types: exact unless a Float is involved.
+        inline bool equalNumbers(const AbstractValue::Ptr &lhs, const AbstractValue::Ptr &rhs)
+        {
+            ValueType lhsType = lhs->getValueType();
+            ValueType rhsType = rhs->getValueType();
+            if(lhsType == ValueType::Float || rhsType == ValueType::Float)
+            {
+                return number(lhs) == number(rhs);
+            }
+
+            if(lhsType == ValueType::Decimal || rhsType == ValueType::Decimal)
+            {
+                const auto &decimal = static_cast<const DecimalValue &>(
+                  lhsType == ValueType::Decimal ? *lhs : *rhs);
+                DecimalValue normalized = decimal.normalized();
+                if(normalized.scale() != 0)
+                {
+                    return false;
+                }
+
+                return bigInteger(lhsType == ValueType::Decimal ? rhs : lhs)
+                         .compare(BigIntegerValue(normalized.coefficient())) == 0;
+            }
+
+            return bigInteger(lhs).compare(bigInteger(rhs)) == 0;
+        }
+
+        // Member of object named key, through find() when the object keeps its members as
+        // AbstractValue::Ptr and through get() otherwise. Returns false when there is none.
+        inline bool member(const AbstractObjectValue &object,
+                           DynamicVariable::StringViewType key,
+                           AbstractValue::Ptr &value)
+        {
+            if(const AbstractValue::Ptr *found = object.find(DynamicVariable::StringType(key)))
+            {
+                value = *found;
+                return true;
+            }
+
+            if(!object.contains(key))
+            {
+                return false;
+            }
+
+            value = object.get(key);
+            return true;
+        }
+
+        // JSON equality: numbers compare by value whatever their type, so 1, 1.0 and a Decimal
+        // 1.00 are the same, also inside arrays and objects. Other values compare as
+        // DynamicVariable does. Nested containers are walked with an explicit stack.
+        inline bool equal(const AbstractValue::Ptr &lhs, const AbstractValue::Ptr &rhs)
+        {
+            std::vector<std::pair<AbstractValue::Ptr, AbstractValue::Ptr>> pending;
+            auto visit = [&pending](const AbstractValue::Ptr &lhs, const AbstractValue::Ptr &rhs) {
+                ValueType lhsType = lhs ? lhs->getValueType() : ValueType::None;
+                ValueType rhsType = rhs ? rhs->getValueType() : ValueType::None;
+                if(isNumber(lhsType) && isNumber(rhsType))
+                {
+                    return lhsType == rhsType ? DynamicVariable(lhs) == DynamicVariable(rhs)
+                                              : equalNumbers(lhs, rhs);
+                }
+
+                if(lhsType != rhsType)
+                {
+                    return false;
+                }
+
+                if(lhsType == ValueType::Array || lhsType == ValueType::Object)
+                {
+                    if(lhs != rhs)
+                    {
+                        pending.emplace_back(lhs, rhs);
+                    }
+
+                    return true;
+                }
+
+                return DynamicVariable(lhs) == DynamicVariable(rhs);
+            };
+
+            if(!visit(lhs, rhs))
+            {
+                return false;
+            }
+
+            while(!pending.empty())
+            {
+                auto [left, right] = std::move(pending.back());
+                pending.pop_back();
+                if(left->isType(ValueType::Array))
+                {
+                    const auto &a = static_cast<const AbstractArrayValue &>(*left);
+                    const auto &b = static_cast<const AbstractArrayValue &>(*right);
+                    if(a.size() != b.size())
+                    {
+                        return false;
+                    }
+
+                    for(DynamicVariable::SizeType i = a.size(); i-- > 0;)
+                    {
+                        if(!visit(a[i], b[i]))
+                        {
+                            return false;
+                        }
+                    }
+
+                    continue;
+                }
+
+                const auto &a = static_cast<const AbstractObjectValue &>(*left);
+                const auto &b = static_cast<const AbstractObjectValue &>(*right);
+                if(a.size() != b.size())
+                {
+                    return false;
+                }
+
+                bool result = true;
+                a.forEach(
+                  [&](DynamicVariable::StringViewType key, const AbstractValue::Ptr &value) {
+                      AbstractValue::Ptr other;
+                      result = result && member(b, key, other) && visit(value, other);
+                  });
+
+                if(!result)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    } // namespace json
+} // namespace FDVar
+
+#endif // FDVAR_JSONEQUAL_H
@@ -0,0 +1,412 @@
+#ifndef FDVAR_JSONWRITER_H
+#define FDVAR_JSONWRITER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+
+namespace FDVar
+{
+    // Streams JSON text into a byte buffer. Commas are inserted automatically; the caller is
+    // responsible for balancing begin/end calls and for pairing every key with a value.
+    class JsonWriter
+    {
+      public:
+        typedef std::string BufferType;
+        typedef DynamicVariable::SizeType SizeType;
+
+      private:
+        BufferType m_buffer;
+        bool m_separate;
+
+      public:
+        JsonWriter() : m_separate(false) {}
+
+        explicit JsonWriter(BufferType &&buffer) : m_buffer(std::move(buffer)), m_separate(false)
+        {
+            m_buffer.clear();
+        }
+
+        const BufferType &str() const { return m_buffer; }
+
+        BufferType release()
+        {
+            m_separate = false;
+            return std::move(m_buffer);
+        }
+
+        void clear()
+        {
+            m_buffer.clear();
+            m_separate = false;
+        }
+
+        void reserve(SizeType size) { m_buffer.reserve(size); }
+
+        void beginObject() { open('{'); }
+        void endObject() { close('}'); }
+        void beginArray() { open('['); }
+        void endArray() { close(']'); }
+
+        template<typename CharType>
+        void key(std::basic_string_view<CharType> name)
+        {
+            string(name);
+            m_buffer.push_back(':');
+            m_separate = false;
+        }
+
+        void key(const char *name) { key(std::string_view(name)); }
+
+        // Appends a key that is already quoted, escaped and followed by ':'.
+        void rawKey(std::string_view quoted)
+        {
+            separate();
+            m_buffer.append(quoted.data(), quoted.size());
+            m_separate = false;
+        }
+
+        void null()
+        {
+            separate();
+            m_buffer.append("null", 4);
+            m_separate = true;
+        }
+
+        void boolean(bool value)
+        {
+            separate();
+            if(value)
+            {
+                m_buffer.append("true", 4);
+            }
+            else
+            {
+                m_buffer.append("false", 5);
+            }
+
+            m_separate = true;
+        }
+
+        template<typename T>
+        std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>> integer(T value)
+        {
+            separate();
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            m_buffer.append(digits, result.ptr);
+            m_separate = true;
+        }
+
+        // JSON has no NaN or infinity; they are written as null.
+        template<typename T>
+        std::enable_if_t<std::is_floating_point_v<T>> number(T value)
+        {
+            if(!std::isfinite(value))
+            {
+                null();
+                return;
+            }
+
+            separate();
+            char digits[64];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            m_buffer.append(digits, result.ptr);
+            if(std::find_if(digits, result.ptr, [](char c) { return c == '.' || c == 'e'; }) ==
+               result.ptr)
+            {
+                m_buffer.append(".0", 2);
+            }
+
+            m_separate = true;
+        }
+
+        // Appends a number that is already formatted as JSON, such as exact decimal digits.
+        void rawNumber(std::string_view digits)
+        {
+            separate();
+            m_buffer.append(digits.data(), digits.size());
+            m_separate = true;
+        }
+
+        template<typename CharType>
+        void string(std::basic_string_view<CharType> value)
+        {
+            separate();
+            m_buffer.push_back('"');
+            if constexpr(sizeof(CharType) == 1)
+            {
+                SizeType start = 0;
+                for(SizeType i = 0, imax = value.size(); i < imax; ++i)
+                {
+                    auto c = static_cast<unsigned char>(value[i]);
+                    if(c >= 0x20 && c != '"' && c != '\\')
+                    {
+                        continue;
+                    }
+
+                    m_buffer.append(reinterpret_cast<const char *>(value.data()) + start,
+                                    i - start);
+                    escape(c);
+                    start = i + 1;
+                }
+
+                m_buffer.append(reinterpret_cast<const char *>(value.data()) + start,
+                                value.size() - start);
+            }
+            else
+            {
+                for(auto unit: value)
+                {
+                    auto c = static_cast<uint32_t>(unit);
+                    if(c >= 0x20 && c < 0x80 && c != '"' && c != '\\')
+                    {
+                        m_buffer.push_back(static_cast<char>(c));
+                    }
+                    else if(c >= 0x10000)
+                    {
+                        c -= 0x10000;
+                        escape(0xD800 + (c >> 10));
+                        escape(0xDC00 + (c & 0x3FF));
+                    }
+                    else
+                    {
+                        escape(c);
+                    }
+                }
+            }
+
+            m_buffer.push_back('"');
+            m_separate = true;
+        }
+
+        void string(const char *value) { string(std::string_view(value)); }
+
+        // Binary data as a base64 string (RFC 4648, padded).
+        void binary(const void *data, SizeType size)
+        {
+            constexpr const char *ALPHABET =
+              "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            const auto *bytes = static_cast<const uint8_t *>(data);
+            separate();
+            SizeType start = m_buffer.size();
+            m_buffer.resize(start + 2 + (size + 2) / 3 * 4);
+            char *out = &m_buffer[start];
+            *out++ = '"';
+            SizeType i = 0;
+            for(; i + 3 <= size; i += 3)
+            {
+                uint32_t group = (uint32_t(bytes[i]) << 16) | (uint32_t(bytes[i + 1]) << 8) |
+                                 bytes[i + 2];
+                out[0] = ALPHABET[group >> 18];
+                out[1] = ALPHABET[(group >> 12) & 0x3F];
+                out[2] = ALPHABET[(group >> 6) & 0x3F];
+                out[3] = ALPHABET[group & 0x3F];
+                out += 4;
+            }
+
+            if(i < size)
+            {
+                uint32_t group = uint32_t(bytes[i]) << 16;
+                if(i + 1 < size)
+                {
+                    group |= uint32_t(bytes[i + 1]) << 8;
+                }
+
+                out[0] = ALPHABET[group >> 18];
+                out[1] = ALPHABET[(group >> 12) & 0x3F];
+                out[2] = i + 1 < size ? ALPHABET[(group >> 6) & 0x3F] : '=';
+                out[3] = '=';
+                out += 4;
+            }
+
+            *out = '"';
+            m_separate = true;
+        }
+
+        void value(const DynamicVariable &root)
+        {
+            struct Frame
+            {
+                AbstractValue::Ptr container;
+                std::vector<std::pair<DynamicVariable::StringType, AbstractValue::Ptr>> members;
+                SizeType next;
+            };
+
+            std::vector<Frame> stack;
+            const AbstractValue::Ptr *current = &root.internalValue();
+            while(true)
+            {
+                if(current != nullptr)
+                {
+                    const AbstractValue::Ptr &node = *current;
+                    current = nullptr;
+                    if(node && node->getValueType() == ValueType::Array)
+                    {
+                        beginArray();
+                        stack.push_back(Frame { node, {}, 0 });
+                    }
+                    else if(node && node->getValueType() == ValueType::Object)
+                    {
+                        beginObject();
+                        Frame frame { node, {}, 0 };
+                        static_cast<const AbstractObjectValue &>(*node).forEach(
+                          [&frame](DynamicVariable::StringViewType name,
+                                   const AbstractValue::Ptr &member) {
+                              frame.members.emplace_back(name, member);
+                          });
+                        stack.push_back(std::move(frame));
+                    }
+                    else
+                    {
+                        scalar(node);
+                    }
+                }
+
+                if(stack.empty())
+                {
+                    return;
+                }
+
+                Frame &frame = stack.back();
+                if(frame.container->getValueType() == ValueType::Array)
+                {
+                    const auto &array = static_cast<const AbstractArrayValue &>(*frame.container);
+                    if(frame.next < array.size())
+                    {
+                        current = &array[frame.next++];
+                        continue;
+                    }
+
+                    stack.pop_back();
+                    endArray();
+                }
+                else
+                {
+                    if(frame.next < frame.members.size())
+                    {
+                        auto &member = frame.members[frame.next++];
+                        key(DynamicVariable::StringViewType(member.first));
+                        current = &member.second;
+                        continue;
+                    }
+
+                    stack.pop_back();
+                    endObject();
+                }
+            }
+        }
+
+      private:
+        void separate()
+        {
+            if(m_separate)
+            {
+                m_buffer.push_back(',');
+            }
+        }
+
+        void open(char bracket)
+        {
+            separate();
+            m_buffer.push_back(bracket);
+            m_separate = false;
+        }
+
+        void close(char bracket)
+        {
+            m_buffer.push_back(bracket);
+            m_separate = true;
+        }
+
+        void escape(uint32_t c)
+        {
+            switch(c)
+            {
+                case '"':
+                    m_buffer.append("\\\"", 2);
+                    return;
+                case '\\':
+                    m_buffer.append("\\\\", 2);
+                    return;
+                case '\b':
+                    m_buffer.append("\\b", 2);
+                    return;
+                case '\f':
+                    m_buffer.append("\\f", 2);
+                    return;
+                case '\n':
+                    m_buffer.append("\\n", 2);
+                    return;
+                case '\r':
+                    m_buffer.append("\\r", 2);
+                    return;
+                case '\t':
+                    m_buffer.append("\\t", 2);
+                    return;
+                default:
+                    break;
+            }
+
+            constexpr const char *HEX = "0123456789abcdef";
+            char sequence[6] = { '\\', 'u', HEX[(c >> 12) & 0xF], HEX[(c >> 8) & 0xF],
+                                 HEX[(c >> 4) & 0xF], HEX[c & 0xF] };
+            m_buffer.append(sequence, sizeof(sequence));
+        }
+
+        void scalar(const AbstractValue::Ptr &node)
+        {
+            switch(node ? node->getValueType() : ValueType::None)
+            {
+                case ValueType::None:
+                    null();
+                    break;
+                case ValueType::Boolean:
+                    boolean(static_cast<bool>(static_cast<const BoolValue &>(*node)));
+                    break;
+                case ValueType::Integer:
+                    integer(static_cast<DynamicVariable::IntType>(
+                      static_cast<const IntValue &>(*node)));
+                    break;
+                case ValueType::Float:
+                    number(static_cast<DynamicVariable::FloatType>(
+                      static_cast<const FloatValue &>(*node)));
+                    break;
+                case ValueType::String:
+                    string(static_cast<const StringValue &>(*node).view());
+                    break;
+                case ValueType::BigInteger:
+                    rawNumber(static_cast<const BigIntegerValue &>(*node).toString());
+                    break;
+                case ValueType::Decimal:
+                    rawNumber(static_cast<const DecimalValue &>(*node).toString());
+                    break;
+                case ValueType::Bytes:
+                {
+                    const auto &bytes = static_cast<const BytesValue &>(*node);
+                    binary(bytes.data(), bytes.size());
+                    break;
+                }
+                case ValueType::Timestamp:
+                    string(std::string_view(static_cast<const TimestampValue &>(*node).toString()));
+                    break;
+                case ValueType::Duration:
+                    string(std::string_view(static_cast<const DurationValue &>(*node).toString()));
+                    break;
+                default:
+                    throw std::invalid_argument("JsonWriter: value has no JSON representation");
+            }
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_JSONWRITER_H
@@ -0,0 +1,359 @@
+#ifndef FDVAR_LAZYARITHMETIC_H
+#define FDVAR_LAZYARITHMETIC_H
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <FDVar/DynamicVariable.h>
+
+namespace FDVar
+{
+    namespace detail
+    {
+        struct LazyNumber
+        {
+            typedef DynamicVariable::IntType IntType;
+            typedef DynamicVariable::FloatType FloatType;
+
+            bool isFloat;
+            IntType integer;
+            FloatType real;
+
+            // Holds the operand or step result when it is not an Integer or Float, for example a
+            // BigInteger or Decimal; evaluation then continues with the eager operators.
+            DynamicVariable generic = DynamicVariable();
+
+            bool isGeneric() const { return !generic.isType(ValueType::None); }
+
+            FloatType toFloat() const { return isFloat ? real : static_cast<FloatType>(integer); }
+
+            DynamicVariable toDynamicVariable() const
+            {
+                if(isGeneric())
+                {
+                    return DynamicVariable(generic.internalValue());
+                }
+
+                return isFloat ? DynamicVariable(real) : DynamicVariable(integer);
+            }
+
+            static LazyNumber from(DynamicVariable value)
+            {
+                const AbstractValue::Ptr &node = value.internalValue();
+                switch(value.getValueType())
+                {
+                    case ValueType::Integer:
+                        return { false, static_cast<IntType>(static_cast<const IntValue &>(*node)),
+                                 0 };
+
+                    case ValueType::Float:
+                        return { true, 0,
+                                 static_cast<FloatType>(static_cast<const FloatValue &>(*node)) };
+
+                    case ValueType::None:
+                        throw std::runtime_error("lazy: unsupported action on type " +
+                                                 std::to_string(ValueType::None));
+
+                    default:
+                        return { false, 0, 0, std::move(value) };
+                }
+            }
+        };
+
+        // Refers to a DynamicVariable owned by the caller; it must outlive evaluation.
+        class LazyVariable
+        {
+          private:
+            const DynamicVariable *m_value;
+
+          public:
+            explicit LazyVariable(const DynamicVariable &value) : m_value(&value) {}
+
+            // Other value types share the operand's node and are combined eagerly.
+            LazyNumber evaluate() const
+            {
+                const AbstractValue::Ptr &node = m_value->internalValue();
+                switch(m_value->getValueType())
+                {
+                    case ValueType::Integer:
+                        return { false,
+                                 static_cast<LazyNumber::IntType>(
+                                   static_cast<const IntValue &>(*node)),
+                                 0 };
+
+                    case ValueType::Float:
+                        return { true,
+                                 0,
+                                 static_cast<LazyNumber::FloatType>(
+                                   static_cast<const FloatValue &>(*node)) };
+
+                    default:
+                        return LazyNumber::from(DynamicVariable(node));
+                }
+            }
+        };
+
+        template<typename T>
+        class LazyScalar
+        {
+          private:
+            T m_value;
+
+          public:
+            explicit LazyScalar(T value) : m_value(value) {}
+
+            LazyNumber evaluate() const
+            {
+                if constexpr(std::is_floating_point_v<T>)
+                {
+                    return { true, 0, static_cast<LazyNumber::FloatType>(m_value) };
+                }
+                else
+                {
+                    return { false, static_cast<LazyNumber::IntType>(m_value), 0 };
+                }
+            }
+        };
+
+        template<arithmetic::Operation O, typename Lhs, typename Rhs>
+        class LazyBinary
+        {
+          private:
+            Lhs m_lhs;
+            Rhs m_rhs;
+
+          public:
+            LazyBinary(Lhs lhs, Rhs rhs) : m_lhs(lhs), m_rhs(rhs) {}
+
+            // Integers stay integers under DEFAULT_ARITHMETIC_POLICY; any float operand promotes
+            // the step to FloatType, as the IntValue and FloatValue operators do. Modulo accepts
+            // integers only. A step with another operand type, or one that PromoteToBigInteger
+            // widens, runs through the DynamicVariable operators so both paths agree.
+            LazyNumber evaluate() const
+            {
+                LazyNumber lhs = m_lhs.evaluate();
+                LazyNumber rhs = m_rhs.evaluate();
+                if(lhs.isGeneric() || rhs.isGeneric())
+                {
+                    return eager(lhs, rhs);
+                }
+
+                if(!lhs.isFloat && !rhs.isFloat)
+                {
+                    if constexpr(DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::PromoteToFloat)
+                    {
+                        LazyNumber result { false, 0, 0 };
+                        result.isFloat =
+                          !arithmetic::promote<O>(lhs.integer, rhs.integer, result.integer,
+                                                  result.real);
+                        return result;
+                    }
+                    else if constexpr(DEFAULT_ARITHMETIC_POLICY ==
+                                      ArithmeticPolicy::PromoteToBigInteger)
+                    {
+                        LazyNumber result { false, 0, 0 };
+                        if(!arithmetic::fits<O>(lhs.integer, rhs.integer, result.integer))
+                        {
+                            return eager(lhs, rhs);
+                        }
+
+                        return result;
+                    }
+                    else
+                    {
+                        return { false,
+                                 arithmetic::apply<DEFAULT_ARITHMETIC_POLICY, O>(lhs.integer,
+                                                                                 rhs.integer),
+                                 0 };
+                    }
+                }
+
+                LazyNumber::FloatType a = lhs.toFloat();
+                LazyNumber::FloatType b = rhs.toFloat();
+                if constexpr(O == arithmetic::Operation::Add)
+                {
+                    return { true, 0, a + b };
+                }
+                else if constexpr(O == arithmetic::Operation::Subtract)
+                {
+                    return { true, 0, a - b };
+                }
+                else if constexpr(O == arithmetic::Operation::Multiply)
+                {
+                    return { true, 0, a * b };
+                }
+                else if constexpr(O == arithmetic::Operation::Divide)
+                {
+                    return { true, 0, a / b };
+                }
+                else
+                {
+                    throw std::runtime_error("lazy: modulo needs integer operands");
+                }
+            }
+
+            DynamicVariable toDynamicVariable() const { return evaluate().toDynamicVariable(); }
+
+            operator DynamicVariable() const { return toDynamicVariable(); }
+
+            // Writes the result into target, reusing its node when it already holds a number of
+            // the result type and is not shared.
+            void assignTo(DynamicVariable &target) const
+            {
+                LazyNumber result = evaluate();
+                if(result.isGeneric())
+                {
+                    target = std::move(result.generic);
+                    return;
+                }
+
+                const AbstractValue::Ptr &node =
+                  static_cast<const DynamicVariable &>(target).internalValue();
+                if(node.use_count() == 1)
+                {
+                    if(!result.isFloat && target.isType(ValueType::Integer))
+                    {
+                        static_cast<IntValue &>(*node) = IntValue(result.integer);
+                        return;
+                    }
+
+                    if(result.isFloat && target.isType(ValueType::Float))
+                    {
+                        static_cast<FloatValue &>(*node) = FloatValue(result.real);
+                        return;
+                    }
+                }
+
+                target = result.toDynamicVariable();
+            }
+
+          private:
+            static LazyNumber eager(const LazyNumber &lhs, const LazyNumber &rhs)
+            {
+                DynamicVariable a = lhs.toDynamicVariable();
+                DynamicVariable b = rhs.toDynamicVariable();
+                if constexpr(O == arithmetic::Operation::Add)
+                {
+                    return LazyNumber::from(a + b);
+                }
+                else if constexpr(O == arithmetic::Operation::Subtract)
+                {
+                    return LazyNumber::from(a - b);
+                }
+                else if constexpr(O == arithmetic::Operation::Multiply)
+                {
+                    return LazyNumber::from(a * b);
+                }
+                else if constexpr(O == arithmetic::Operation::Divide)
+                {
+                    return LazyNumber::from(a / b);
+                }
+                else
+                {
+                    return LazyNumber::from(a % b);
+                }
+            }
+        };
+
+        template<typename T>
+        struct is_lazy : std::false_type
+        {
+        };
+
+        template<>
+        struct is_lazy<LazyVariable> : std::true_type
+        {
+        };
+
+        template<arithmetic::Operation O, typename Lhs, typename Rhs>
+        struct is_lazy<LazyBinary<O, Lhs, Rhs>> : std::true_type
+        {
+        };
+
+        template<typename T>
+        inline constexpr bool is_lazy_v = is_lazy<std::decay_t<T>>::value;
+
+        template<typename T>
+        inline constexpr bool is_lazy_scalar_v =
+          std::is_arithmetic_v<std::decay_t<T>> && !std::is_same_v<std::decay_t<T>, bool>;
+
+        template<typename T>
+        inline constexpr bool is_lazy_operand_v =
+          is_lazy_v<T> || is_lazy_scalar_v<T> ||
+          std::is_same_v<std::decay_t<T>, DynamicVariable>;
+
+        template<typename Lhs, typename Rhs>
+        inline constexpr bool is_lazy_pair_v =
+          (is_lazy_v<Lhs> || is_lazy_v<Rhs>) && is_lazy_operand_v<Lhs> && is_lazy_operand_v<Rhs>;
+
+        template<typename T>
+        auto toLazy(const T &value)
+        {
+            if constexpr(is_lazy_v<T>)
+            {
+                return value;
+            }
+            else if constexpr(std::is_same_v<T, DynamicVariable>)
+            {
+                return LazyVariable(value);
+            }
+            else
+            {
+                return LazyScalar<T>(value);
+            }
+        }
+
+        template<arithmetic::Operation O, typename Lhs, typename Rhs>
+        auto makeLazy(const Lhs &lhs, const Rhs &rhs)
+        {
+            typedef decltype(toLazy(lhs)) LhsType;
+            typedef decltype(toLazy(rhs)) RhsType;
+            return LazyBinary<O, LhsType, RhsType>(toLazy(lhs), toLazy(rhs));
+        }
+
+        template<typename Lhs, typename Rhs, typename = std::enable_if_t<is_lazy_pair_v<Lhs, Rhs>>>
+        auto operator+(const Lhs &lhs, const Rhs &rhs)
+        {
+            return makeLazy<arithmetic::Operation::Add>(lhs, rhs);
+        }
+
+        template<typename Lhs, typename Rhs, typename = std::enable_if_t<is_lazy_pair_v<Lhs, Rhs>>>
+        auto operator-(const Lhs &lhs, const Rhs &rhs)
+        {
+            return makeLazy<arithmetic::Operation::Subtract>(lhs, rhs);
+        }
+
+        template<typename Lhs, typename Rhs, typename = std::enable_if_t<is_lazy_pair_v<Lhs, Rhs>>>
+        auto operator*(const Lhs &lhs, const Rhs &rhs)
+        {
+            return makeLazy<arithmetic::Operation::Multiply>(lhs, rhs);
+        }
+
+        template<typename Lhs, typename Rhs, typename = std::enable_if_t<is_lazy_pair_v<Lhs, Rhs>>>
+        auto operator/(const Lhs &lhs, const Rhs &rhs)
+        {
+            return makeLazy<arithmetic::Operation::Divide>(lhs, rhs);
+        }
+
+        template<typename Lhs, typename Rhs, typename = std::enable_if_t<is_lazy_pair_v<Lhs, Rhs>>>
+        auto operator%(const Lhs &lhs, const Rhs &rhs)
+        {
+            return makeLazy<arithmetic::Operation::Modulo>(lhs, rhs);
+        }
+    } // namespace detail
+
+    // Starts a deferred arithmetic chain: lazy(x) * 2 + y - z builds the whole expression and
+    // evaluates it once, checking the type of every operand a single time and allocating only
+    // the result. The chain keeps references to its DynamicVariable operands, so convert it to
+    // a DynamicVariable (or call assignTo) within the full expression instead of storing it.
+    inline detail::LazyVariable lazy(const DynamicVariable &value)
+    {
+        return detail::LazyVariable(value);
+    }
+
+    detail::LazyVariable lazy(DynamicVariable &&value) = delete;
+} // namespace FDVar
+
+#endif // FDVAR_LAZYARITHMETIC_H
@@ -0,0 +1,322 @@
+#ifndef FDVAR_NANBOXEDVARIABLE_H
+#define FDVAR_NANBOXEDVARIABLE_H
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <FDVar/DynamicVariable.h>
+
+#if UINTPTR_MAX == 0xFFFFFFFFFFFFFFFFULL
+    #define FDVAR_NAN_BOXING_SUPPORTED 1
+#else
+    #define FDVAR_NAN_BOXING_SUPPORTED 0
+#endif
+
+namespace FDVar
+{
+#if FDVAR_NAN_BOXING_SUPPORTED
+    // An 8-byte value. Doubles are stored as they are, with every NaN folded into one canonical
+    // quiet NaN. The negative quiet NaN space carries a 3-bit tag and a 48-bit payload holding
+    // None, booleans, integers that fit in 48 bits, or a pointer to a reference-counted box that
+    // owns any other value (strings, wide integers, arrays, objects and functions).
+    // It is an opt-in value type for callers that store many scalars, such as a
+    // std::vector<NanBoxedVariable>; ArrayValue and DynamicVariable do not use it. Only available
+    // on 64-bit platforms, where FDVAR_NAN_BOXING_SUPPORTED is 1.
+    class NanBoxedVariable
+    {
+      public:
+        typedef DynamicVariable::IntType IntType;
+        typedef DynamicVariable::FloatType FloatType;
+        typedef DynamicVariable::StringViewType StringViewType;
+
+        static_assert(std::is_same_v<FloatType, double>, "NaN boxing needs a double FloatType");
+
+      private:
+        struct Box
+        {
+            std::atomic<uint32_t> references;
+            AbstractValue::Ptr value;
+        };
+
+        enum Tag : uint64_t
+        {
+            NoneTag = 1,
+            BooleanTag = 2,
+            IntegerTag = 3,
+            BoxTag = 4
+        };
+
+        static constexpr uint64_t TAGGED = 0xFFF8000000000000ULL;
+        static constexpr uint64_t PAYLOAD = 0x0000FFFFFFFFFFFFULL;
+        static constexpr uint64_t CANONICAL_NAN = 0x7FF8000000000000ULL;
+        static constexpr int64_t INTEGER_MIN = -(int64_t(1) << 47);
+        static constexpr int64_t INTEGER_MAX = (int64_t(1) << 47) - 1;
+
+        uint64_t m_bits;
+
+        static constexpr uint64_t encode(Tag tag, uint64_t payload)
+        {
+            return TAGGED | (static_cast<uint64_t>(tag) << 48) | (payload & PAYLOAD);
+        }
+
+      public:
+        NanBoxedVariable() noexcept : m_bits(encode(NoneTag, 0)) {}
+
+        NanBoxedVariable(bool value) noexcept : m_bits(encode(BooleanTag, value ? 1 : 0)) {}
+
+        template<typename T,
+                 typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+        NanBoxedVariable(T value) : m_bits(0)
+        {
+            auto integer = static_cast<IntType>(value);
+            if(integer >= INTEGER_MIN && integer <= INTEGER_MAX)
+            {
+                m_bits = encode(IntegerTag, static_cast<uint64_t>(integer));
+            }
+            else
+            {
+                m_bits = box(std::make_shared<IntValue>(integer));
+            }
+        }
+
+        NanBoxedVariable(double value) noexcept : m_bits(0)
+        {
+            if(std::isnan(value))
+            {
+                m_bits = CANONICAL_NAN;
+            }
+            else
+            {
+                std::memcpy(&m_bits, &value, sizeof(m_bits));
+            }
+        }
+
+        NanBoxedVariable(float value) noexcept : NanBoxedVariable(static_cast<double>(value)) {}
+
+        NanBoxedVariable(StringViewType value) :
+            m_bits(box(std::make_shared<StringValue>(value)))
+        {
+        }
+
+        NanBoxedVariable(const char *value) : NanBoxedVariable(StringViewType(value)) {}
+
+        // Scalars are unboxed; strings, arrays, objects and functions are shared with value.
+        explicit NanBoxedVariable(const DynamicVariable &value) : m_bits(encode(NoneTag, 0))
+        {
+            switch(value.getValueType())
+            {
+                case ValueType::None:
+                    break;
+                case ValueType::Boolean:
+                    *this = NanBoxedVariable(static_cast<bool>(value));
+                    break;
+                case ValueType::Integer:
+                    *this = NanBoxedVariable(static_cast<IntType>(value));
+                    break;
+                case ValueType::Float:
+                    *this = NanBoxedVariable(static_cast<FloatType>(value));
+                    break;
+                default:
+                    m_bits = box(value.internalValue());
+                    break;
+            }
+        }
+
+        NanBoxedVariable(const NanBoxedVariable &other) noexcept : m_bits(other.m_bits)
+        {
+            if(isBoxed())
+            {
+                boxed()->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        NanBoxedVariable(NanBoxedVariable &&other) noexcept : m_bits(other.m_bits)
+        {
+            other.m_bits = encode(NoneTag, 0);
+        }
+
+        ~NanBoxedVariable() { release(); }
+
+        NanBoxedVariable &operator=(const NanBoxedVariable &other) noexcept
+        {
+            NanBoxedVariable copy(other);
+            std::swap(m_bits, copy.m_bits);
+            return *this;
+        }
+
+        NanBoxedVariable &operator=(NanBoxedVariable &&other) noexcept
+        {
+            std::swap(m_bits, other.m_bits);
+            return *this;
+        }
+
+        ValueType getValueType() const
+        {
+            if(!isTagged())
+            {
+                return ValueType::Float;
+            }
+
+            switch(tag())
+            {
+                case BooleanTag:
+                    return ValueType::Boolean;
+                case IntegerTag:
+                    return ValueType::Integer;
+                case BoxTag:
+                    return boxed()->value->getValueType();
+                default:
+                    return ValueType::None;
+            }
+        }
+
+        bool isType(ValueType type) const { return type == getValueType(); }
+
+        // True when the value lives in the 8-byte word and needs no heap node.
+        bool isInline() const { return !isBoxed(); }
+
+        bool toBool() const
+        {
+            if(!isTagged() || tag() != BooleanTag)
+            {
+                throw generateCastException(__func__);
+            }
+
+            return (m_bits & 1) != 0;
+        }
+
+        IntType toInteger() const
+        {
+            if(isTagged() && tag() == IntegerTag)
+            {
+                // Sign-extend the 48-bit payload.
+                return static_cast<IntType>(static_cast<int64_t>(m_bits << 16) >> 16);
+            }
+
+            if(isType(ValueType::Integer))
+            {
+                return static_cast<IntType>(static_cast<const IntValue &>(*boxed()->value));
+            }
+
+            throw generateCastException(__func__);
+        }
+
+        FloatType toFloat() const
+        {
+            if(isTagged())
+            {
+                throw generateCastException(__func__);
+            }
+
+            double value;
+            std::memcpy(&value, &m_bits, sizeof(value));
+            return value;
+        }
+
+        StringViewType view() const
+        {
+            if(!isType(ValueType::String))
+            {
+                throw generateCastException(__func__);
+            }
+
+            return static_cast<const StringValue &>(*boxed()->value).view();
+        }
+
+        DynamicVariable toDynamicVariable() const
+        {
+            if(!isTagged())
+            {
+                return DynamicVariable(toFloat());
+            }
+
+            switch(tag())
+            {
+                case BooleanTag:
+                    return DynamicVariable(toBool());
+                case IntegerTag:
+                    return DynamicVariable(toInteger());
+                case BoxTag:
+                    return DynamicVariable(boxed()->value);
+                default:
+                    return DynamicVariable();
+            }
+        }
+
+        bool operator==(const NanBoxedVariable &other) const
+        {
+            if(m_bits == other.m_bits)
+            {
+                return isTagged() || toFloat() == other.toFloat();
+            }
+
+            if(!isTagged() && !other.isTagged())
+            {
+                return toFloat() == other.toFloat();
+            }
+
+            if(isBoxed() || other.isBoxed())
+            {
+                return toDynamicVariable() == other.toDynamicVariable();
+            }
+
+            return false;
+        }
+
+        bool operator!=(const NanBoxedVariable &other) const { return !(*this == other); }
+
+      private:
+        bool isTagged() const { return (m_bits & TAGGED) == TAGGED; }
+
+        bool isBoxed() const { return isTagged() && tag() == BoxTag; }
+
+        uint64_t tag() const { return (m_bits >> 48) & 0x7; }
+
+        Box *boxed() const
+        {
+            return reinterpret_cast<Box *>(static_cast<uintptr_t>(m_bits & PAYLOAD));
+        }
+
+        static uint64_t box(AbstractValue::Ptr value)
+        {
+            auto *holder = new Box { { 1 }, std::move(value) };
+            auto address = reinterpret_cast<uintptr_t>(holder);
+            if((address & ~PAYLOAD) != 0)
+            {
+                delete holder;
+                throw std::runtime_error("NanBoxedVariable: pointer does not fit in 48 bits");
+            }
+
+            return encode(BoxTag, address);
+        }
+
+        void release()
+        {
+            if(isBoxed())
+            {
+                Box *holder = boxed();
+                if(holder->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete holder;
+                }
+            }
+        }
+
+        std::runtime_error generateCastException(const std::string &caller) const
+        {
+            return std::runtime_error(caller + ": unsupported action on type " +
+                                      std::to_string(getValueType()));
+        }
+    };
+
+    static_assert(sizeof(NanBoxedVariable) == 8, "NanBoxedVariable must fit in one word");
+#endif // FDVAR_NAN_BOXING_SUPPORTED
+} // namespace FDVar
+
+#endif // FDVAR_NANBOXEDVARIABLE_H
@@ -27,7 +27,29 @@ namespace FDVar
         ObjectValue(ObjectType &&values) : m_values(std::move(values)) {}
         ObjectValue(const ObjectType &values) : m_values(values) {}
 
-        ~ObjectValue() override = default;
+        ~ObjectValue() override
+        {
+            if(releaseHandler() != nullptr && !m_values.empty() &&
+               m_values.size() >= releaseThreshold())
+            {
+                std::vector<AbstractValue::Ptr> children;
+                detachChildren(children);
+                if(!deferRelease(children))
+                {
+                    releaseInline(children);
+                }
+
+                return;
+            }
+
+            std::vector<AbstractValue::Ptr> pending;
+            for(auto &[key, value]: m_values)
+            {
+                pushUnique(pending, value);
+            }
+
+            releaseChildren(pending);
+        }
 
         ObjectValue &operator=(ObjectValue &&) = default;
         ObjectValue &operator=(const ObjectValue &) = default;
@@ -85,6 +107,39 @@ namespace FDVar
         }
 
         void unset(StringViewType key) override { m_values.erase(StringType(key)); }
+
+        const AbstractValue::Ptr *find(const StringType &member) const override
+        {
+            auto it = m_values.find(member);
+            return it == m_values.end() ? nullptr : &it->second;
+        }
+
+        bool contains(StringViewType member) const override
+        {
+            return m_values.find(StringType(member)) != m_values.end();
+        }
+
+        SizeType size() const override { return m_values.size(); }
+
+        size_t childCount() const override { return m_values.size(); }
+
+        void forEach(const VisitorType &visitor) const override
+        {
+            for(const auto &[key, value]: m_values)
+            {
+                visitor(key, value);
+            }
+        }
+
+        void detachChildren(std::vector<AbstractValue::Ptr> &children) override
+        {
+            for(auto &[key, value]: m_values)
+            {
+                children.push_back(std::move(value));
+            }
+
+            m_values.clear();
+        }
     };
 
     template<>
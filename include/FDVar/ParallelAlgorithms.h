@@ -0,0 +1,176 @@
+#ifndef FDVAR_PARALLELALGORITHMS_H
+#define FDVAR_PARALLELALGORITHMS_H
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/ThreadPool.h>
+
+namespace FDVar
+{
+    namespace detail
+    {
+        inline const AbstractArrayValue &toParallelArray(const DynamicVariable &var,
+                                                         const char *caller)
+        {
+            if(!var.isType(ValueType::Array))
+            {
+                throw std::runtime_error(std::string(caller) + ": unsupported action on type " +
+                                         std::to_string(var.getValueType()));
+            }
+
+            return static_cast<const AbstractArrayValue &>(*var.internalValue());
+        }
+    } // namespace detail
+
+    template<typename FunctionType>
+    DynamicVariable parallelMap(const DynamicVariable &var,
+                                FunctionType &&func,
+                                ThreadPool &pool = ThreadPool::instance(),
+                                ThreadPool::SizeType grain = 0)
+    {
+        const AbstractArrayValue &arr = detail::toParallelArray(var, __func__);
+        DynamicVariable::ArrayType result(arr.size());
+        pool.parallelFor(0, arr.size(), grain, [&](size_t from, size_t to) {
+            for(size_t i = from; i < to; ++i)
+            {
+                result[i] = DynamicVariable(func(DynamicVariable(arr[i]))).internalValue();
+            }
+        });
+
+        return DynamicVariable(std::move(result));
+    }
+
+    template<typename PredicateType>
+    DynamicVariable parallelFilter(const DynamicVariable &var,
+                                   PredicateType &&pred,
+                                   ThreadPool &pool = ThreadPool::instance(),
+                                   ThreadPool::SizeType grain = 0)
+    {
+        const AbstractArrayValue &arr = detail::toParallelArray(var, __func__);
+        ThreadPool::SizeType count = arr.size();
+        if(grain == 0)
+        {
+            grain = std::max<ThreadPool::SizeType>(count / ((pool.size() + 1) * 8), 1);
+        }
+
+        std::vector<DynamicVariable::ArrayType> chunks((count + grain - 1) / grain);
+        pool.parallelFor(0, count, grain, [&](size_t from, size_t to) {
+            DynamicVariable::ArrayType &kept = chunks[from / grain];
+            for(size_t i = from; i < to; ++i)
+            {
+                if(static_cast<bool>(pred(DynamicVariable(arr[i]))))
+                {
+                    kept.push_back(arr[i]);
+                }
+            }
+        });
+
+        DynamicVariable::ArrayType result;
+        ThreadPool::SizeType total = 0;
+        for(const auto &kept: chunks)
+        {
+            total += kept.size();
+        }
+
+        result.reserve(total);
+        for(auto &kept: chunks)
+        {
+            std::move(kept.begin(), kept.end(), std::back_inserter(result));
+        }
+
+        return DynamicVariable(std::move(result));
+    }
+
+    template<typename OperationType>
+    DynamicVariable parallelReduce(const DynamicVariable &var,
+                                   const DynamicVariable &init,
+                                   OperationType &&op,
+                                   ThreadPool &pool = ThreadPool::instance(),
+                                   ThreadPool::SizeType grain = 0)
+    {
+        const AbstractArrayValue &arr = detail::toParallelArray(var, __func__);
+        ThreadPool::SizeType count = arr.size();
+        if(grain == 0)
+        {
+            grain = std::max<ThreadPool::SizeType>(count / ((pool.size() + 1) * 8), 1);
+        }
+
+        std::vector<DynamicVariable> partials((count + grain - 1) / grain);
+        pool.parallelFor(0, count, grain, [&](size_t from, size_t to) {
+            DynamicVariable first(arr[from]);
+            DynamicVariable acc(first);
+            for(size_t i = from + 1; i < to; ++i)
+            {
+                acc = op(acc, DynamicVariable(arr[i]));
+            }
+
+            partials[from / grain] = std::move(acc);
+        });
+
+        DynamicVariable result(init);
+        for(const auto &partial: partials)
+        {
+            result = op(result, partial);
+        }
+
+        return result;
+    }
+
+    template<typename CompareType>
+    void parallelSort(DynamicVariable &var,
+                      CompareType &&comp,
+                      ThreadPool &pool = ThreadPool::instance(),
+                      ThreadPool::SizeType grain = 0)
+    {
+        const AbstractArrayValue &arr = detail::toParallelArray(var, __func__);
+        ThreadPool::SizeType count = arr.size();
+        if(grain == 0)
+        {
+            grain = std::max<ThreadPool::SizeType>(count / (pool.size() + 1), 1024);
+        }
+
+        std::vector<DynamicVariable> values;
+        values.reserve(count);
+        for(ThreadPool::SizeType i = 0; i < count; ++i)
+        {
+            values.emplace_back(arr[i]);
+        }
+
+        pool.parallelFor(0, count, grain, [&](size_t from, size_t to) {
+            std::sort(values.begin() + from, values.begin() + to, comp);
+        });
+
+        std::vector<DynamicVariable> buffer(count);
+        for(ThreadPool::SizeType width = grain; width < count; width *= 2)
+        {
+            ThreadPool::SizeType pairCount = (count + 2 * width - 1) / (2 * width);
+            pool.parallelFor(0, pairCount, 1, [&](size_t from, size_t to) {
+                for(size_t pair = from; pair < to; ++pair)
+                {
+                    auto first = values.begin() + pair * 2 * width;
+                    auto middle = values.begin() + std::min(count, (pair * 2 + 1) * width);
+                    auto last = values.begin() + std::min(count, (pair * 2 + 2) * width);
+                    std::merge(std::make_move_iterator(first), std::make_move_iterator(middle),
+                               std::make_move_iterator(middle), std::make_move_iterator(last),
+                               buffer.begin() + pair * 2 * width, comp);
+                }
+            });
+
+            values.swap(buffer);
+        }
+
+        AbstractArrayValue &target = static_cast<AbstractArrayValue &>(*var.internalValue());
+        target.clear();
+        for(auto &value: values)
+        {
+            target.push(value.internalValue());
+        }
+    }
+} // namespace FDVar
+
+#endif // FDVAR_PARALLELALGORITHMS_H
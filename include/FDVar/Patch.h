@@ -0,0 +1,530 @@
+#ifndef FDVAR_PATCH_H
+#define FDVAR_PATCH_H
+
+#ifndef FDVAR_PATCH_LCS_LIMIT
+    #define FDVAR_PATCH_LCS_LIMIT (1 << 20)
+#endif // FDVAR_PATCH_LCS_LIMIT
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <FDVar/CloneValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/JsonEqual.h>
+#include <FDVar/Path.h>
+
+namespace FDVar
+{
+    namespace detail
+    {
+        typedef DynamicVariable::StringType PatchStringType;
+        typedef DynamicVariable::StringViewType PatchStringViewType;
+        typedef DynamicVariable::SizeType PatchSizeType;
+
+        struct DiffTask
+        {
+            AbstractValue::Ptr source;
+            AbstractValue::Ptr target;
+            PatchStringType path;
+        };
+
+        inline PatchStringType patchLiteral(const char *text)
+        {
+            return PatchStringType(text, text + std::strlen(text));
+        }
+
+        inline void appendPointerIndex(PatchStringType &path, PatchSizeType index)
+        {
+            std::string digits = std::to_string(index);
+            path += '/';
+            path.append(digits.begin(), digits.end());
+        }
+
+        inline PatchSizeType parseArrayIndex(const PatchStringType &token,
+                                             PatchSizeType size,
+                                             bool append)
+        {
+            if(append && token.size() == 1 && token[0] == '-')
+            {
+                return size;
+            }
+
+            PatchSizeType index;
+            if(!parseIndexToken(token, index))
+            {
+                throw std::out_of_range("parseArrayIndex: invalid array index");
+            }
+
+            if(index > size || (!append && index == size))
+            {
+                throw std::out_of_range("parseArrayIndex: array index out of range");
+            }
+
+            return index;
+        }
+
+        inline const AbstractObjectValue &patchObject(const DynamicVariable &value)
+        {
+            return static_cast<const AbstractObjectValue &>(*value.internalValue());
+        }
+
+        inline DynamicVariable resolvePointer(const DynamicVariable &document,
+                                              const PointerType &tokens,
+                                              PatchSizeType count)
+        {
+            DynamicVariable current(document.internalValue());
+            for(PatchSizeType i = 0; i < count; ++i)
+            {
+                if(current.isType(ValueType::Object))
+                {
+                    if(!patchObject(current).contains(tokens[i]))
+                    {
+                        throw std::out_of_range("resolvePointer: member not found");
+                    }
+
+                    current = DynamicVariable(patchObject(current).get(tokens[i]));
+                }
+                else if(current.isType(ValueType::Array))
+                {
+                    current = current[parseArrayIndex(tokens[i], current.size(), false)];
+                }
+                else
+                {
+                    throw std::out_of_range("resolvePointer: cannot traverse a scalar value");
+                }
+            }
+
+            return current;
+        }
+
+        inline void addAt(DynamicVariable &document,
+                          const PointerType &tokens,
+                          const DynamicVariable &value)
+        {
+            if(tokens.empty())
+            {
+                document = value;
+                return;
+            }
+
+            DynamicVariable parent = resolvePointer(document, tokens, tokens.size() - 1);
+            if(parent.isType(ValueType::Object))
+            {
+                parent.set(tokens.back(), value);
+            }
+            else if(parent.isType(ValueType::Array))
+            {
+                PatchSizeType index = parseArrayIndex(tokens.back(), parent.size(), true);
+                if(index == parent.size())
+                {
+                    parent.push(value);
+                }
+                else
+                {
+                    parent.insert(value, index);
+                }
+            }
+            else
+            {
+                throw std::out_of_range("addAt: parent is not a container");
+            }
+        }
+
+        inline DynamicVariable removeAt(DynamicVariable &document, const PointerType &tokens)
+        {
+            if(tokens.empty())
+            {
+                DynamicVariable result = std::move(document);
+                document = DynamicVariable();
+                return result;
+            }
+
+            DynamicVariable parent = resolvePointer(document, tokens, tokens.size() - 1);
+            if(parent.isType(ValueType::Object))
+            {
+                if(!patchObject(parent).contains(tokens.back()))
+                {
+                    throw std::out_of_range("removeAt: member not found");
+                }
+
+                DynamicVariable result(patchObject(parent).get(tokens.back()));
+                parent.unset(tokens.back());
+                return result;
+            }
+
+            if(parent.isType(ValueType::Array))
+            {
+                return parent.removeAt(parseArrayIndex(tokens.back(), parent.size(), false));
+            }
+
+            throw std::out_of_range("removeAt: parent is not a container");
+        }
+
+        inline void replaceAt(DynamicVariable &document,
+                              const PointerType &tokens,
+                              const DynamicVariable &value)
+        {
+            if(tokens.empty())
+            {
+                document = value;
+                return;
+            }
+
+            DynamicVariable parent = resolvePointer(document, tokens, tokens.size() - 1);
+            if(parent.isType(ValueType::Object))
+            {
+                if(!patchObject(parent).contains(tokens.back()))
+                {
+                    throw std::out_of_range("replaceAt: member not found");
+                }
+
+                parent.set(tokens.back(), value);
+            }
+            else if(parent.isType(ValueType::Array))
+            {
+                parent.set(parseArrayIndex(tokens.back(), parent.size(), false), value);
+            }
+            else
+            {
+                throw std::out_of_range("replaceAt: parent is not a container");
+            }
+        }
+
+        inline DynamicVariable patchMember(const DynamicVariable &operation, const char *name)
+        {
+            PatchStringType key = patchLiteral(name);
+            if(!operation.isType(ValueType::Object) || !patchObject(operation).contains(key))
+            {
+                throw std::invalid_argument(std::string("apply: operation is missing '") + name +
+                                            "'");
+            }
+
+            return DynamicVariable(patchObject(operation).get(key));
+        }
+
+        inline PointerType patchPointer(const DynamicVariable &operation, const char *name)
+        {
+            DynamicVariable pointer = patchMember(operation, name);
+            if(!pointer.isType(ValueType::String))
+            {
+                throw std::invalid_argument(std::string("apply: '") + name +
+                                            "' must be a string");
+            }
+
+            return parsePointer(pointer.view());
+        }
+
+        inline void emitPatch(DynamicVariable &patch,
+                              const char *op,
+                              const PatchStringType &path,
+                              const AbstractValue::Ptr *value = nullptr)
+        {
+            DynamicVariable operation(ValueType::Object);
+            operation.set(patchLiteral("op"), DynamicVariable(patchLiteral(op)));
+            operation.set(patchLiteral("path"), DynamicVariable(path));
+            if(value != nullptr)
+            {
+                operation.set(patchLiteral("value"), DynamicVariable(*value));
+            }
+
+            patch.push(operation);
+        }
+
+        inline bool isPatchContainer(const AbstractValue::Ptr &value)
+        {
+            return value && (value->isType(ValueType::Array) || value->isType(ValueType::Object));
+        }
+
+        inline bool sameValue(const AbstractValue::Ptr &lhs, const AbstractValue::Ptr &rhs)
+        {
+            return lhs == rhs || DynamicVariable(lhs) == DynamicVariable(rhs);
+        }
+
+        inline void diffObjects(DynamicVariable &patch,
+                                std::vector<DiffTask> &pending,
+                                const DiffTask &task)
+        {
+            const auto &source = static_cast<const AbstractObjectValue &>(*task.source);
+            const auto &target = static_cast<const AbstractObjectValue &>(*task.target);
+            source.forEach([&](PatchStringViewType key, const AbstractValue::Ptr &value) {
+                PatchStringType path = task.path;
+                appendPointerToken(path, key);
+                if(!target.contains(key))
+                {
+                    emitPatch(patch, "remove", path);
+                    return;
+                }
+
+                AbstractValue::Ptr other = target.get(key);
+                if(value != other)
+                {
+                    pending.push_back(DiffTask { value, std::move(other), std::move(path) });
+                }
+            });
+
+            target.forEach([&](PatchStringViewType key, const AbstractValue::Ptr &value) {
+                if(!source.contains(key))
+                {
+                    PatchStringType path = task.path;
+                    appendPointerToken(path, key);
+                    emitPatch(patch, "add", path, &value);
+                }
+            });
+        }
+
+        inline void diffArrays(DynamicVariable &patch,
+                               std::vector<DiffTask> &pending,
+                               const DiffTask &task)
+        {
+            const auto &source = static_cast<const AbstractArrayValue &>(*task.source);
+            const auto &target = static_cast<const AbstractArrayValue &>(*task.target);
+            PatchSizeType sourceSize = source.size();
+            PatchSizeType targetSize = target.size();
+
+            PatchSizeType prefix = 0;
+            while(prefix < sourceSize && prefix < targetSize &&
+                  sameValue(source[prefix], target[prefix]))
+            {
+                ++prefix;
+            }
+
+            PatchSizeType suffix = 0;
+            while(suffix < sourceSize - prefix && suffix < targetSize - prefix &&
+                  sameValue(source[sourceSize - 1 - suffix], target[targetSize - 1 - suffix]))
+            {
+                ++suffix;
+            }
+
+            PatchSizeType rows = sourceSize - prefix - suffix;
+            PatchSizeType columns = targetSize - prefix - suffix;
+
+            // '=' keeps an element, '-' removes a source element, '+' inserts a target element.
+            std::vector<char> script;
+            script.reserve(rows + columns);
+            if(rows > 0 && columns > 0 && rows * columns <= FDVAR_PATCH_LCS_LIMIT)
+            {
+                std::vector<uint64_t> sourceHashes(rows);
+                std::vector<uint64_t> targetHashes(columns);
+                for(PatchSizeType i = 0; i < rows; ++i)
+                {
+                    sourceHashes[i] = DynamicVariable(source[prefix + i]).hash();
+                }
+
+                for(PatchSizeType j = 0; j < columns; ++j)
+                {
+                    targetHashes[j] = DynamicVariable(target[prefix + j]).hash();
+                }
+
+                auto equal = [&](PatchSizeType i, PatchSizeType j) {
+                    return sourceHashes[i] == targetHashes[j] &&
+                           sameValue(source[prefix + i], target[prefix + j]);
+                };
+
+                PatchSizeType width = columns + 1;
+                std::vector<uint32_t> lengths((rows + 1) * width, 0);
+                for(PatchSizeType i = rows; i-- > 0;)
+                {
+                    for(PatchSizeType j = columns; j-- > 0;)
+                    {
+                        lengths[i * width + j] =
+                          equal(i, j) ? lengths[(i + 1) * width + j + 1] + 1
+                                      : std::max(lengths[(i + 1) * width + j],
+                                                 lengths[i * width + j + 1]);
+                    }
+                }
+
+                PatchSizeType i = 0;
+                PatchSizeType j = 0;
+                while(i < rows && j < columns)
+                {
+                    if(lengths[i * width + j] == lengths[(i + 1) * width + j + 1] + 1 &&
+                       equal(i, j))
+                    {
+                        script.push_back('=');
+                        ++i;
+                        ++j;
+                    }
+                    else if(lengths[(i + 1) * width + j] >= lengths[i * width + j + 1])
+                    {
+                        script.push_back('-');
+                        ++i;
+                    }
+                    else
+                    {
+                        script.push_back('+');
+                        ++j;
+                    }
+                }
+
+                script.insert(script.end(), rows - i, '-');
+                script.insert(script.end(), columns - j, '+');
+            }
+            else
+            {
+                script.insert(script.end(), rows, '-');
+                script.insert(script.end(), columns, '+');
+            }
+
+            PatchSizeType position = prefix;
+            PatchSizeType sourceIndex = prefix;
+            PatchSizeType targetIndex = prefix;
+            for(PatchSizeType k = 0; k < script.size();)
+            {
+                if(script[k] == '=')
+                {
+                    ++position;
+                    ++sourceIndex;
+                    ++targetIndex;
+                    ++k;
+                    continue;
+                }
+
+                PatchSizeType removed = 0;
+                PatchSizeType inserted = 0;
+                for(; k < script.size() && script[k] != '='; ++k)
+                {
+                    ++(script[k] == '-' ? removed : inserted);
+                }
+
+                PatchSizeType paired = std::min(removed, inserted);
+                for(PatchSizeType n = 0; n < paired; ++n, ++position)
+                {
+                    PatchStringType path = task.path;
+                    appendPointerIndex(path, position);
+                    pending.push_back(DiffTask { source[sourceIndex + n],
+                                                 target[targetIndex + n],
+                                                 std::move(path) });
+                }
+
+                for(PatchSizeType n = paired; n < removed; ++n)
+                {
+                    PatchStringType path = task.path;
+                    appendPointerIndex(path, position);
+                    emitPatch(patch, "remove", path);
+                }
+
+                for(PatchSizeType n = paired; n < inserted; ++n, ++position)
+                {
+                    PatchStringType path = task.path;
+                    appendPointerIndex(path, position);
+                    emitPatch(patch, "add", path, &target[targetIndex + n]);
+                }
+
+                sourceIndex += removed;
+                targetIndex += inserted;
+            }
+        }
+    } // namespace detail
+
+    // Produces an RFC 6902 patch turning source into target. Subtrees shared by pointer are
+    // skipped; array edits use an LCS bounded by FDVAR_PATCH_LCS_LIMIT table cells.
+    inline DynamicVariable diff(const DynamicVariable &source, const DynamicVariable &target)
+    {
+        DynamicVariable patch(ValueType::Array);
+        std::vector<detail::DiffTask> pending;
+        pending.push_back(detail::DiffTask { source.internalValue(), target.internalValue(), {} });
+        while(!pending.empty())
+        {
+            detail::DiffTask task = std::move(pending.back());
+            pending.pop_back();
+            if(task.source == task.target)
+            {
+                continue;
+            }
+
+            if(detail::isPatchContainer(task.source) && task.target &&
+               task.source->getValueType() == task.target->getValueType())
+            {
+                if(task.source->isType(ValueType::Array))
+                {
+                    detail::diffArrays(patch, pending, task);
+                }
+                else
+                {
+                    detail::diffObjects(patch, pending, task);
+                }
+            }
+            else if(!detail::sameValue(task.source, task.target))
+            {
+                detail::emitPatch(patch, "replace", task.path, &task.target);
+            }
+        }
+
+        return patch;
+    }
+
+    // Applies an RFC 6902 patch in place. Operations are applied in order; when one fails,
+    // the ones before it stay applied.
+    inline void apply(DynamicVariable &document, const DynamicVariable &patch)
+    {
+        if(!patch.isType(ValueType::Array))
+        {
+            throw std::invalid_argument("apply: patch must be an array of operations");
+        }
+
+        for(DynamicVariable::SizeType i = 0, imax = patch.size(); i < imax; ++i)
+        {
+            DynamicVariable operation = patch[i];
+            DynamicVariable name = detail::patchMember(operation, "op");
+            detail::PointerType path = detail::patchPointer(operation, "path");
+            if(!name.isType(ValueType::String))
+            {
+                throw std::invalid_argument("apply: 'op' must be a string");
+            }
+
+            DynamicVariable::StringViewType op = name.view();
+            if(op == detail::patchLiteral("add"))
+            {
+                detail::addAt(
+                  document, path, detail::cloneValue(detail::patchMember(operation, "value")));
+            }
+            else if(op == detail::patchLiteral("remove"))
+            {
+                detail::removeAt(document, path);
+            }
+            else if(op == detail::patchLiteral("replace"))
+            {
+                detail::replaceAt(
+                  document, path, detail::cloneValue(detail::patchMember(operation, "value")));
+            }
+            else if(op == detail::patchLiteral("move"))
+            {
+                detail::PointerType from = detail::patchPointer(operation, "from");
+                if(from.size() < path.size() && std::equal(from.begin(), from.end(), path.begin()))
+                {
+                    throw std::invalid_argument("apply: cannot move a value into itself");
+                }
+
+                detail::addAt(document, path, detail::removeAt(document, from));
+            }
+            else if(op == detail::patchLiteral("copy"))
+            {
+                detail::PointerType from = detail::patchPointer(operation, "from");
+                detail::addAt(document,
+                              path,
+                              detail::cloneValue(
+                                detail::resolvePointer(document, from, from.size())));
+            }
+            else if(op == detail::patchLiteral("test"))
+            {
+                if(!json::equal(
+                     detail::resolvePointer(document, path, path.size()).internalValue(),
+                     detail::patchMember(operation, "value").internalValue()))
+                {
+                    throw std::invalid_argument("apply: test operation failed");
+                }
+            }
+            else
+            {
+                throw std::invalid_argument("apply: unknown operation");
+            }
+        }
+    }
+} // namespace FDVar
+
+#endif // FDVAR_PATCH_H
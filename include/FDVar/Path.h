@@ -0,0 +1,780 @@
+#ifndef FDVAR_PATH_H
+#define FDVAR_PATH_H
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/SmallFunction.h>
+
+namespace FDVar
+{
+    namespace detail
+    {
+        typedef std::vector<DynamicVariable::StringType> PointerType;
+
+        inline void appendPointerToken(DynamicVariable::StringType &path,
+                                       DynamicVariable::StringViewType token)
+        {
+            path += '/';
+            for(auto c: token)
+            {
+                if(c == '~')
+                {
+                    path += '~';
+                    path += '0';
+                }
+                else if(c == '/')
+                {
+                    path += '~';
+                    path += '1';
+                }
+                else
+                {
+                    path += c;
+                }
+            }
+        }
+
+        inline PointerType parsePointer(DynamicVariable::StringViewType pointer)
+        {
+            PointerType tokens;
+            if(pointer.empty())
+            {
+                return tokens;
+            }
+
+            if(pointer[0] != '/')
+            {
+                throw std::invalid_argument("parsePointer: pointer must start with '/'");
+            }
+
+            tokens.emplace_back();
+            for(DynamicVariable::SizeType i = 1; i < pointer.size(); ++i)
+            {
+                auto c = pointer[i];
+                if(c == '/')
+                {
+                    tokens.emplace_back();
+                }
+                else if(c == '~')
+                {
+                    if(i + 1 == pointer.size() || (pointer[i + 1] != '0' && pointer[i + 1] != '1'))
+                    {
+                        throw std::invalid_argument("parsePointer: invalid escape sequence");
+                    }
+
+                    tokens.back() += pointer[++i] == '0' ? '~' : '/';
+                }
+                else
+                {
+                    tokens.back() += c;
+                }
+            }
+
+            return tokens;
+        }
+
+        // Parses a canonical array index: digits only, no leading zeros.
+        inline bool parseIndexToken(DynamicVariable::StringViewType token,
+                                    DynamicVariable::SizeType &index)
+        {
+            if(token.empty() || token.size() > 18 || (token[0] == '0' && token.size() > 1))
+            {
+                return false;
+            }
+
+            index = 0;
+            for(auto c: token)
+            {
+                if(c < '0' || c > '9')
+                {
+                    return false;
+                }
+
+                index = index * 10 + static_cast<DynamicVariable::SizeType>(c - '0');
+            }
+
+            return true;
+        }
+    } // namespace detail
+
+    class Path
+    {
+      public:
+        typedef DynamicVariable::StringType StringType;
+        typedef DynamicVariable::StringViewType StringViewType;
+        typedef DynamicVariable::SizeType SizeType;
+        typedef SmallFunction<bool(const DynamicVariable &)> FilterType;
+
+      private:
+        enum class StepKind : uint8_t
+        {
+            Member,
+            Index,
+            Wildcard,
+            Filter
+        };
+
+        enum class Comparison : uint8_t
+        {
+            Exists,
+            Equal,
+            NotEqual,
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual
+        };
+
+        struct Step
+        {
+            StepKind kind;
+            StringType key;
+            SizeType index;
+            bool numeric;
+            bool fromEnd;
+            FilterType filter;
+        };
+
+        struct Branch
+        {
+            const AbstractValue::Ptr *slot;
+            AbstractValue::Ptr anchor;
+            SizeType step;
+        };
+
+        std::vector<Step> m_steps;
+        bool m_singular;
+
+      public:
+        Path() : m_singular(true) {}
+
+        static Path fromPointer(StringViewType pointer)
+        {
+            Path path;
+            for(auto &token: detail::parsePointer(pointer))
+            {
+                path.member(token);
+            }
+
+            return path;
+        }
+
+        // Accepts JSONPath ("$.a[0]['b'][*][?(@.c > 1)]") or, without a leading '$', JSON Pointer.
+        static Path parse(StringViewType expression)
+        {
+            if(expression.empty() || expression[0] != '$')
+            {
+                return fromPointer(expression);
+            }
+
+            Path path;
+            SizeType i = 1;
+            SizeType size = expression.size();
+            while(i < size)
+            {
+                auto c = expression[i];
+                if(c == '.')
+                {
+                    if(++i < size && expression[i] == '.')
+                    {
+                        throw std::invalid_argument(
+                          "Path::parse: recursive descent is not supported");
+                    }
+
+                    if(i < size && expression[i] == '*')
+                    {
+                        path.wildcard();
+                        ++i;
+                        continue;
+                    }
+
+                    SizeType start = i;
+                    while(i < size && expression[i] != '.' && expression[i] != '[')
+                    {
+                        ++i;
+                    }
+
+                    if(start == i)
+                    {
+                        throw std::invalid_argument("Path::parse: empty member name");
+                    }
+
+                    path.member(expression.substr(start, i - start));
+                }
+                else if(c == '[')
+                {
+                    i = path.parseBracket(expression, i + 1);
+                }
+                else
+                {
+                    throw std::invalid_argument("Path::parse: unexpected character");
+                }
+            }
+
+            return path;
+        }
+
+        Path &member(StringViewType key)
+        {
+            Step step { StepKind::Member, StringType(key), 0, false, false, {} };
+            step.numeric = detail::parseIndexToken(key, step.index);
+            m_steps.push_back(std::move(step));
+            return *this;
+        }
+
+        Path &index(SizeType pos)
+        {
+            m_steps.push_back(Step { StepKind::Index, {}, pos, true, false, {} });
+            return *this;
+        }
+
+        Path &fromEnd(SizeType pos)
+        {
+            m_steps.push_back(Step { StepKind::Index, {}, pos, true, true, {} });
+            return *this;
+        }
+
+        Path &wildcard()
+        {
+            m_singular = false;
+            m_steps.push_back(Step { StepKind::Wildcard, {}, 0, false, false, {} });
+            return *this;
+        }
+
+        // Selects the children of the current value that satisfy predicate.
+        Path &filter(FilterType predicate)
+        {
+            m_singular = false;
+            m_steps.push_back(Step { StepKind::Filter, {}, 0, false, false, std::move(predicate) });
+            return *this;
+        }
+
+        SizeType size() const { return m_steps.size(); }
+
+        bool isSingular() const { return m_singular; }
+
+        bool contains(const DynamicVariable &root) const
+        {
+            bool found = false;
+            walk(root.internalValue(), [&found](const AbstractValue::Ptr &) {
+                found = true;
+                return false;
+            });
+
+            return found;
+        }
+
+        DynamicVariable get(const DynamicVariable &root) const
+        {
+            AbstractValue::Ptr result;
+            if(!first(root.internalValue(), result))
+            {
+                throw std::out_of_range("Path::get: no value matches the path");
+            }
+
+            return DynamicVariable(std::move(result));
+        }
+
+        bool get(const DynamicVariable &root, DynamicVariable &result) const
+        {
+            AbstractValue::Ptr value;
+            if(!first(root.internalValue(), value))
+            {
+                return false;
+            }
+
+            result = DynamicVariable(std::move(value));
+            return true;
+        }
+
+        // Streams every match in document order; a visitor returning false stops the walk. The
+        // visitor must not add or remove elements of the containers being walked.
+        template<typename F>
+        void forEach(const DynamicVariable &root, F &&visitor) const
+        {
+            walk(root.internalValue(), [&visitor](const AbstractValue::Ptr &value) {
+                DynamicVariable match(value);
+                if constexpr(std::is_same_v<std::invoke_result_t<F &, DynamicVariable &>, bool>)
+                {
+                    return visitor(match);
+                }
+                else
+                {
+                    visitor(match);
+                    return true;
+                }
+            });
+        }
+
+        DynamicVariable select(const DynamicVariable &root) const
+        {
+            DynamicVariable result(ValueType::Array);
+            walk(root.internalValue(), [&result](const AbstractValue::Ptr &value) {
+                result.push(DynamicVariable(value));
+                return true;
+            });
+
+            return result;
+        }
+
+      private:
+        bool first(const AbstractValue::Ptr &root, AbstractValue::Ptr &result) const
+        {
+            bool found = false;
+            walk(root, [&](const AbstractValue::Ptr &value) {
+                result = value;
+                found = true;
+                return false;
+            });
+
+            return found;
+        }
+
+        template<typename F>
+        void walk(const AbstractValue::Ptr &root, F &&visitor) const
+        {
+            if(m_singular)
+            {
+                AbstractValue::Ptr holders[2];
+                const AbstractValue::Ptr *slot = &root;
+                for(SizeType step = 0; slot != nullptr && step < m_steps.size(); ++step)
+                {
+                    AbstractValue::Ptr &holder = holders[step % 2];
+                    slot = child(*slot, m_steps[step], holder);
+                }
+
+                if(slot != nullptr)
+                {
+                    visitor(*slot);
+                }
+
+                return;
+            }
+
+            // Each branch owns what keeps its slot alive: a null slot means the value is the
+            // anchor itself, otherwise slot points into the document or into the anchor. Values
+            // fetched along a branch are released once the branch is done.
+            std::vector<Branch> pending;
+            pending.push_back(Branch { &root, nullptr, 0 });
+            std::vector<Branch> children;
+            while(!pending.empty())
+            {
+                Branch branch = std::move(pending.back());
+                pending.pop_back();
+                AbstractValue::Ptr anchor = std::move(branch.anchor);
+                AbstractValue::Ptr holders[2];
+                SizeType used = 0;
+                const AbstractValue::Ptr *slot = branch.slot ? branch.slot : &anchor;
+                for(SizeType step = branch.step; slot != nullptr && step < m_steps.size(); ++step)
+                {
+                    const Step &current = m_steps[step];
+                    if(current.kind != StepKind::Wildcard && current.kind != StepKind::Filter)
+                    {
+                        AbstractValue::Ptr &holder = holders[used % 2];
+                        slot = child(*slot, current, holder);
+                        used += slot == &holder ? 1 : 0;
+                        continue;
+                    }
+
+                    children.clear();
+                    expand(*slot, !anchor && used == 0, step + 1, children);
+                    for(auto it = children.rbegin(); it != children.rend(); ++it)
+                    {
+                        if(current.kind == StepKind::Wildcard ||
+                           current.filter(DynamicVariable(it->slot ? *it->slot : it->anchor)))
+                        {
+                            pending.push_back(std::move(*it));
+                        }
+                    }
+
+                    slot = nullptr;
+                }
+
+                if(slot != nullptr && !visitor(*slot))
+                {
+                    return;
+                }
+            }
+        }
+
+        static const AbstractValue::Ptr *child(const AbstractValue::Ptr &node,
+                                               const Step &step,
+                                               AbstractValue::Ptr &holder)
+        {
+            if(!node)
+            {
+                return nullptr;
+            }
+
+            if(node->isType(ValueType::Object))
+            {
+                if(step.kind != StepKind::Member)
+                {
+                    return nullptr;
+                }
+
+                const auto &obj = static_cast<const AbstractObjectValue &>(*node);
+                if(const AbstractValue::Ptr *found = obj.find(step.key))
+                {
+                    return found;
+                }
+
+                if(!obj.contains(step.key))
+                {
+                    return nullptr;
+                }
+
+                AbstractValue::Ptr value = obj.get(step.key);
+                holder = std::move(value);
+                return &holder;
+            }
+
+            if(node->isType(ValueType::Array) && step.numeric)
+            {
+                const auto &arr = static_cast<const AbstractArrayValue &>(*node);
+                SizeType size = arr.size();
+                if(step.index >= size + (step.fromEnd ? 1 : 0) || (step.fromEnd && step.index == 0))
+                {
+                    return nullptr;
+                }
+
+                return &arr[step.fromEnd ? size - step.index : step.index];
+            }
+
+            return nullptr;
+        }
+
+        // stable is false when node lives in a temporary holder, in which case array children
+        // share ownership of node.
+        static void expand(const AbstractValue::Ptr &node,
+                           bool stable,
+                           SizeType step,
+                           std::vector<Branch> &children)
+        {
+            if(!node)
+            {
+                return;
+            }
+
+            if(node->isType(ValueType::Array))
+            {
+                const auto &arr = static_cast<const AbstractArrayValue &>(*node);
+                for(SizeType i = 0, imax = arr.size(); i < imax; ++i)
+                {
+                    children.push_back(Branch { &arr[i], stable ? nullptr : node, step });
+                }
+            }
+            else if(node->isType(ValueType::Object))
+            {
+                static_cast<const AbstractObjectValue &>(*node).forEach(
+                  [&](StringViewType, const AbstractValue::Ptr &value) {
+                      children.push_back(Branch { nullptr, value, step });
+                  });
+            }
+        }
+
+        SizeType parseBracket(StringViewType expression, SizeType i)
+        {
+            SizeType size = expression.size();
+            if(i >= size)
+            {
+                throw std::invalid_argument("Path::parse: unterminated '['");
+            }
+
+            auto c = expression[i];
+            SizeType end;
+            if(c == '*')
+            {
+                wildcard();
+                end = i + 1;
+            }
+            else if(c == '\'' || c == '"')
+            {
+                StringType key;
+                end = readQuoted(expression, i, key);
+                member(key);
+            }
+            else if(c == '?')
+            {
+                end = parseFilter(expression, i + 1);
+            }
+            else
+            {
+                bool negative = c == '-';
+                SizeType start = negative ? i + 1 : i;
+                end = start;
+                while(end < size && expression[end] != ']')
+                {
+                    ++end;
+                }
+
+                SizeType pos;
+                if(!detail::parseIndexToken(expression.substr(start, end - start), pos))
+                {
+                    throw std::invalid_argument("Path::parse: invalid array index");
+                }
+
+                if(negative)
+                {
+                    fromEnd(pos);
+                }
+                else
+                {
+                    index(pos);
+                }
+            }
+
+            if(end >= size || expression[end] != ']')
+            {
+                throw std::invalid_argument("Path::parse: expected ']'");
+            }
+
+            return end + 1;
+        }
+
+        static SizeType readQuoted(StringViewType expression, SizeType i, StringType &result)
+        {
+            auto quote = expression[i];
+            for(++i; i < expression.size() && expression[i] != quote; ++i)
+            {
+                if(expression[i] == '\\' && i + 1 < expression.size())
+                {
+                    ++i;
+                }
+
+                result += expression[i];
+            }
+
+            if(i >= expression.size())
+            {
+                throw std::invalid_argument("Path::parse: unterminated string");
+            }
+
+            return i + 1;
+        }
+
+        static void skipSpaces(StringViewType expression, SizeType &i)
+        {
+            while(i < expression.size() && expression[i] == ' ')
+            {
+                ++i;
+            }
+        }
+
+        SizeType parseFilter(StringViewType expression, SizeType i)
+        {
+            SizeType size = expression.size();
+            if(i + 1 >= size || expression[i] != '(' || expression[i + 1] != '@')
+            {
+                throw std::invalid_argument("Path::parse: filters must have the form ?(@...)");
+            }
+
+            SizeType start = i + 2;
+            SizeType end = start;
+            StringType scratch;
+            while(end < size && expression[end] != ' ' && expression[end] != ')' &&
+                  expression[end] != '=' && expression[end] != '!' && expression[end] != '<' &&
+                  expression[end] != '>')
+            {
+                bool quoted = expression[end] == '\'' || expression[end] == '"';
+                end = quoted ? readQuoted(expression, end, scratch) : end + 1;
+            }
+
+            StringType relative(1, '$');
+            relative.append(expression.substr(start, end - start));
+            Path subject = parse(relative);
+
+            i = end;
+            skipSpaces(expression, i);
+            Comparison comparison = Comparison::Exists;
+            DynamicVariable literal;
+            if(i < size && expression[i] != ')')
+            {
+                comparison = parseComparison(expression, i);
+                skipSpaces(expression, i);
+                i = parseLiteral(expression, i, literal);
+                skipSpaces(expression, i);
+            }
+
+            if(i >= size || expression[i] != ')')
+            {
+                throw std::invalid_argument("Path::parse: expected ')'");
+            }
+
+            filter([subject = std::move(subject), comparison, literal](
+                     const DynamicVariable &value) {
+                AbstractValue::Ptr found;
+                return subject.first(value.internalValue(), found) &&
+                       (comparison == Comparison::Exists ||
+                        matches(DynamicVariable(std::move(found)), comparison, literal));
+            });
+
+            return i + 1;
+        }
+
+        static Comparison parseComparison(StringViewType expression, SizeType &i)
+        {
+            auto first = expression[i];
+            bool equals = i + 1 < expression.size() && expression[i + 1] == '=';
+            i += equals ? 2 : 1;
+            switch(first)
+            {
+                case '=':
+                    if(equals)
+                    {
+                        return Comparison::Equal;
+                    }
+                    break;
+
+                case '!':
+                    if(equals)
+                    {
+                        return Comparison::NotEqual;
+                    }
+                    break;
+
+                case '<':
+                    return equals ? Comparison::LessEqual : Comparison::Less;
+
+                case '>':
+                    return equals ? Comparison::GreaterEqual : Comparison::Greater;
+
+                default:
+                    break;
+            }
+
+            throw std::invalid_argument("Path::parse: unknown comparison operator");
+        }
+
+        static SizeType parseLiteral(StringViewType expression,
+                                     SizeType i,
+                                     DynamicVariable &literal)
+        {
+            SizeType size = expression.size();
+            if(i < size && (expression[i] == '\'' || expression[i] == '"'))
+            {
+                StringType text;
+                i = readQuoted(expression, i, text);
+                literal = DynamicVariable(text);
+                return i;
+            }
+
+            SizeType start = i;
+            while(i < size && expression[i] != ' ' && expression[i] != ')')
+            {
+                ++i;
+            }
+
+            std::string token;
+            for(SizeType k = start; k < i; ++k)
+            {
+                token += static_cast<char>(expression[k]);
+            }
+
+            if(token == "true" || token == "false")
+            {
+                literal = DynamicVariable(token == "true");
+            }
+            else if(token == "null")
+            {
+                literal = DynamicVariable();
+            }
+            else
+            {
+                std::size_t used = 0;
+                try
+                {
+                    if(token.find_first_of(".eE") == std::string::npos)
+                    {
+                        literal = DynamicVariable(
+                          static_cast<DynamicVariable::IntType>(std::stoll(token, &used)));
+                    }
+                    else
+                    {
+                        literal = DynamicVariable(
+                          static_cast<DynamicVariable::FloatType>(std::stod(token, &used)));
+                    }
+                }
+                catch(const std::logic_error &)
+                {
+                    used = 0;
+                }
+
+                if(token.empty() || used != token.size())
+                {
+                    throw std::invalid_argument("Path::parse: invalid filter literal");
+                }
+            }
+
+            return i;
+        }
+
+        static bool isNumber(const DynamicVariable &value)
+        {
+            return value.isType(ValueType::Integer) || value.isType(ValueType::Float) ||
+                   value.isType(ValueType::BigInteger) || value.isType(ValueType::Decimal);
+        }
+
+        static bool isNaN(const DynamicVariable &value)
+        {
+            return value.isType(ValueType::Float) &&
+                   std::isnan(static_cast<DynamicVariable::FloatType>(value));
+        }
+
+        // Numbers compare exactly by value whatever their numeric types.
+        static bool matches(const DynamicVariable &value,
+                            Comparison comparison,
+                            const DynamicVariable &literal)
+        {
+            int order;
+            if(isNumber(value) && isNumber(literal))
+            {
+                if(isNaN(value) || isNaN(literal))
+                {
+                    return comparison == Comparison::NotEqual;
+                }
+
+                order = value.compareNumber(literal);
+            }
+            else if(value.isType(ValueType::String) && literal.isType(ValueType::String))
+            {
+                order = value.compare(literal);
+            }
+            else if(comparison == Comparison::Equal || comparison == Comparison::NotEqual)
+            {
+                return (comparison == Comparison::Equal) == (value == literal);
+            }
+            else
+            {
+                return false;
+            }
+
+            switch(comparison)
+            {
+                case Comparison::Equal:
+                    return order == 0;
+                case Comparison::NotEqual:
+                    return order != 0;
+                case Comparison::Less:
+                    return order < 0;
+                case Comparison::LessEqual:
+                    return order <= 0;
+                case Comparison::Greater:
+                    return order > 0;
+                case Comparison::GreaterEqual:
+                    return order >= 0;
+                default:
+                    return true;
+            }
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_PATH_H
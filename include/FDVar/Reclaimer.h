@@ -0,0 +1,210 @@
+#ifndef FDVAR_RECLAIMER_H
+#define FDVAR_RECLAIMER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+
+namespace FDVar
+{
+    class Reclaimer : public AbstractValue::ReleaseHandler
+    {
+      public:
+        typedef size_t SizeType;
+
+        enum class Policy : uint8_t
+        {
+            Block,
+            ReleaseInline
+        };
+
+        struct Stats
+        {
+            SizeType enqueued = 0;
+            SizeType reclaimed = 0;
+            SizeType releasedInline = 0;
+            SizeType blocked = 0;
+            SizeType queued = 0;
+            SizeType peakQueued = 0;
+        };
+
+      private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::condition_variable m_space;
+        std::condition_variable m_idle;
+        std::deque<std::vector<AbstractValue::Ptr>> m_queue;
+        SizeType m_capacity;
+        Policy m_policy;
+        Stats m_stats;
+        bool m_busy;
+        bool m_stop;
+        std::thread m_thread;
+
+      public:
+        explicit Reclaimer(SizeType capacity = 1 << 20, Policy policy = Policy::Block) :
+            m_capacity(capacity),
+            m_policy(policy),
+            m_busy(false),
+            m_stop(false),
+            m_thread([this]() { run(); })
+        {
+        }
+
+        Reclaimer(Reclaimer &&) = delete;
+        Reclaimer(const Reclaimer &) = delete;
+
+        // Threads that loaded this handler before it was uninstalled finish their defer() calls
+        // before the worker stops; the worker keeps draining, so a blocked caller gets room.
+        ~Reclaimer() override
+        {
+            disableAutomatic();
+            AbstractValue::drainReleases();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_condition.notify_one();
+            m_space.notify_all();
+            m_thread.join();
+        }
+
+        Reclaimer &operator=(Reclaimer &&) = delete;
+        Reclaimer &operator=(const Reclaimer &) = delete;
+
+        static Reclaimer &instance()
+        {
+            static Reclaimer reclaimer;
+            return reclaimer;
+        }
+
+        void enableAutomatic(SizeType threshold)
+        {
+            AbstractValue::setReleaseHandler(this, threshold);
+        }
+
+        void disableAutomatic()
+        {
+            if(AbstractValue::releaseHandler() == this)
+            {
+                AbstractValue::setReleaseHandler(nullptr, 0);
+            }
+        }
+
+        Stats stats()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stats;
+        }
+
+        bool defer(std::vector<AbstractValue::Ptr> &children) override
+        {
+            if(children.empty() || std::this_thread::get_id() == m_thread.get_id())
+            {
+                return false;
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if(m_stats.queued + children.size() > m_capacity && m_stats.queued != 0)
+                {
+                    if(m_policy == Policy::ReleaseInline || m_stop)
+                    {
+                        m_stats.releasedInline += children.size();
+                        return false;
+                    }
+
+                    ++m_stats.blocked;
+                    m_space.wait(lock, [this, &children]() {
+                        return m_stop || m_stats.queued == 0 ||
+                               m_stats.queued + children.size() <= m_capacity;
+                    });
+
+                    if(m_stop)
+                    {
+                        m_stats.releasedInline += children.size();
+                        return false;
+                    }
+                }
+
+                m_stats.enqueued += children.size();
+                m_stats.queued += children.size();
+                m_stats.peakQueued = std::max(m_stats.peakQueued, m_stats.queued);
+                m_queue.push_back(std::move(children));
+            }
+
+            children.clear();
+            m_condition.notify_one();
+            return true;
+        }
+
+        void reclaim(AbstractValue::Ptr value)
+        {
+            if(!value)
+            {
+                return;
+            }
+
+            std::vector<AbstractValue::Ptr> children;
+            children.push_back(std::move(value));
+            if(!defer(children))
+            {
+                AbstractValue::releaseChildren(children);
+            }
+        }
+
+        void reclaim(DynamicVariable &var)
+        {
+            AbstractValue::Ptr value = var.internalValue();
+            var = DynamicVariable();
+            reclaim(std::move(value));
+        }
+
+        void flush()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this]() { return m_queue.empty() && !m_busy; });
+        }
+
+      private:
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            for(;;)
+            {
+                m_condition.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+                if(m_queue.empty())
+                {
+                    return;
+                }
+
+                std::vector<AbstractValue::Ptr> pending = std::move(m_queue.front());
+                m_queue.pop_front();
+                SizeType count = pending.size();
+                m_busy = true;
+                lock.unlock();
+
+                AbstractValue::releaseChildren(pending);
+
+                lock.lock();
+                m_busy = false;
+                m_stats.queued -= count;
+                m_stats.reclaimed += count;
+                m_space.notify_all();
+                if(m_queue.empty())
+                {
+                    m_idle.notify_all();
+                }
+            }
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_RECLAIMER_H
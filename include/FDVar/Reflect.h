@@ -0,0 +1,490 @@
+#ifndef FDVAR_REFLECT_H
+#define FDVAR_REFLECT_H
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/JsonWriter.h>
+
+// FDVAR_REFLECT(Type, field...) lists the public data members of Type that take part in
+// conversion, in serialization order. Use it in the namespace that declares Type; at most 32
+// fields are supported.
+#define FDVAR_REFLECT(Type, ...)                                                                   \
+    constexpr auto fdvarReflect(const Type *)                                                      \
+    {                                                                                              \
+        return std::make_tuple(FDVAR_DETAIL_FIELDS(Type, __VA_ARGS__));                            \
+    }
+
+#define FDVAR_DETAIL_FIELD(Type, field)                                                            \
+    ::FDVar::reflect::Field<Type, decltype(Type::field)>                                           \
+    {                                                                                              \
+        #field, "\"" #field "\":", &Type::field                                                    \
+    }
+
+#define FDVAR_DETAIL_EXPAND(x) x
+#define FDVAR_DETAIL_CONCAT(a, b) FDVAR_DETAIL_CONCAT_I(a, b)
+#define FDVAR_DETAIL_CONCAT_I(a, b) a##b
+#define FDVAR_DETAIL_COUNT(...)                                                                    \
+    FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_COUNT_N(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23,  \
+                                             22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11,       \
+                                             10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define FDVAR_DETAIL_COUNT_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15,     \
+                             _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28,      \
+                             _29, _30, _31, _32, N, ...)                                           \
+    N
+#define FDVAR_DETAIL_FIELDS(Type, ...)                                                             \
+    FDVAR_DETAIL_EXPAND(                                                                           \
+      FDVAR_DETAIL_CONCAT(FDVAR_DETAIL_FIELDS_, FDVAR_DETAIL_COUNT(__VA_ARGS__))(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_1(Type, field) FDVAR_DETAIL_FIELD(Type, field)
+#define FDVAR_DETAIL_FIELDS_2(Type, field, ...)                                                    \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_1(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_3(Type, field, ...)                                                    \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_2(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_4(Type, field, ...)                                                    \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_3(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_5(Type, field, ...)                                                    \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_4(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_6(Type, field, ...)                                                    \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_5(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_7(Type, field, ...)                                                    \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_6(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_8(Type, field, ...)                                                    \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_7(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_9(Type, field, ...)                                                    \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_8(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_10(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_9(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_11(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_10(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_12(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_11(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_13(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_12(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_14(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_13(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_15(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_14(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_16(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_15(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_17(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_16(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_18(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_17(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_19(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_18(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_20(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_19(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_21(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_20(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_22(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_21(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_23(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_22(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_24(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_23(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_25(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_24(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_26(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_25(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_27(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_26(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_28(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_27(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_29(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_28(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_30(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_29(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_31(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_30(Type, __VA_ARGS__))
+#define FDVAR_DETAIL_FIELDS_32(Type, field, ...)                                                   \
+    FDVAR_DETAIL_FIELD(Type, field), FDVAR_DETAIL_EXPAND(FDVAR_DETAIL_FIELDS_31(Type, __VA_ARGS__))
+
+namespace FDVar
+{
+    namespace reflect
+    {
+        template<typename Class, typename Member>
+        struct Field
+        {
+            typedef Member MemberType;
+
+            std::string_view name;
+            std::string_view jsonKey;
+            Member Class::*pointer;
+        };
+    } // namespace reflect
+
+    template<typename T, typename U = void>
+    struct is_reflected
+    {
+        constexpr static bool value = false;
+    };
+
+    template<typename T>
+    struct is_reflected<T, std::void_t<decltype(fdvarReflect(static_cast<const T *>(nullptr)))>>
+    {
+        constexpr static bool value = true;
+    };
+
+    template<class T>
+    inline constexpr bool is_reflected_v = is_reflected<T>::value;
+
+    namespace reflect
+    {
+        template<typename T>
+        inline constexpr auto fields = fdvarReflect(static_cast<const T *>(nullptr));
+
+        template<typename T>
+        inline constexpr bool always_false = false;
+
+        template<typename T>
+        struct is_optional
+        {
+            constexpr static bool value = false;
+        };
+
+        template<typename T>
+        struct is_optional<std::optional<T>>
+        {
+            constexpr static bool value = true;
+        };
+
+        template<typename T, typename U = void>
+        struct is_sequence
+        {
+            constexpr static bool value = false;
+        };
+
+        template<typename T>
+        struct is_sequence<
+          T,
+          std::void_t<typename T::value_type,
+                      decltype(std::declval<const T &>().begin()),
+                      decltype(std::declval<T &>().push_back(
+                        std::declval<typename T::value_type>()))>>
+        {
+            constexpr static bool value = true;
+        };
+
+        template<typename T>
+        inline constexpr bool is_string_v =
+          std::is_convertible_v<const T &, DynamicVariable::StringViewType>;
+
+        // Whether an integer of type From is representable as To.
+        template<typename To, typename From>
+        constexpr bool inRange(From value)
+        {
+            typedef std::numeric_limits<To> Limits;
+            if constexpr(std::is_signed_v<From> && !std::is_signed_v<To>)
+            {
+                return value >= 0 &&
+                       static_cast<std::make_unsigned_t<From>>(value) <= Limits::max();
+            }
+            else if constexpr(!std::is_signed_v<From> && std::is_signed_v<To>)
+            {
+                return value <= static_cast<std::make_unsigned_t<To>>(Limits::max());
+            }
+            else if constexpr(std::is_signed_v<From>)
+            {
+                return value >= Limits::min() && value <= Limits::max();
+            }
+            else
+            {
+                return value <= Limits::max();
+            }
+        }
+
+        template<typename To, typename From>
+        To narrow(From value)
+        {
+            if(!inRange<To>(value))
+            {
+                throw std::out_of_range("reflect: integer does not fit the target type");
+            }
+
+            return static_cast<To>(value);
+        }
+
+        template<typename T>
+        DynamicVariable toValue(const T &value)
+        {
+            if constexpr(is_reflected_v<T>)
+            {
+                DynamicVariable::ObjectType members;
+                std::apply(
+                  [&](const auto &...field) {
+                      (members.emplace(DynamicVariable::StringType(field.name),
+                                       toValue(value.*field.pointer).internalValue()),
+                       ...);
+                  },
+                  fields<T>);
+                return DynamicVariable(std::move(members));
+            }
+            else if constexpr(std::is_same_v<T, DynamicVariable>)
+            {
+                return value;
+            }
+            else if constexpr(std::is_same_v<T, bool>)
+            {
+                return DynamicVariable(value);
+            }
+            else if constexpr(std::is_integral_v<T>)
+            {
+                return DynamicVariable(narrow<DynamicVariable::IntType>(value));
+            }
+            else if constexpr(std::is_floating_point_v<T>)
+            {
+                return DynamicVariable(static_cast<DynamicVariable::FloatType>(value));
+            }
+            else if constexpr(is_string_v<T>)
+            {
+                return DynamicVariable(DynamicVariable::StringViewType(value));
+            }
+            else if constexpr(is_optional<T>::value)
+            {
+                return value.has_value() ? toValue(*value) : DynamicVariable();
+            }
+            else if constexpr(is_sequence<T>::value)
+            {
+                DynamicVariable::ArrayType elements;
+                for(const auto &element: value)
+                {
+                    elements.push_back(toValue(element).internalValue());
+                }
+
+                return DynamicVariable(std::move(elements));
+            }
+            else
+            {
+                static_assert(always_false<T>, "type cannot be converted to DynamicVariable");
+            }
+        }
+
+        template<typename T>
+        bool fromValue(const DynamicVariable &source, T &target)
+        {
+            if constexpr(is_reflected_v<T>)
+            {
+                if(!source.isType(ValueType::Object))
+                {
+                    return false;
+                }
+
+                // Members missing from source keep their current value.
+                const auto &object =
+                  static_cast<const AbstractObjectValue &>(*source.internalValue());
+                bool success = true;
+                std::apply(
+                  [&](const auto &...field) {
+                      ((success = success && [&]() {
+                            DynamicVariable::StringType key(field.name);
+                            if(const AbstractValue::Ptr *member = object.find(key))
+                            {
+                                return fromValue(DynamicVariable(*member), target.*field.pointer);
+                            }
+
+                            return !object.contains(key) ||
+                                   fromValue(DynamicVariable(object.get(key)),
+                                             target.*field.pointer);
+                        }()),
+                       ...);
+                  },
+                  fields<T>);
+                return success;
+            }
+            else if constexpr(std::is_same_v<T, DynamicVariable>)
+            {
+                target = source;
+                return true;
+            }
+            else if constexpr(std::is_same_v<T, bool>)
+            {
+                if(!source.isType(ValueType::Boolean))
+                {
+                    return false;
+                }
+
+                target = static_cast<bool>(source);
+                return true;
+            }
+            else if constexpr(std::is_integral_v<T>)
+            {
+                if(!source.isType(ValueType::Integer))
+                {
+                    return false;
+                }
+
+                target = narrow<T>(static_cast<DynamicVariable::IntType>(source));
+                return true;
+            }
+            else if constexpr(std::is_floating_point_v<T>)
+            {
+                if(!source.isType(ValueType::Integer) && !source.isType(ValueType::Float))
+                {
+                    return false;
+                }
+
+                target = static_cast<T>(source);
+                return true;
+            }
+            else if constexpr(is_string_v<T>)
+            {
+                if(!source.isType(ValueType::String))
+                {
+                    return false;
+                }
+
+                target = T(source.view());
+                return true;
+            }
+            else if constexpr(is_optional<T>::value)
+            {
+                if(source.isType(ValueType::None))
+                {
+                    target.reset();
+                    return true;
+                }
+
+                typename T::value_type value {};
+                if(!fromValue(source, value))
+                {
+                    return false;
+                }
+
+                target = std::move(value);
+                return true;
+            }
+            else if constexpr(is_sequence<T>::value)
+            {
+                if(!source.isType(ValueType::Array))
+                {
+                    return false;
+                }
+
+                T result;
+                for(DynamicVariable::SizeType i = 0, imax = source.size(); i < imax; ++i)
+                {
+                    typename T::value_type value {};
+                    if(!fromValue(source[i], value))
+                    {
+                        return false;
+                    }
+
+                    result.push_back(std::move(value));
+                }
+
+                target = std::move(result);
+                return true;
+            }
+            else
+            {
+                static_assert(always_false<T>, "type cannot be converted from DynamicVariable");
+            }
+        }
+
+        template<typename T>
+        void write(JsonWriter &writer, const T &value)
+        {
+            if constexpr(is_reflected_v<T>)
+            {
+                writer.beginObject();
+                std::apply(
+                  [&](const auto &...field) {
+                      ((writer.rawKey(field.jsonKey), write(writer, value.*field.pointer)), ...);
+                  },
+                  fields<T>);
+                writer.endObject();
+            }
+            else if constexpr(std::is_same_v<T, DynamicVariable>)
+            {
+                writer.value(value);
+            }
+            else if constexpr(std::is_same_v<T, bool>)
+            {
+                writer.boolean(value);
+            }
+            else if constexpr(std::is_integral_v<T>)
+            {
+                writer.integer(value);
+            }
+            else if constexpr(std::is_floating_point_v<T>)
+            {
+                writer.number(value);
+            }
+            else if constexpr(is_string_v<T>)
+            {
+                writer.string(DynamicVariable::StringViewType(value));
+            }
+            else if constexpr(is_optional<T>::value)
+            {
+                if(value.has_value())
+                {
+                    write(writer, *value);
+                }
+                else
+                {
+                    writer.null();
+                }
+            }
+            else if constexpr(is_sequence<T>::value)
+            {
+                writer.beginArray();
+                for(const auto &element: value)
+                {
+                    write(writer, element);
+                }
+
+                writer.endArray();
+            }
+            else
+            {
+                static_assert(always_false<T>, "type cannot be written as JSON");
+            }
+        }
+    } // namespace reflect
+
+    // Throws std::out_of_range for an unsigned member above the IntType range.
+    template<typename T>
+    DynamicVariable toDynamicVariable(const std::enable_if_t<is_reflected_v<T>, T> &value)
+    {
+        return reflect::toValue(value);
+    }
+
+    // Fails when a member present in value has the wrong type; absent members keep their
+    // default. Throws std::out_of_range when an integer does not fit its member type.
+    template<typename T>
+    std::optional<std::enable_if_t<is_reflected_v<T>, T>> fromDynamicVariable(
+      const DynamicVariable &value)
+    {
+        T result {};
+        if(!reflect::fromValue(value, result))
+        {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    // Serializes straight from the struct, without building a DynamicVariable tree.
+    template<typename T>
+    std::enable_if_t<is_reflected_v<T>> writeJson(JsonWriter &writer, const T &value)
+    {
+        reflect::write(writer, value);
+    }
+
+    template<typename T>
+    std::enable_if_t<is_reflected_v<T>, JsonWriter::BufferType> toJson(const T &value)
+    {
+        JsonWriter writer;
+        reflect::write(writer, value);
+        return writer.release();
+    }
+} // namespace FDVar
+
+#endif // FDVAR_REFLECT_H
@@ -0,0 +1,1006 @@
+#ifndef FDVAR_SCHEMA_H
+#define FDVAR_SCHEMA_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/JsonEqual.h>
+#include <FDVar/Path.h>
+#include <FDVar/Utf8.h>
+
+namespace FDVar
+{
+    struct SchemaError
+    {
+        DynamicVariable::StringType path;
+        std::string message;
+    };
+
+    // Compiles a JSON Schema (draft 2019-09 subset) into a flat program of nodes with member keys
+    // and type masks resolved up front. Supported keywords: type, enum, const, minimum, maximum,
+    // exclusiveMinimum, exclusiveMaximum, multipleOf, minLength, maxLength, pattern, items,
+    // minItems, maxItems, uniqueItems, properties, required, additionalProperties, minProperties,
+    // maxProperties, allOf, anyOf, oneOf, not and local "#/..." $ref. Other keywords are ignored.
+    class Schema
+    {
+      public:
+        typedef DynamicVariable::StringType StringType;
+        typedef DynamicVariable::StringViewType StringViewType;
+        typedef DynamicVariable::SizeType SizeType;
+
+      private:
+        typedef uint32_t NodeIndex;
+        typedef std::basic_regex<StringType::value_type> RegexType;
+
+        static constexpr NodeIndex NO_NODE = std::numeric_limits<NodeIndex>::max();
+        static constexpr SizeType NO_LIMIT = std::numeric_limits<SizeType>::max();
+        static constexpr uint16_t ANY_TYPE = 0xFFFF;
+
+        enum Flag : uint16_t
+        {
+            Never = 1 << 0,
+            IntegralFloat = 1 << 1,
+            HasMinimum = 1 << 2,
+            HasMaximum = 1 << 3,
+            ExclusiveMinimum = 1 << 4,
+            ExclusiveMaximum = 1 << 5,
+            HasMultipleOf = 1 << 6,
+            UniqueItems = 1 << 7,
+            NoAdditional = 1 << 8,
+            HasEnum = 1 << 9,
+            HasConst = 1 << 10
+        };
+
+        struct Property
+        {
+            StringType key;
+            NodeIndex node;
+            bool required;
+        };
+
+        struct Node
+        {
+            uint16_t types = ANY_TYPE;
+            uint16_t flags = 0;
+            DynamicVariable minimum;
+            DynamicVariable maximum;
+            DynamicVariable multipleOf;
+            SizeType minLength = 0;
+            SizeType maxLength = NO_LIMIT;
+            SizeType minItems = 0;
+            SizeType maxItems = NO_LIMIT;
+            SizeType minProperties = 0;
+            SizeType maxProperties = NO_LIMIT;
+            std::shared_ptr<const RegexType> pattern;
+            std::vector<DynamicVariable> values;
+            DynamicVariable constant;
+            NodeIndex items = NO_NODE;
+            NodeIndex additional = NO_NODE;
+            NodeIndex negated = NO_NODE;
+            NodeIndex ref = NO_NODE;
+            std::vector<Property> properties;
+            std::vector<NodeIndex> allOf;
+            std::vector<NodeIndex> anyOf;
+            std::vector<NodeIndex> oneOf;
+        };
+
+        // Compiled schema objects by address; the pointer keeps members that an object only
+        // hands out through get() alive, so their address cannot be reused while compiling.
+        typedef std::unordered_map<const AbstractValue *, std::pair<NodeIndex, AbstractValue::Ptr>>
+          CompiledType;
+
+        struct Failure
+        {
+            std::string message;
+            std::vector<StringType> tokens;
+        };
+
+        std::vector<Node> m_nodes;
+
+      public:
+        Schema() : m_nodes(1) {}
+
+        explicit Schema(const DynamicVariable &schema)
+        {
+            CompiledType compiled;
+            compile(schema, schema, compiled);
+            rejectCycles();
+        }
+
+        SizeType size() const { return m_nodes.size(); }
+
+        bool validate(const DynamicVariable &value) const
+        {
+            return check(0, value.internalValue(), nullptr);
+        }
+
+        // Stops at the first violation and reports it with a JSON Pointer to the offending value.
+        bool validate(const DynamicVariable &value, SchemaError &error) const
+        {
+            Failure failure;
+            if(check(0, value.internalValue(), &failure))
+            {
+                return true;
+            }
+
+            error.path.clear();
+            for(auto token = failure.tokens.rbegin(); token != failure.tokens.rend(); ++token)
+            {
+                detail::appendPointerToken(error.path, *token);
+            }
+
+            error.message = std::move(failure.message);
+            return false;
+        }
+
+      private:
+        static uint16_t typeBit(ValueType type) { return 1 << static_cast<unsigned>(type); }
+
+        // Objects that do not keep their members as AbstractValue::Ptr hand them out through
+        // get(); the member is then stored in holder.
+        static const AbstractValue::Ptr *keyword(const AbstractObjectValue &schema,
+                                                 const char *name,
+                                                 AbstractValue::Ptr &holder)
+        {
+            StringType key(name, name + std::char_traits<char>::length(name));
+            if(const AbstractValue::Ptr *found = schema.find(key))
+            {
+                return found;
+            }
+
+            if(!schema.contains(key))
+            {
+                return nullptr;
+            }
+
+            holder = schema.get(key);
+            return &holder;
+        }
+
+        static DynamicVariable number(const AbstractValue::Ptr &value, const char *name)
+        {
+            if(!value || !json::isNumber(value->getValueType()))
+            {
+                throw std::invalid_argument(std::string("Schema: ") + name + " must be a number");
+            }
+
+            return DynamicVariable(value);
+        }
+
+        static unsigned scaleOf(const AbstractValue::Ptr &value)
+        {
+            return value->getValueType() == ValueType::Decimal
+                     ? static_cast<const DecimalValue &>(*value).scale()
+                     : 0;
+        }
+
+        // value * 10^scale for an Integer, BigInteger or Decimal of at most that scale.
+        static BigIntegerValue scaled(const AbstractValue::Ptr &value, unsigned scale)
+        {
+            BigIntegerValue result =
+              value->getValueType() == ValueType::Decimal
+                ? BigIntegerValue(static_cast<const DecimalValue &>(*value).coefficient())
+                : json::bigInteger(value);
+            for(unsigned i = scaleOf(value); i < scale; ++i)
+            {
+                result *= BigIntegerValue(10);
+            }
+
+            return result;
+        }
+
+        static SizeType count(const AbstractValue::Ptr &value, const char *name)
+        {
+            DynamicVariable var(value);
+            if(!var.isType(ValueType::Integer) || static_cast<DynamicVariable::IntType>(var) < 0)
+            {
+                throw std::invalid_argument(std::string("Schema: ") + name +
+                                            " must be a non-negative integer");
+            }
+
+            return static_cast<SizeType>(static_cast<DynamicVariable::IntType>(var));
+        }
+
+        static const AbstractArrayValue &array(const AbstractValue::Ptr &value, const char *name)
+        {
+            if(!value || value->getValueType() != ValueType::Array)
+            {
+                throw std::invalid_argument(std::string("Schema: ") + name + " must be an array");
+            }
+
+            return static_cast<const AbstractArrayValue &>(*value);
+        }
+
+        static uint16_t typeMask(StringViewType name, uint16_t &flags)
+        {
+            auto is = [name](const char *literal) {
+                return std::equal(name.begin(), name.end(), literal,
+                                  literal + std::char_traits<char>::length(literal));
+            };
+
+            if(is("null"))
+            {
+                return typeBit(ValueType::None);
+            }
+
+            if(is("boolean"))
+            {
+                return typeBit(ValueType::Boolean);
+            }
+
+            if(is("integer"))
+            {
+                flags |= IntegralFloat;
+                return typeBit(ValueType::Integer) | typeBit(ValueType::BigInteger);
+            }
+
+            if(is("number"))
+            {
+                return typeBit(ValueType::Integer) | typeBit(ValueType::BigInteger) |
+                       typeBit(ValueType::Float) | typeBit(ValueType::Decimal);
+            }
+
+            if(is("string"))
+            {
+                return typeBit(ValueType::String);
+            }
+
+            if(is("array"))
+            {
+                return typeBit(ValueType::Array);
+            }
+
+            if(is("object"))
+            {
+                return typeBit(ValueType::Object);
+            }
+
+            throw std::invalid_argument("Schema: unknown type name");
+        }
+
+        template<typename Properties>
+        static auto findProperty(Properties &properties, StringViewType key)
+        {
+            return std::lower_bound(
+              properties.begin(), properties.end(), key,
+              [](const Property &property, StringViewType name) { return property.key < name; });
+        }
+
+        NodeIndex compile(const DynamicVariable &schema,
+                          const DynamicVariable &root,
+                          CompiledType &compiled)
+        {
+            if(schema.isType(ValueType::Boolean))
+            {
+                m_nodes.emplace_back();
+                if(!static_cast<bool>(schema))
+                {
+                    m_nodes.back().flags |= Never;
+                }
+
+                return static_cast<NodeIndex>(m_nodes.size() - 1);
+            }
+
+            if(!schema.isType(ValueType::Object))
+            {
+                throw std::invalid_argument("Schema: a schema must be an object or a boolean");
+            }
+
+            auto known = compiled.find(schema.internalValue().get());
+            if(known != compiled.end())
+            {
+                return known->second.first;
+            }
+
+            // Registered before its children so that recursive $refs resolve to this node.
+            auto index = static_cast<NodeIndex>(m_nodes.size());
+            m_nodes.emplace_back();
+            compiled.emplace(schema.internalValue().get(),
+                             std::make_pair(index, schema.internalValue()));
+
+            const auto &object = static_cast<const AbstractObjectValue &>(*schema.internalValue());
+            auto sub = [&](const AbstractValue::Ptr &value) {
+                return compile(DynamicVariable(value), root, compiled);
+            };
+
+            Node node;
+            AbstractValue::Ptr holder;
+            if(auto *value = keyword(object, "$ref", holder))
+            {
+                DynamicVariable ref(*value);
+                if(!ref.isType(ValueType::String) || ref.view().empty() || ref.view()[0] != '#')
+                {
+                    throw std::invalid_argument("Schema: only local $ref values are supported");
+                }
+
+                DynamicVariable target = Path::fromPointer(ref.view().substr(1)).get(root);
+                node.ref = compile(target, root, compiled);
+            }
+
+            if(auto *value = keyword(object, "type", holder))
+            {
+                DynamicVariable type(*value);
+                node.types = 0;
+                if(type.isType(ValueType::String))
+                {
+                    node.types = typeMask(type.view(), node.flags);
+                }
+                else
+                {
+                    const auto &names = array(*value, "type");
+                    for(SizeType i = 0, imax = names.size(); i < imax; ++i)
+                    {
+                        DynamicVariable name(names[i]);
+                        if(!name.isType(ValueType::String))
+                        {
+                            throw std::invalid_argument("Schema: type names must be strings");
+                        }
+
+                        node.types |= typeMask(name.view(), node.flags);
+                    }
+                }
+
+                if(node.types & typeBit(ValueType::Float))
+                {
+                    node.flags &= ~IntegralFloat;
+                }
+            }
+
+            if(auto *value = keyword(object, "enum", holder))
+            {
+                const auto &values = array(*value, "enum");
+                node.flags |= HasEnum;
+                for(SizeType i = 0, imax = values.size(); i < imax; ++i)
+                {
+                    node.values.emplace_back(values[i]);
+                }
+            }
+
+            if(auto *value = keyword(object, "const", holder))
+            {
+                node.flags |= HasConst;
+                node.constant = DynamicVariable(*value);
+            }
+
+            if(auto *value = keyword(object, "minimum", holder))
+            {
+                node.flags |= HasMinimum;
+                node.minimum = number(*value, "minimum");
+            }
+
+            if(auto *value = keyword(object, "maximum", holder))
+            {
+                node.flags |= HasMaximum;
+                node.maximum = number(*value, "maximum");
+            }
+
+            if(auto *value = keyword(object, "exclusiveMinimum", holder))
+            {
+                if(DynamicVariable(*value).isType(ValueType::Boolean))
+                {
+                    node.flags |= static_cast<bool>(DynamicVariable(*value)) ? ExclusiveMinimum : 0;
+                }
+                else
+                {
+                    DynamicVariable bound = number(*value, "exclusiveMinimum");
+                    if(!(node.flags & HasMinimum) || bound.compareNumber(node.minimum) >= 0)
+                    {
+                        node.flags |= HasMinimum | ExclusiveMinimum;
+                        node.minimum = bound;
+                    }
+                }
+            }
+
+            if(auto *value = keyword(object, "exclusiveMaximum", holder))
+            {
+                if(DynamicVariable(*value).isType(ValueType::Boolean))
+                {
+                    node.flags |= static_cast<bool>(DynamicVariable(*value)) ? ExclusiveMaximum : 0;
+                }
+                else
+                {
+                    DynamicVariable bound = number(*value, "exclusiveMaximum");
+                    if(!(node.flags & HasMaximum) || bound.compareNumber(node.maximum) <= 0)
+                    {
+                        node.flags |= HasMaximum | ExclusiveMaximum;
+                        node.maximum = bound;
+                    }
+                }
+            }
+
+            if(auto *value = keyword(object, "multipleOf", holder))
+            {
+                node.multipleOf = number(*value, "multipleOf");
+                if(!(node.multipleOf.compareNumber(DynamicVariable(0)) > 0) ||
+                   std::isnan(json::number(node.multipleOf.internalValue())))
+                {
+                    throw std::invalid_argument("Schema: multipleOf must be positive");
+                }
+
+                node.flags |= HasMultipleOf;
+            }
+
+            if(auto *value = keyword(object, "minLength", holder))
+            {
+                node.minLength = count(*value, "minLength");
+            }
+
+            if(auto *value = keyword(object, "maxLength", holder))
+            {
+                node.maxLength = count(*value, "maxLength");
+            }
+
+            if(auto *value = keyword(object, "pattern", holder))
+            {
+                DynamicVariable pattern(*value);
+                if(!pattern.isType(ValueType::String))
+                {
+                    throw std::invalid_argument("Schema: pattern must be a string");
+                }
+
+                StringViewType source = pattern.view();
+                node.pattern = std::make_shared<const RegexType>(source.begin(), source.end());
+            }
+
+            if(auto *value = keyword(object, "items", holder))
+            {
+                if((*value)->getValueType() == ValueType::Array)
+                {
+                    throw std::invalid_argument("Schema: tuple items are not supported");
+                }
+
+                node.items = sub(*value);
+            }
+
+            if(auto *value = keyword(object, "minItems", holder))
+            {
+                node.minItems = count(*value, "minItems");
+            }
+
+            if(auto *value = keyword(object, "maxItems", holder))
+            {
+                node.maxItems = count(*value, "maxItems");
+            }
+
+            if(auto *value = keyword(object, "uniqueItems", holder))
+            {
+                node.flags |= static_cast<bool>(DynamicVariable(*value)) ? UniqueItems : 0;
+            }
+
+            if(auto *value = keyword(object, "properties", holder))
+            {
+                if((*value)->getValueType() != ValueType::Object)
+                {
+                    throw std::invalid_argument("Schema: properties must be an object");
+                }
+
+                static_cast<const AbstractObjectValue &>(**value).forEach(
+                  [&](StringViewType key, const AbstractValue::Ptr &member) {
+                      node.properties.push_back(Property { StringType(key), sub(member), false });
+                  });
+            }
+
+            std::sort(node.properties.begin(), node.properties.end(),
+                      [](const Property &lhs, const Property &rhs) { return lhs.key < rhs.key; });
+
+            if(auto *value = keyword(object, "required", holder))
+            {
+                const auto &names = array(*value, "required");
+                for(SizeType i = 0, imax = names.size(); i < imax; ++i)
+                {
+                    DynamicVariable name(names[i]);
+                    if(!name.isType(ValueType::String))
+                    {
+                        throw std::invalid_argument("Schema: required names must be strings");
+                    }
+
+                    auto where = findProperty(node.properties, name.view());
+                    if(where != node.properties.end() && where->key == name.view())
+                    {
+                        where->required = true;
+                    }
+                    else
+                    {
+                        node.properties.insert(
+                          where, Property { StringType(name.view()), NO_NODE, true });
+                    }
+                }
+            }
+
+            if(auto *value = keyword(object, "additionalProperties", holder))
+            {
+                if((*value)->getValueType() == ValueType::Boolean)
+                {
+                    node.flags |= static_cast<bool>(DynamicVariable(*value)) ? 0 : NoAdditional;
+                }
+                else
+                {
+                    node.additional = sub(*value);
+                }
+            }
+
+            if(auto *value = keyword(object, "minProperties", holder))
+            {
+                node.minProperties = count(*value, "minProperties");
+            }
+
+            if(auto *value = keyword(object, "maxProperties", holder))
+            {
+                node.maxProperties = count(*value, "maxProperties");
+            }
+
+            std::pair<const char *, std::vector<NodeIndex> Node::*> combinators[] = {
+                { "allOf", &Node::allOf }, { "anyOf", &Node::anyOf }, { "oneOf", &Node::oneOf }
+            };
+            for(auto &[name, list]: combinators)
+            {
+                if(auto *value = keyword(object, name, holder))
+                {
+                    const auto &schemas = array(*value, name);
+                    for(SizeType i = 0, imax = schemas.size(); i < imax; ++i)
+                    {
+                        (node.*list).push_back(sub(schemas[i]));
+                    }
+                }
+            }
+
+            if(auto *value = keyword(object, "not", holder))
+            {
+                node.negated = sub(*value);
+            }
+
+            m_nodes[index] = std::move(node);
+            return index;
+        }
+
+        // $ref, allOf, anyOf, oneOf and not check the same value again, so a cycle made only of
+        // them, such as {"$ref": "#"}, would never terminate. items and member schemas descend
+        // into the value and may recurse freely.
+        void rejectCycles() const
+        {
+            enum Mark : uint8_t
+            {
+                Unvisited,
+                Active,
+                Done
+            };
+
+            std::vector<Mark> marks(m_nodes.size(), Unvisited);
+            std::vector<std::pair<NodeIndex, std::vector<NodeIndex>>> stack;
+            auto successors = [this](NodeIndex index) {
+                const Node &node = m_nodes[index];
+                std::vector<NodeIndex> result(node.allOf);
+                result.insert(result.end(), node.anyOf.begin(), node.anyOf.end());
+                result.insert(result.end(), node.oneOf.begin(), node.oneOf.end());
+                for(NodeIndex single: { node.ref, node.negated })
+                {
+                    if(single != NO_NODE)
+                    {
+                        result.push_back(single);
+                    }
+                }
+
+                return result;
+            };
+
+            for(NodeIndex root = 0; root < m_nodes.size(); ++root)
+            {
+                if(marks[root] != Unvisited)
+                {
+                    continue;
+                }
+
+                marks[root] = Active;
+                stack.emplace_back(root, successors(root));
+                while(!stack.empty())
+                {
+                    auto &[index, next] = stack.back();
+                    if(next.empty())
+                    {
+                        marks[index] = Done;
+                        stack.pop_back();
+                        continue;
+                    }
+
+                    NodeIndex child = next.back();
+                    next.pop_back();
+                    if(marks[child] == Active)
+                    {
+                        throw std::invalid_argument(
+                          "Schema: $ref cycle that does not descend into the value");
+                    }
+
+                    if(marks[child] == Unvisited)
+                    {
+                        marks[child] = Active;
+                        stack.emplace_back(child, successors(child));
+                    }
+                }
+            }
+        }
+
+        static bool fail(Failure *failure, const char *message)
+        {
+            if(failure != nullptr)
+            {
+                failure->message = message;
+            }
+
+            return false;
+        }
+
+        static bool fail(Failure *failure, StringType token)
+        {
+            if(failure != nullptr)
+            {
+                failure->tokens.push_back(std::move(token));
+            }
+
+            return false;
+        }
+
+        bool check(NodeIndex index, const AbstractValue::Ptr &value, Failure *failure) const
+        {
+            const Node &node = m_nodes[index];
+            if(node.flags & Never)
+            {
+                return fail(failure, "no value is allowed here");
+            }
+
+            ValueType type = value ? value->getValueType() : ValueType::None;
+            if(!(node.types & typeBit(type)))
+            {
+                if(!(node.flags & IntegralFloat) || !isIntegral(value))
+                {
+                    return fail(failure, "value has the wrong type");
+                }
+            }
+
+            if(node.ref != NO_NODE && !check(node.ref, value, failure))
+            {
+                return false;
+            }
+
+            if(node.flags & HasEnum)
+            {
+                auto match = [&value](const DynamicVariable &allowed) {
+                    return json::equal(allowed.internalValue(), value);
+                };
+
+                if(std::none_of(node.values.begin(), node.values.end(), match))
+                {
+                    return fail(failure, "value is not one of the allowed values");
+                }
+            }
+
+            if((node.flags & HasConst) && !json::equal(node.constant.internalValue(), value))
+            {
+                return fail(failure, "value is not the const value");
+            }
+
+            switch(type)
+            {
+                case ValueType::Integer:
+                case ValueType::Float:
+                case ValueType::BigInteger:
+                case ValueType::Decimal:
+                    if(!checkNumber(node, value, failure))
+                    {
+                        return false;
+                    }
+
+                    break;
+
+                case ValueType::String:
+                    if(!checkString(node, static_cast<const StringValue &>(*value).view(), failure))
+                    {
+                        return false;
+                    }
+
+                    break;
+
+                case ValueType::Array:
+                    if(!checkArray(node, static_cast<const AbstractArrayValue &>(*value), failure))
+                    {
+                        return false;
+                    }
+
+                    break;
+
+                case ValueType::Object:
+                    if(!checkObject(
+                         node, static_cast<const AbstractObjectValue &>(*value), failure))
+                    {
+                        return false;
+                    }
+
+                    break;
+
+                default:
+                    break;
+            }
+
+            for(NodeIndex child: node.allOf)
+            {
+                if(!check(child, value, failure))
+                {
+                    return false;
+                }
+            }
+
+            if(!node.anyOf.empty() &&
+               std::none_of(node.anyOf.begin(), node.anyOf.end(),
+                            [&](NodeIndex child) { return check(child, value, nullptr); }))
+            {
+                return fail(failure, "value matches no schema in anyOf");
+            }
+
+            if(!node.oneOf.empty())
+            {
+                SizeType matches = 0;
+                for(auto child = node.oneOf.begin(); child != node.oneOf.end() && matches < 2;
+                    ++child)
+                {
+                    matches += check(*child, value, nullptr) ? 1 : 0;
+                }
+
+                if(matches != 1)
+                {
+                    return fail(failure, "value must match exactly one schema in oneOf");
+                }
+            }
+
+            if(node.negated != NO_NODE && check(node.negated, value, nullptr))
+            {
+                return fail(failure, "value matches the schema in not");
+            }
+
+            return true;
+        }
+
+        // A Float or Decimal without a fraction, which "integer" accepts.
+        static bool isIntegral(const AbstractValue::Ptr &value)
+        {
+            ValueType type = value ? value->getValueType() : ValueType::None;
+            if(type == ValueType::Decimal)
+            {
+                return static_cast<const DecimalValue &>(*value).normalized().scale() == 0;
+            }
+
+            return type == ValueType::Float &&
+                   std::trunc(json::number(value)) == json::number(value);
+        }
+
+        // Hash consistent with json::equal(): numbers hash by their double value and containers
+        // only by type and size, leaving the rest to json::equal().
+        static size_t uniqueHash(const AbstractValue::Ptr &value)
+        {
+            ValueType type = value ? value->getValueType() : ValueType::None;
+            if(json::isNumber(type))
+            {
+                return std::hash<double>()(json::number(value) + 0.0);
+            }
+
+            if(type == ValueType::Array || type == ValueType::Object)
+            {
+                return std::hash<SizeType>()(DynamicVariable(value).size()) ^
+                       static_cast<size_t>(type);
+            }
+
+            return std::hash<DynamicVariable>()(DynamicVariable(value));
+        }
+
+        // Bounds compare exactly whatever the numeric types; multipleOf is exact unless a Float
+        // is involved, where it allows for rounding.
+        static bool checkNumber(const Node &node, const AbstractValue::Ptr &value, Failure *failure)
+        {
+            DynamicVariable number(value);
+            if(node.flags & HasMinimum)
+            {
+                int order = number.compareNumber(node.minimum);
+                if(order < 0 || ((node.flags & ExclusiveMinimum) && order == 0))
+                {
+                    return fail(failure, "value is below the minimum");
+                }
+            }
+
+            if(node.flags & HasMaximum)
+            {
+                int order = number.compareNumber(node.maximum);
+                if(order > 0 || ((node.flags & ExclusiveMaximum) && order == 0))
+                {
+                    return fail(failure, "value is above the maximum");
+                }
+            }
+
+            if(node.flags & HasMultipleOf)
+            {
+                const AbstractValue::Ptr &divisor = node.multipleOf.internalValue();
+                bool multiple = false;
+                if(value->getValueType() == ValueType::Float ||
+                   divisor->getValueType() == ValueType::Float)
+                {
+                    double quotient = json::number(value) / json::number(divisor);
+                    multiple =
+                      std::abs(quotient - std::round(quotient)) <= 1e-9 * std::max(1.0, quotient);
+                }
+                else
+                {
+                    unsigned scale = std::max(scaleOf(value), scaleOf(divisor));
+                    multiple = (scaled(value, scale) % scaled(divisor, scale)).isZero();
+                }
+
+                if(!multiple)
+                {
+                    return fail(failure, "value is not a multiple of multipleOf");
+                }
+            }
+
+            return true;
+        }
+
+        static bool checkString(const Node &node, StringViewType value, Failure *failure)
+        {
+            if(node.minLength != 0 || node.maxLength != NO_LIMIT)
+            {
+                SizeType length = utf8::length(value);
+                if(length < node.minLength)
+                {
+                    return fail(failure, "string is shorter than minLength");
+                }
+
+                if(length > node.maxLength)
+                {
+                    return fail(failure, "string is longer than maxLength");
+                }
+            }
+
+            if(node.pattern && !std::regex_search(value.begin(), value.end(), *node.pattern))
+            {
+                return fail(failure, "string does not match pattern");
+            }
+
+            return true;
+        }
+
+        bool checkArray(const Node &node, const AbstractArrayValue &value, Failure *failure) const
+        {
+            SizeType size = value.size();
+            if(size < node.minItems)
+            {
+                return fail(failure, "array has fewer than minItems elements");
+            }
+
+            if(size > node.maxItems)
+            {
+                return fail(failure, "array has more than maxItems elements");
+            }
+
+            if(node.items != NO_NODE)
+            {
+                for(SizeType i = 0; i < size; ++i)
+                {
+                    if(!check(node.items, value[i], failure))
+                    {
+                        return fail(failure, indexToken(i));
+                    }
+                }
+            }
+
+            if(node.flags & UniqueItems)
+            {
+                std::unordered_multimap<size_t, SizeType> seen;
+                for(SizeType i = 0; i < size; ++i)
+                {
+                    size_t hash = uniqueHash(value[i]);
+                    auto matches = seen.equal_range(hash);
+                    for(auto it = matches.first; it != matches.second; ++it)
+                    {
+                        if(json::equal(value[it->second], value[i]))
+                        {
+                            fail(failure, "array elements are not unique");
+                            return fail(failure, indexToken(i));
+                        }
+                    }
+
+                    seen.emplace(hash, i);
+                }
+            }
+
+            return true;
+        }
+
+        bool checkObject(const Node &node, const AbstractObjectValue &value, Failure *failure) const
+        {
+            if(node.minProperties != 0 || node.maxProperties != NO_LIMIT)
+            {
+                SizeType size = value.size();
+                if(size < node.minProperties)
+                {
+                    return fail(failure, "object has fewer than minProperties members");
+                }
+
+                if(size > node.maxProperties)
+                {
+                    return fail(failure, "object has more than maxProperties members");
+                }
+            }
+
+            for(const Property &property: node.properties)
+            {
+                AbstractValue::Ptr holder;
+                const AbstractValue::Ptr *member = value.find(property.key);
+                if(member == nullptr && value.contains(property.key))
+                {
+                    holder = value.get(property.key);
+                    member = &holder;
+                }
+
+                if(member == nullptr)
+                {
+                    if(property.required)
+                    {
+                        fail(failure, "required member is missing");
+                        return fail(failure, property.key);
+                    }
+
+                    continue;
+                }
+
+                if(property.node != NO_NODE && !check(property.node, *member, failure))
+                {
+                    return fail(failure, property.key);
+                }
+            }
+
+            if(!(node.flags & NoAdditional) && node.additional == NO_NODE)
+            {
+                return true;
+            }
+
+            bool valid = true;
+            value.forEach([&](StringViewType key, const AbstractValue::Ptr &member) {
+                if(!valid)
+                {
+                    return;
+                }
+
+                auto where = findProperty(node.properties, key);
+                if(where != node.properties.end() && where->key == key && where->node != NO_NODE)
+                {
+                    return;
+                }
+
+                if(node.flags & NoAdditional)
+                {
+                    fail(failure, "member is not allowed by additionalProperties");
+                    valid = fail(failure, StringType(key));
+                }
+                else if(!check(node.additional, member, failure))
+                {
+                    valid = fail(failure, StringType(key));
+                }
+            });
+
+            return valid;
+        }
+
+        static StringType indexToken(SizeType index)
+        {
+            std::string digits = std::to_string(index);
+            return StringType(digits.begin(), digits.end());
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_SCHEMA_H
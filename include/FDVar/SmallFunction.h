@@ -0,0 +1,234 @@
+#ifndef FDVAR_SMALLFUNCTION_H
+#define FDVAR_SMALLFUNCTION_H
+
+#ifndef FDVAR_FUNCTION_BUFFER_SIZE
+    #define FDVAR_FUNCTION_BUFFER_SIZE 48
+#endif // FDVAR_FUNCTION_BUFFER_SIZE
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace FDVar
+{
+    template<typename Signature, size_t BufferSize = FDVAR_FUNCTION_BUFFER_SIZE>
+    class SmallFunction;
+
+    template<typename R, typename... Args, size_t BufferSize>
+    class SmallFunction<R(Args...), BufferSize>
+    {
+      private:
+        enum class Operation : uint8_t
+        {
+            Copy,
+            Move,
+            Destroy
+        };
+
+        typedef R (*InvokeType)(void *, Args &&...);
+        typedef void (*ManageType)(Operation, void *, void *);
+
+        template<typename F>
+        static constexpr bool isInline = sizeof(F) <= BufferSize &&
+                                         alignof(F) <= alignof(std::max_align_t) &&
+                                         std::is_nothrow_move_constructible_v<F>;
+
+        alignas(std::max_align_t) unsigned char m_buffer[BufferSize];
+        InvokeType m_invoke;
+        ManageType m_manage;
+
+      public:
+        SmallFunction() noexcept : m_invoke(nullptr), m_manage(nullptr) {}
+        SmallFunction(std::nullptr_t) noexcept : SmallFunction() {}
+
+        SmallFunction(SmallFunction &&other) noexcept : SmallFunction() { moveFrom(other); }
+
+        SmallFunction(const SmallFunction &other) : SmallFunction()
+        {
+            if(other.m_manage != nullptr)
+            {
+                other.m_manage(Operation::Copy, m_buffer,
+                               const_cast<unsigned char *>(other.m_buffer));
+                m_invoke = other.m_invoke;
+                m_manage = other.m_manage;
+            }
+        }
+
+        template<typename F,
+                 typename U = std::enable_if_t<
+                   !std::is_same_v<std::decay_t<F>, SmallFunction> &&
+                     std::is_invocable_r_v<R, std::decay_t<F> &, Args...>,
+                   F>>
+        SmallFunction(F &&func) : SmallFunction()
+        {
+            typedef std::decay_t<F> FunctionType;
+            if(isNull(func))
+            {
+                return;
+            }
+
+            if constexpr(isInline<FunctionType>)
+            {
+                ::new(static_cast<void *>(m_buffer)) FunctionType(std::forward<F>(func));
+            }
+            else
+            {
+                *reinterpret_cast<FunctionType **>(m_buffer) =
+                  new FunctionType(std::forward<F>(func));
+            }
+
+            m_invoke = &invoke<FunctionType>;
+            m_manage = &manage<FunctionType>;
+        }
+
+        ~SmallFunction() { reset(); }
+
+        SmallFunction &operator=(SmallFunction &&other) noexcept
+        {
+            if(this != &other)
+            {
+                reset();
+                moveFrom(other);
+            }
+
+            return *this;
+        }
+
+        SmallFunction &operator=(const SmallFunction &other)
+        {
+            if(this != &other)
+            {
+                SmallFunction tmp(other);
+                *this = std::move(tmp);
+            }
+
+            return *this;
+        }
+
+        SmallFunction &operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        explicit operator bool() const noexcept { return m_invoke != nullptr; }
+        bool operator!() const noexcept { return m_invoke == nullptr; }
+
+        R operator()(Args... args) const
+        {
+            if(m_invoke == nullptr)
+            {
+                throw std::bad_function_call();
+            }
+
+            return m_invoke(const_cast<unsigned char *>(m_buffer), std::forward<Args>(args)...);
+        }
+
+        void reset() noexcept
+        {
+            if(m_manage != nullptr)
+            {
+                m_manage(Operation::Destroy, m_buffer, nullptr);
+                m_invoke = nullptr;
+                m_manage = nullptr;
+            }
+        }
+
+      private:
+        void moveFrom(SmallFunction &other) noexcept
+        {
+            if(other.m_manage != nullptr)
+            {
+                other.m_manage(Operation::Move, m_buffer, other.m_buffer);
+                m_invoke = other.m_invoke;
+                m_manage = other.m_manage;
+                other.m_invoke = nullptr;
+                other.m_manage = nullptr;
+            }
+        }
+
+        template<typename F>
+        static bool isNull(const F &func)
+        {
+            if constexpr(std::is_pointer_v<F> || std::is_member_pointer_v<F>)
+            {
+                return func == nullptr;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        template<typename Signature>
+        static bool isNull(const std::function<Signature> &func)
+        {
+            return !func;
+        }
+
+        template<typename F>
+        static F *target(void *storage)
+        {
+            if constexpr(isInline<F>)
+            {
+                return std::launder(reinterpret_cast<F *>(storage));
+            }
+            else
+            {
+                return *reinterpret_cast<F **>(storage);
+            }
+        }
+
+        template<typename F>
+        static R invoke(void *storage, Args &&...args)
+        {
+            return std::invoke(*target<F>(storage), std::forward<Args>(args)...);
+        }
+
+        template<typename F>
+        static void manage(Operation operation, void *destination, void *source)
+        {
+            switch(operation)
+            {
+                case Operation::Copy:
+                    if constexpr(isInline<F>)
+                    {
+                        ::new(destination) F(*target<F>(source));
+                    }
+                    else
+                    {
+                        *reinterpret_cast<F **>(destination) = new F(*target<F>(source));
+                    }
+                    break;
+
+                case Operation::Move:
+                    if constexpr(isInline<F>)
+                    {
+                        ::new(destination) F(std::move(*target<F>(source)));
+                        target<F>(source)->~F();
+                    }
+                    else
+                    {
+                        *reinterpret_cast<F **>(destination) = *reinterpret_cast<F **>(source);
+                    }
+                    break;
+
+                case Operation::Destroy:
+                    if constexpr(isInline<F>)
+                    {
+                        target<F>(destination)->~F();
+                    }
+                    else
+                    {
+                        delete target<F>(destination);
+                    }
+                    break;
+            }
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_SMALLFUNCTION_H
@@ -13,7 +13,27 @@
     #endif // FDVAR_USE_WIDE_STRING
 #endif     // FDVAR_STRING_TYPE
 
+#ifndef FDVAR_STRING_ROPE_THRESHOLD
+    #define FDVAR_STRING_ROPE_THRESHOLD 4096
+#endif // FDVAR_STRING_ROPE_THRESHOLD
+
+#ifndef FDVAR_STRING_ROPE_CHUNK_SIZE
+    #define FDVAR_STRING_ROPE_CHUNK_SIZE 1024
+#endif // FDVAR_STRING_ROPE_CHUNK_SIZE
+
+#ifndef FDVAR_STRING_SLICE_THRESHOLD
+    #define FDVAR_STRING_SLICE_THRESHOLD 32
+#endif // FDVAR_STRING_SLICE_THRESHOLD
+
 #include <FDVar/AbstractValue.h>
+#include <FDVar/Hash.h>
+#include <FDVar/Utf8.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <utility>
 
 namespace FDVar
@@ -26,62 +46,506 @@ namespace FDVar
         typedef size_t SizeType;
 
       private:
-        StringType m_value;
+        struct RopeNode
+        {
+            std::shared_ptr<RopeNode> prefix;
+            StringType chunk;
+            SizeType size;
+
+            RopeNode(std::shared_ptr<RopeNode> prefix, StringType chunk) :
+                prefix(std::move(prefix)),
+                chunk(std::move(chunk)),
+                size((this->prefix ? this->prefix->size : 0) + this->chunk.size())
+            {
+            }
+
+            RopeNode(RopeNode &&) = delete;
+            RopeNode(const RopeNode &) = delete;
+
+            ~RopeNode()
+            {
+                std::shared_ptr<RopeNode> next = std::move(prefix);
+                while(next && next.use_count() == 1)
+                {
+                    std::shared_ptr<RopeNode> tmp = std::move(next->prefix);
+                    next = std::move(tmp);
+                }
+            }
+
+            RopeNode &operator=(RopeNode &&) = delete;
+            RopeNode &operator=(const RopeNode &) = delete;
+        };
+
+        mutable StringType m_value;
+        std::shared_ptr<RopeNode> m_rope;
+        std::shared_ptr<StringType> m_buffer;
+        SizeType m_offset;
+        SizeType m_length;
+        mutable std::atomic<bool> m_pending;
+        mutable std::shared_ptr<const utf8::Index> m_index;
+        mutable std::atomic<bool> m_indexed;
+        mutable std::atomic<uint64_t> m_hash;
 
       public:
-        StringValue() = default;
-        StringValue(StringValue &&) = default;
-        StringValue(const StringValue &) = default;
-        explicit StringValue(StringViewType value) : m_value(value) {}
+        StringValue() : m_offset(0), m_length(0), m_pending(false), m_indexed(false), m_hash(0) {}
+
+        StringValue(StringValue &&other) noexcept :
+            m_value(std::move(other.m_value)),
+            m_rope(std::move(other.m_rope)),
+            m_buffer(std::move(other.m_buffer)),
+            m_offset(other.m_offset),
+            m_length(other.m_length),
+            m_pending(other.m_pending.load(std::memory_order_acquire)),
+            m_index(std::move(other.m_index)),
+            m_indexed(other.m_indexed.load(std::memory_order_acquire)),
+            m_hash(other.m_hash.load(std::memory_order_relaxed))
+        {
+            other.m_pending.store(false, std::memory_order_relaxed);
+            other.m_indexed.store(false, std::memory_order_relaxed);
+            other.m_hash.store(0, std::memory_order_relaxed);
+        }
+
+        StringValue(const StringValue &other) :
+            m_rope(other.m_rope),
+            m_buffer(other.m_buffer),
+            m_offset(other.m_offset),
+            m_length(other.m_length),
+            m_pending(m_rope || m_buffer),
+            m_indexed(other.m_indexed.load(std::memory_order_acquire)),
+            m_hash(other.m_hash.load(std::memory_order_relaxed))
+        {
+            if(!m_pending.load(std::memory_order_relaxed))
+            {
+                m_value = other.m_value;
+            }
+
+            if(m_indexed.load(std::memory_order_relaxed))
+            {
+                m_index = other.m_index;
+            }
+        }
+
+        explicit StringValue(StringViewType value) :
+            m_value(value),
+            m_offset(0),
+            m_length(0),
+            m_pending(false),
+            m_indexed(false),
+            m_hash(0)
+        {
+        }
 
         ~StringValue() noexcept override = default;
 
         ValueType getValueType() const override { return ValueType::String; }
 
-        StringValue &operator=(StringValue &&) = default;
-        StringValue &operator=(const StringValue &) = default;
+        StringValue &operator=(StringValue &&other) noexcept
+        {
+            m_value = std::move(other.m_value);
+            m_rope = std::move(other.m_rope);
+            m_buffer = std::move(other.m_buffer);
+            m_offset = other.m_offset;
+            m_length = other.m_length;
+            m_pending.store(other.m_pending.load(std::memory_order_acquire),
+                            std::memory_order_relaxed);
+            m_index = std::move(other.m_index);
+            m_indexed.store(other.m_indexed.load(std::memory_order_acquire),
+                            std::memory_order_relaxed);
+            m_hash.store(other.m_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other.m_pending.store(false, std::memory_order_relaxed);
+            other.m_indexed.store(false, std::memory_order_relaxed);
+            other.m_hash.store(0, std::memory_order_relaxed);
+            return *this;
+        }
+
+        StringValue &operator=(const StringValue &other)
+        {
+            if(this != &other)
+            {
+                StringValue tmp(other);
+                *this = std::move(tmp);
+            }
+
+            return *this;
+        }
 
-        explicit operator const StringType &() const { return m_value; }
-        explicit operator StringViewType() const { return m_value; }
+        explicit operator const StringType &() const { return flat(); }
+        explicit operator StringViewType() const { return view(); }
 
         StringValue &operator=(StringViewType value)
         {
-            m_value = value;
+            m_value.assign(value.data(), value.size());
+            m_rope.reset();
+            m_buffer.reset();
+            m_pending.store(false, std::memory_order_relaxed);
+            invalidateCache();
             return *this;
         }
 
-        bool operator==(const StringValue &value) const { return m_value == value.m_value; }
+        bool operator==(const StringValue &value) const
+        {
+            if(size() != value.size())
+            {
+                return false;
+            }
+
+            uint64_t lhsHash = m_hash.load(std::memory_order_relaxed);
+            uint64_t rhsHash = value.m_hash.load(std::memory_order_relaxed);
+            if(lhsHash != 0 && rhsHash != 0 && lhsHash != rhsHash)
+            {
+                return false;
+            }
+
+            return view() == value.view();
+        }
 
-        bool operator==(StringViewType value) const { return m_value == value; }
+        bool operator==(StringViewType value) const { return view() == value; }
 
-        bool operator!=(const StringValue &value) const { return m_value != value.m_value; }
+        bool operator!=(const StringValue &value) const { return !(*this == value); }
 
-        bool operator!=(const StringType &value) const { return m_value != value; }
+        bool operator!=(const StringType &value) const { return view() != value; }
 
         StringValue &operator+=(StringViewType value)
         {
-            m_value += value;
+            append(value);
             return *this;
         }
 
         StringValue operator+(StringViewType value) const
         {
-            return StringValue(m_value + value.data());
+            StringValue result;
+            StringViewType current = m_rope ? StringViewType() : view();
+            if(!m_rope && current.size() + value.size() < FDVAR_STRING_ROPE_THRESHOLD)
+            {
+                result.m_value.reserve(current.size() + value.size());
+                result.m_value.append(current);
+                result.m_value.append(value);
+                return result;
+            }
+
+            std::shared_ptr<RopeNode> base =
+              m_rope ? m_rope : std::make_shared<RopeNode>(nullptr, StringType(current));
+            if(base->prefix && base->chunk.size() + value.size() <= FDVAR_STRING_ROPE_CHUNK_SIZE)
+            {
+                StringType chunk;
+                chunk.reserve(base->chunk.size() + value.size());
+                chunk.append(base->chunk);
+                chunk.append(value);
+                result.m_rope = std::make_shared<RopeNode>(base->prefix, std::move(chunk));
+            }
+            else
+            {
+                result.m_rope = std::make_shared<RopeNode>(std::move(base), StringType(value));
+            }
+
+            result.m_pending.store(true, std::memory_order_relaxed);
+            return result;
         }
 
-        SizeType size() const { return m_value.size(); }
-        bool isEmpty() const { return m_value.empty(); }
+        SizeType size() const
+        {
+            return m_rope ? m_rope->size : (m_buffer ? m_length : m_value.size());
+        }
 
-        StringType::value_type &operator[](size_t pos) { return m_value[pos]; }
+        bool isEmpty() const { return size() == 0; }
 
-        const StringType::value_type &operator[](size_t pos) const { return m_value[pos]; }
+        StringViewType view() const
+        {
+            if(!m_rope && m_buffer)
+            {
+                return StringViewType(m_buffer->data() + m_offset, m_length);
+            }
+
+            return flat();
+        }
+
+        StringType::value_type &operator[](size_t pos)
+        {
+            materialize();
+            invalidateCache();
+            return m_value[pos];
+        }
 
-        void clear() { m_value.clear(); }
+        const StringType::value_type &operator[](size_t pos) const { return view()[pos]; }
+
+        void clear()
+        {
+            m_value.clear();
+            m_rope.reset();
+            m_buffer.reset();
+            m_pending.store(false, std::memory_order_relaxed);
+            invalidateCache();
+        }
+
+        void append(StringViewType str)
+        {
+            invalidateCache();
+            if(m_buffer)
+            {
+                materialize();
+            }
+
+            if(!m_rope)
+            {
+                if(m_value.size() + str.size() < FDVAR_STRING_ROPE_THRESHOLD)
+                {
+                    m_value.append(str);
+                    return;
+                }
+
+                m_rope = std::make_shared<RopeNode>(nullptr, std::move(m_value));
+            }
+
+            if(m_rope.use_count() == 1 && m_rope->prefix &&
+               m_rope->chunk.size() < FDVAR_STRING_ROPE_CHUNK_SIZE)
+            {
+                m_rope->chunk.append(str);
+                m_rope->size += str.size();
+            }
+            else
+            {
+                m_rope = std::make_shared<RopeNode>(std::move(m_rope), StringType(str));
+            }
+
+            m_value = StringType();
+            m_pending.store(true, std::memory_order_relaxed);
+        }
 
-        void append(StringViewType str) { m_value.append(str); }
         StringValue subString(SizeType from, SizeType count)
         {
-            return StringValue(m_value.substr(from, count));
+            count = checkRange(from, count);
+            if(count >= FDVAR_STRING_SLICE_THRESHOLD && !m_buffer)
+            {
+                materialize();
+                m_buffer = std::make_shared<StringType>(std::move(m_value));
+                m_value = StringType();
+                m_offset = 0;
+                m_length = m_buffer->size();
+                m_pending.store(true, std::memory_order_relaxed);
+            }
+
+            return static_cast<const StringValue &>(*this).subString(from, count);
+        }
+
+        StringValue subString(SizeType from, SizeType count) const
+        {
+            count = checkRange(from, count);
+            if(count < FDVAR_STRING_SLICE_THRESHOLD || m_rope || !m_buffer)
+            {
+                return StringValue(view().substr(from, count));
+            }
+
+            StringValue result;
+            result.m_buffer = m_buffer;
+            result.m_offset = m_offset + from;
+            result.m_length = count;
+            result.m_pending.store(true, std::memory_order_relaxed);
+            return result;
+        }
+
+        static StringValue fromUtf8(StringViewType value)
+        {
+            if(!utf8::isValid(value))
+            {
+                throw std::invalid_argument("fromUtf8: invalid UTF-8 sequence");
+            }
+
+            StringValue result(value);
+            result.m_index = std::make_shared<const utf8::Index>(value);
+            result.m_indexed.store(true, std::memory_order_relaxed);
+            return result;
+        }
+
+        uint64_t hash() const
+        {
+            uint64_t result = m_hash.load(std::memory_order_relaxed);
+            if(result == 0)
+            {
+                StringViewType str = view();
+                result = hash::bytes(str.data(), str.size() * sizeof(StringType::value_type));
+                result += result == 0 ? 1 : 0;
+                m_hash.store(result, std::memory_order_relaxed);
+            }
+
+            return result;
+        }
+
+        bool isValidUtf8() const { return index().isValid(); }
+
+        SizeType length() const { return validIndex(__func__).length(); }
+
+        StringViewType charAt(SizeType pos) const
+        {
+            StringViewType str = view();
+            const utf8::Index &index = validIndex(__func__);
+            if(pos >= index.length())
+            {
+                throw std::out_of_range("charAt: position out of range");
+            }
+
+            SizeType offset = index.offset(str, pos);
+            return str.substr(offset, utf8::sequenceLength(str[offset]));
+        }
+
+        uint32_t codePointAt(SizeType pos) const
+        {
+            StringViewType str = view();
+            const utf8::Index &index = validIndex(__func__);
+            if(pos >= index.length())
+            {
+                throw std::out_of_range("codePointAt: position out of range");
+            }
+
+            return utf8::decode(str, index.offset(str, pos));
+        }
+
+        // Valid while this value is not modified.
+        utf8::CodePointRange<typename StringType::value_type> codePoints() const
+        {
+            StringViewType str = view();
+            validIndex(__func__);
+            return utf8::CodePointRange<typename StringType::value_type>(str);
+        }
+
+        StringValue substr(SizeType from, SizeType count)
+        {
+            auto [offset, size] = byteRange(from, count);
+            return subString(offset, size);
+        }
+
+        StringValue substr(SizeType from, SizeType count) const
+        {
+            auto [offset, size] = byteRange(from, count);
+            return subString(offset, size);
+        }
+
+      private:
+        static std::mutex &mutexFor(const void *value)
+        {
+            static std::mutex mutexes[16];
+            return mutexes[(reinterpret_cast<uintptr_t>(value) / alignof(StringValue)) % 16];
+        }
+
+        void invalidateCache()
+        {
+            m_index.reset();
+            m_indexed.store(false, std::memory_order_relaxed);
+            m_hash.store(0, std::memory_order_relaxed);
+        }
+
+        const utf8::Index &index() const
+        {
+            if(!m_indexed.load(std::memory_order_acquire))
+            {
+                StringViewType str = view();
+                std::lock_guard<std::mutex> lock(mutexFor(this));
+                if(!m_indexed.load(std::memory_order_relaxed))
+                {
+                    m_index = std::make_shared<const utf8::Index>(str);
+                    m_indexed.store(true, std::memory_order_release);
+                }
+            }
+
+            return *m_index;
+        }
+
+        const utf8::Index &validIndex(const char *caller) const
+        {
+            const utf8::Index &result = index();
+            if(!result.isValid())
+            {
+                throw std::runtime_error(std::string(caller) + ": invalid UTF-8 string");
+            }
+
+            return result;
+        }
+
+        std::pair<SizeType, SizeType> byteRange(SizeType from, SizeType count) const
+        {
+            StringViewType str = view();
+            const utf8::Index &index = validIndex("substr");
+            if(from > index.length())
+            {
+                throw std::out_of_range("substr: position out of range");
+            }
+
+            SizeType begin = index.offset(str, from);
+            SizeType end = count >= index.length() - from ? str.size()
+                                                          : index.offset(str, from + count);
+            return { begin, end - begin };
+        }
+
+        SizeType checkRange(SizeType from, SizeType count) const
+        {
+            SizeType length = size();
+            if(from > length)
+            {
+                throw std::out_of_range("subString: position out of range");
+            }
+
+            return std::min(count, length - from);
+        }
+
+        const StringType &flat() const
+        {
+            if(!m_rope && m_buffer && m_offset == 0 && m_length == m_buffer->size())
+            {
+                return *m_buffer;
+            }
+
+            flatten();
+            return m_value;
+        }
+
+        void flatten() const
+        {
+            if(!m_pending.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutexFor(this));
+            if(!m_pending.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            if(m_rope)
+            {
+                StringType result(m_rope->size, StringType::value_type());
+                SizeType end = m_rope->size;
+                for(const RopeNode *node = m_rope.get(); node != nullptr;
+                    node = node->prefix.get())
+                {
+                    end -= node->chunk.size();
+                    std::copy(node->chunk.begin(), node->chunk.end(), result.begin() + end);
+                }
+
+                m_value = std::move(result);
+            }
+            else
+            {
+                m_value.assign(m_buffer->data() + m_offset, m_length);
+            }
+
+            m_pending.store(false, std::memory_order_release);
+        }
+
+        void materialize()
+        {
+            if(m_buffer && !m_rope && m_buffer.use_count() == 1 && m_offset == 0 &&
+               m_length == m_buffer->size())
+            {
+                m_value = std::move(*m_buffer);
+            }
+            else
+            {
+                flatten();
+            }
+
+            m_rope.reset();
+            m_buffer.reset();
+            m_pending.store(false, std::memory_order_relaxed);
         }
     };
 
@@ -0,0 +1,260 @@
+#ifndef FDVAR_THREADPOOL_H
+#define FDVAR_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FDVar
+{
+    class ThreadPool
+    {
+      public:
+        typedef size_t SizeType;
+        typedef std::function<void()> TaskType;
+
+      private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<TaskType> tasks;
+        };
+
+        struct Completion
+        {
+            std::atomic<SizeType> remaining;
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::exception_ptr error;
+
+            explicit Completion(SizeType count) : remaining(count) {}
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::atomic<SizeType> m_pending;
+        std::atomic<SizeType> m_next;
+        bool m_stop;
+
+        inline static thread_local ThreadPool *s_currentPool = nullptr;
+        inline static thread_local SizeType s_currentIndex = 0;
+
+      public:
+        explicit ThreadPool(SizeType threadCount = defaultThreadCount()) :
+            m_pending(0),
+            m_next(0),
+            m_stop(false)
+        {
+            SizeType queueCount = std::max<SizeType>(threadCount, 1);
+            for(SizeType i = 0; i < queueCount; ++i)
+            {
+                m_workers.emplace_back(new Worker());
+            }
+
+            for(SizeType i = 0; i < threadCount; ++i)
+            {
+                m_threads.emplace_back([this, i]() { run(i); });
+            }
+        }
+
+        ThreadPool(ThreadPool &&) = delete;
+        ThreadPool(const ThreadPool &) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_condition.notify_all();
+            for(auto &thread: m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        ThreadPool &operator=(ThreadPool &&) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        static SizeType defaultThreadCount()
+        {
+            return std::max<SizeType>(std::thread::hardware_concurrency(), 1);
+        }
+
+        static ThreadPool &instance()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        SizeType size() const { return m_threads.size(); }
+
+        void submit(TaskType task)
+        {
+            SizeType index = s_currentPool == this
+                               ? s_currentIndex
+                               : m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+            {
+                Worker &worker = *m_workers[index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                worker.tasks.push_back(std::move(task));
+                m_pending.fetch_add(1, std::memory_order_release);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+            }
+
+            m_condition.notify_one();
+        }
+
+        template<typename FunctionType>
+        void parallelFor(SizeType begin, SizeType end, SizeType grain, FunctionType &&func)
+        {
+            if(begin >= end)
+            {
+                return;
+            }
+
+            SizeType count = end - begin;
+            if(grain == 0)
+            {
+                grain = std::max<SizeType>(count / (m_workers.size() * 8), 1);
+            }
+
+            SizeType chunkCount = (count + grain - 1) / grain;
+            if(chunkCount == 1 || m_threads.empty())
+            {
+                for(SizeType from = begin; from < end; from += grain)
+                {
+                    func(from, std::min(end, from + grain));
+                }
+
+                return;
+            }
+
+            Completion completion(chunkCount);
+            for(SizeType chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                SizeType from = begin + chunk * grain;
+                SizeType to = std::min(end, from + grain);
+                submit([&completion, &func, from, to]() {
+                    try
+                    {
+                        func(from, to);
+                    }
+                    catch(...)
+                    {
+                        std::lock_guard<std::mutex> lock(completion.mutex);
+                        if(!completion.error)
+                        {
+                            completion.error = std::current_exception();
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(completion.mutex);
+                    if(completion.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        completion.condition.notify_all();
+                    }
+                });
+            }
+
+            wait(completion);
+            if(completion.error)
+            {
+                std::rethrow_exception(completion.error);
+            }
+        }
+
+      private:
+        bool tryPop(SizeType index, TaskType &task)
+        {
+            {
+                Worker &worker = *m_workers[index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                if(!worker.tasks.empty())
+                {
+                    task = std::move(worker.tasks.back());
+                    worker.tasks.pop_back();
+                    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+                    return true;
+                }
+            }
+
+            for(SizeType i = 1, imax = m_workers.size(); i < imax; ++i)
+            {
+                Worker &victim = *m_workers[(index + i) % imax];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if(!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void wait(Completion &completion)
+        {
+            SizeType index = s_currentPool == this ? s_currentIndex : 0;
+            while(completion.remaining.load(std::memory_order_acquire) != 0)
+            {
+                TaskType task;
+                if(tryPop(index, task))
+                {
+                    task();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(completion.mutex);
+                completion.condition.wait_for(lock, std::chrono::milliseconds(1), [&completion]() {
+                    return completion.remaining.load(std::memory_order_acquire) == 0;
+                });
+            }
+
+            std::lock_guard<std::mutex> lock(completion.mutex);
+        }
+
+        void run(SizeType index)
+        {
+            s_currentPool = this;
+            s_currentIndex = index;
+            for(;;)
+            {
+                TaskType task;
+                if(tryPop(index, task))
+                {
+                    task();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() {
+                    return m_stop || m_pending.load(std::memory_order_acquire) != 0;
+                });
+
+                if(m_stop && m_pending.load(std::memory_order_acquire) == 0)
+                {
+                    return;
+                }
+            }
+        }
+    };
+} // namespace FDVar
+
+#endif // FDVAR_THREADPOOL_H
@@ -0,0 +1,333 @@
+#ifndef FDVAR_TIMESTAMPVALUE_H
+#define FDVAR_TIMESTAMPVALUE_H
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <FDVar/AbstractValue.h>
+#include <FDVar/ArithmeticPolicy.h>
+#include <FDVar/DurationValue.h>
+
+namespace FDVar
+{
+    // Point in time as microseconds since 1970-01-01T00:00:00Z, so ordering and arithmetic are
+    // integer operations. Text uses ISO 8601 / RFC 3339: parse() accepts any UTC offset and
+    // toString() always writes UTC with a 'Z'.
+    class TimestampValue : public AbstractValue
+    {
+      public:
+        typedef DurationValue::IntType IntType;
+        typedef DurationValue::DurationType DurationType;
+        typedef std::chrono::time_point<std::chrono::system_clock, DurationType> TimePointType;
+
+      private:
+        typedef arithmetic::Operation Operation;
+
+        static constexpr IntType MICROSECONDS_PER_DAY = 86400 * detail::MICROSECONDS_PER_SECOND;
+
+        TimePointType m_value;
+
+      public:
+        TimestampValue() : m_value() {}
+
+        template<typename Duration>
+        explicit TimestampValue(
+          std::chrono::time_point<std::chrono::system_clock, Duration> value) :
+            m_value(std::chrono::floor<DurationType>(value))
+        {
+        }
+
+        TimestampValue(TimestampValue &&) noexcept = default;
+        TimestampValue(const TimestampValue &) = default;
+
+        ~TimestampValue() noexcept override = default;
+
+        TimestampValue &operator=(TimestampValue &&) noexcept = default;
+        TimestampValue &operator=(const TimestampValue &) = default;
+
+        ValueType getValueType() const override { return ValueType::Timestamp; }
+
+        static TimestampValue fromMicroseconds(IntType count)
+        {
+            return TimestampValue(TimePointType(DurationType(count)));
+        }
+
+        // Accepts "YYYY-MM-DD" (midnight UTC) or "YYYY-MM-DDThh:mm[:ss[.f]][Z|±hh[:]mm]"; 'T' may
+        // also be 't' or a space, and a missing offset means UTC. Years outside 0000-9999 take
+        // the expanded form with a sign. The fields sit at fixed offsets, so this is a single
+        // pass of two-digit reads without allocation or locale lookups.
+        static TimestampValue parse(std::string_view text)
+        {
+            const char *it = text.data();
+            const char *end = it + text.size();
+
+            IntType year = 0;
+            if(it != end && (*it == '+' || *it == '-'))
+            {
+                bool negative = *it++ == '-';
+                const char *start = it;
+                for(; it != end && it - start < 9 && static_cast<unsigned>(*it - '0') <= 9; ++it)
+                {
+                    year = year * 10 + (*it - '0');
+                }
+
+                if(it - start < 4)
+                {
+                    throw std::invalid_argument("TimestampValue::parse: expected a year");
+                }
+
+                year = negative ? -year : year;
+            }
+            else
+            {
+                year = digits(it, end) * 100;
+                year += digits(it, end);
+            }
+
+            expect(it, end, '-');
+            unsigned month = digits(it, end);
+            expect(it, end, '-');
+            unsigned day = digits(it, end);
+            if(month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month))
+            {
+                throw std::invalid_argument("TimestampValue::parse: date out of range");
+            }
+
+            IntType time = 0;
+            if(it != end)
+            {
+                if(*it != 'T' && *it != 't' && *it != ' ')
+                {
+                    throw std::invalid_argument("TimestampValue::parse: unexpected character");
+                }
+
+                ++it;
+                unsigned hour = digits(it, end);
+                expect(it, end, ':');
+                unsigned minute = digits(it, end);
+                unsigned second = 0;
+                int64_t fraction = 0;
+                if(it != end && *it == ':')
+                {
+                    ++it;
+                    second = digits(it, end);
+                    if(it != end && (*it == '.' || *it == ','))
+                    {
+                        it = detail::parseFraction(it + 1, end, fraction);
+                    }
+                }
+
+                int offset = 0;
+                if(it != end && (*it == 'Z' || *it == 'z'))
+                {
+                    ++it;
+                }
+                else if(it != end && (*it == '+' || *it == '-'))
+                {
+                    int sign = *it++ == '-' ? -1 : 1;
+                    unsigned offsetHours = digits(it, end);
+                    if(it != end && *it == ':')
+                    {
+                        ++it;
+                    }
+
+                    unsigned offsetMinutes = digits(it, end);
+                    if(offsetHours > 23 || offsetMinutes > 59)
+                    {
+                        throw std::invalid_argument("TimestampValue::parse: offset out of range");
+                    }
+
+                    offset = sign * int(offsetHours * 60 + offsetMinutes);
+                }
+
+                if(hour > 23 || minute > 59 || second > 59)
+                {
+                    throw std::invalid_argument("TimestampValue::parse: time out of range");
+                }
+
+                time = (IntType(hour) * 3600 + minute * 60 + second - offset * 60) *
+                         detail::MICROSECONDS_PER_SECOND +
+                       fraction;
+            }
+
+            if(it != end)
+            {
+                throw std::invalid_argument("TimestampValue::parse: unexpected character");
+            }
+
+            IntType days = daysFromCivil(year, month, day);
+            return fromMicroseconds(checked<Operation::Add>(
+              checked<Operation::Multiply>(days, MICROSECONDS_PER_DAY), time));
+        }
+
+        // "YYYY-MM-DDThh:mm:ss[.f]Z" with the fraction trimmed of trailing zeros.
+        std::string toString() const
+        {
+            IntType count = m_value.time_since_epoch().count();
+            IntType days = count / MICROSECONDS_PER_DAY;
+            IntType rest = count % MICROSECONDS_PER_DAY;
+            if(rest < 0)
+            {
+                days -= 1;
+                rest += MICROSECONDS_PER_DAY;
+            }
+
+            IntType year;
+            unsigned month;
+            unsigned day;
+            civilFromDays(days, year, month, day);
+            IntType seconds = rest / detail::MICROSECONDS_PER_SECOND;
+
+            char buffer[48];
+            char *out = buffer;
+            if(year < 0 || year > 9999)
+            {
+                *out++ = year < 0 ? '-' : '+';
+                IntType magnitude = year < 0 ? -year : year;
+                char yearDigits[24];
+                char *last =
+                  std::to_chars(yearDigits, yearDigits + sizeof(yearDigits), magnitude).ptr;
+                for(auto width = last - yearDigits; width < 4; ++width)
+                {
+                    *out++ = '0';
+                }
+
+                for(const char *digit = yearDigits; digit != last; ++digit)
+                {
+                    *out++ = *digit;
+                }
+            }
+            else
+            {
+                out = writeDigits(out, unsigned(year / 100));
+                out = writeDigits(out, unsigned(year % 100));
+            }
+
+            *out++ = '-';
+            out = writeDigits(out, month);
+            *out++ = '-';
+            out = writeDigits(out, day);
+            *out++ = 'T';
+            out = writeDigits(out, unsigned(seconds / 3600));
+            *out++ = ':';
+            out = writeDigits(out, unsigned(seconds / 60 % 60));
+            *out++ = ':';
+            out = writeDigits(out, unsigned(seconds % 60));
+            out = detail::writeFraction(out, rest % detail::MICROSECONDS_PER_SECOND);
+            *out++ = 'Z';
+            return std::string(buffer, out);
+        }
+
+        TimePointType value() const { return m_value; }
+        IntType count() const { return m_value.time_since_epoch().count(); }
+
+        int compare(const TimestampValue &other) const
+        {
+            return m_value < other.m_value ? -1 : (other.m_value < m_value ? 1 : 0);
+        }
+
+        bool operator==(const TimestampValue &other) const { return m_value == other.m_value; }
+        bool operator!=(const TimestampValue &other) const { return m_value != other.m_value; }
+        bool operator<(const TimestampValue &other) const { return m_value < other.m_value; }
+        bool operator<=(const TimestampValue &other) const { return m_value <= other.m_value; }
+        bool operator>(const TimestampValue &other) const { return m_value > other.m_value; }
+        bool operator>=(const TimestampValue &other) const { return m_value >= other.m_value; }
+
+        TimestampValue operator+(const DurationValue &duration) const
+        {
+            return fromMicroseconds(checked<Operation::Add>(count(), duration.count()));
+        }
+
+        TimestampValue operator-(const DurationValue &duration) const
+        {
+            return fromMicroseconds(checked<Operation::Subtract>(count(), duration.count()));
+        }
+
+        DurationValue operator-(const TimestampValue &other) const
+        {
+            return DurationValue(
+              DurationType(checked<Operation::Subtract>(count(), other.count())));
+        }
+
+      private:
+        template<Operation O>
+        static IntType checked(IntType lhs, IntType rhs)
+        {
+            return arithmetic::apply<ArithmeticPolicy::Checked, O>(lhs, rhs);
+        }
+
+        static unsigned digits(const char *&it, const char *end)
+        {
+            if(end - it < 2 || static_cast<unsigned>(it[0] - '0') > 9 ||
+               static_cast<unsigned>(it[1] - '0') > 9)
+            {
+                throw std::invalid_argument("TimestampValue::parse: expected two digits");
+            }
+
+            unsigned value = unsigned(it[0] - '0') * 10 + unsigned(it[1] - '0');
+            it += 2;
+            return value;
+        }
+
+        static void expect(const char *&it, const char *end, char c)
+        {
+            if(it == end || *it != c)
+            {
+                throw std::invalid_argument("TimestampValue::parse: unexpected character");
+            }
+
+            ++it;
+        }
+
+        static char *writeDigits(char *out, unsigned value)
+        {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+            return out + 2;
+        }
+
+        static unsigned daysInMonth(IntType year, unsigned month)
+        {
+            constexpr unsigned char DAYS[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+            bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+            return DAYS[month - 1] + (month == 2 && leap ? 1 : 0);
+        }
+
+        // Days since 1970-01-01 in the proleptic Gregorian calendar, and back, using 400-year
+        // eras so that neither direction loops or needs a table.
+        static IntType daysFromCivil(IntType year, unsigned month, unsigned day)
+        {
+            year -= month <= 2 ? 1 : 0;
+            IntType era = (year >= 0 ? year : year - 399) / 400;
+            auto yearOfEra = static_cast<unsigned>(year - era * 400);
+            unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + IntType(dayOfEra) - 719468;
+        }
+
+        static void civilFromDays(IntType days, IntType &year, unsigned &month, unsigned &day)
+        {
+            days += 719468;
+            IntType era = (days >= 0 ? days : days - 146096) / 146097;
+            auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+            unsigned yearOfEra =
+              (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            unsigned shifted = (5 * dayOfYear + 2) / 153;
+            day = dayOfYear - (153 * shifted + 2) / 5 + 1;
+            month = shifted < 10 ? shifted + 3 : shifted - 9;
+            year = IntType(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+        }
+    };
+
+    inline TimestampValue operator+(const DurationValue &duration, const TimestampValue &timestamp)
+    {
+        return timestamp + duration;
+    }
+} // namespace FDVar
+
+#endif // FDVAR_TIMESTAMPVALUE_H
@@ -0,0 +1,318 @@
+#ifndef FDVAR_UTF8_H
+#define FDVAR_UTF8_H
+
+#ifndef FDVAR_UTF8_INDEX_STRIDE
+    #define FDVAR_UTF8_INDEX_STRIDE 64
+#endif // FDVAR_UTF8_INDEX_STRIDE
+
+#ifndef FDVAR_UTF8_INDEX_THRESHOLD
+    #define FDVAR_UTF8_INDEX_THRESHOLD 256
+#endif // FDVAR_UTF8_INDEX_THRESHOLD
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace FDVar
+{
+    namespace utf8
+    {
+        typedef size_t SizeType;
+
+        constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+        constexpr uint64_t LOW_BITS = 0x0101010101010101ULL;
+
+        inline uint64_t loadWord(const unsigned char *data)
+        {
+            uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            return word;
+        }
+
+        inline SizeType countContinuations(uint64_t word)
+        {
+            uint64_t continuations = ((word & HIGH_BITS) >> 7) & ((~word >> 6) & LOW_BITS);
+            return static_cast<SizeType>((continuations * LOW_BITS) >> 56);
+        }
+
+        template<typename CharType>
+        SizeType sequenceLength(CharType lead)
+        {
+            if constexpr(sizeof(CharType) != 1)
+            {
+                return 1;
+            }
+            else
+            {
+                unsigned char c = static_cast<unsigned char>(lead);
+                return c < 0x80 ? 1 : (c < 0xE0 ? 2 : (c < 0xF0 ? 3 : 4));
+            }
+        }
+
+        template<typename CharType>
+        bool isValid(std::basic_string_view<CharType> str)
+        {
+            if constexpr(sizeof(CharType) != 1)
+            {
+                return true;
+            }
+            else
+            {
+                const auto *data = reinterpret_cast<const unsigned char *>(str.data());
+                SizeType size = str.size();
+                SizeType i = 0;
+                while(i < size)
+                {
+                    if(i + sizeof(uint64_t) <= size && (loadWord(data + i) & HIGH_BITS) == 0)
+                    {
+                        i += sizeof(uint64_t);
+                        continue;
+                    }
+
+                    unsigned char c = data[i];
+                    if(c < 0x80)
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    SizeType length;
+                    uint32_t codePoint;
+                    if(c >= 0xC2 && c < 0xE0)
+                    {
+                        length = 2;
+                        codePoint = c & 0x1F;
+                    }
+                    else if(c >= 0xE0 && c < 0xF0)
+                    {
+                        length = 3;
+                        codePoint = c & 0x0F;
+                    }
+                    else if(c >= 0xF0 && c < 0xF5)
+                    {
+                        length = 4;
+                        codePoint = c & 0x07;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+
+                    if(i + length > size)
+                    {
+                        return false;
+                    }
+
+                    for(SizeType k = 1; k < length; ++k)
+                    {
+                        if((data[i + k] & 0xC0) != 0x80)
+                        {
+                            return false;
+                        }
+
+                        codePoint = (codePoint << 6) | (data[i + k] & 0x3F);
+                    }
+
+                    if((length == 3 && (codePoint < 0x800 ||
+                                        (codePoint >= 0xD800 && codePoint <= 0xDFFF))) ||
+                       (length == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF)))
+                    {
+                        return false;
+                    }
+
+                    i += length;
+                }
+
+                return true;
+            }
+        }
+
+        template<typename CharType>
+        SizeType length(std::basic_string_view<CharType> str)
+        {
+            if constexpr(sizeof(CharType) != 1)
+            {
+                return str.size();
+            }
+            else
+            {
+                const auto *data = reinterpret_cast<const unsigned char *>(str.data());
+                SizeType size = str.size();
+                SizeType continuations = 0;
+                SizeType i = 0;
+                for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+                {
+                    continuations += countContinuations(loadWord(data + i));
+                }
+
+                for(; i < size; ++i)
+                {
+                    continuations += (data[i] & 0xC0) == 0x80 ? 1 : 0;
+                }
+
+                return size - continuations;
+            }
+        }
+
+        template<typename CharType>
+        uint32_t decode(std::basic_string_view<CharType> str, SizeType offset)
+        {
+            if constexpr(sizeof(CharType) != 1)
+            {
+                return static_cast<uint32_t>(str[offset]);
+            }
+            else
+            {
+                SizeType length = sequenceLength(str[offset]);
+                uint32_t codePoint = static_cast<unsigned char>(str[offset]) &
+                                     (length == 1 ? 0x7F : (0x7F >> length));
+                for(SizeType k = 1; k < length; ++k)
+                {
+                    codePoint =
+                      (codePoint << 6) | (static_cast<unsigned char>(str[offset + k]) & 0x3F);
+                }
+
+                return codePoint;
+            }
+        }
+
+        // Forward range over the code points of a valid string, decoded in place without
+        // allocating. Wide strings yield one code point per unit.
+        template<typename CharType>
+        class CodePointRange
+        {
+          public:
+            typedef std::basic_string_view<CharType> StringViewType;
+
+            class Iterator
+            {
+              private:
+                StringViewType m_str;
+                SizeType m_offset;
+
+              public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef uint32_t value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const uint32_t *pointer;
+                typedef uint32_t reference;
+
+                Iterator() : m_offset(0) {}
+                Iterator(StringViewType str, SizeType offset) : m_str(str), m_offset(offset) {}
+
+                uint32_t operator*() const { return decode(m_str, m_offset); }
+
+                // The encoded character and its byte offset.
+                StringViewType character() const
+                {
+                    return m_str.substr(m_offset, sequenceLength(m_str[m_offset]));
+                }
+
+                SizeType offset() const { return m_offset; }
+
+                Iterator &operator++()
+                {
+                    m_offset += sequenceLength(m_str[m_offset]);
+                    return *this;
+                }
+
+                Iterator operator++(int)
+                {
+                    Iterator result = *this;
+                    ++*this;
+                    return result;
+                }
+
+                bool operator==(const Iterator &other) const { return m_offset == other.m_offset; }
+                bool operator!=(const Iterator &other) const { return m_offset != other.m_offset; }
+            };
+
+          private:
+            StringViewType m_str;
+
+          public:
+            explicit CodePointRange(StringViewType str) : m_str(str) {}
+
+            Iterator begin() const { return Iterator(m_str, 0); }
+            Iterator end() const { return Iterator(m_str, m_str.size()); }
+        };
+
+        class Index
+        {
+          private:
+            std::vector<SizeType> m_offsets;
+            SizeType m_length;
+            bool m_valid;
+            bool m_ascii;
+
+          public:
+            template<typename CharType>
+            explicit Index(std::basic_string_view<CharType> str) :
+                m_length(0),
+                m_valid(utf8::isValid(str)),
+                m_ascii(false)
+            {
+                if(!m_valid)
+                {
+                    return;
+                }
+
+                m_length = utf8::length(str);
+                m_ascii = m_length == str.size();
+                if(m_ascii || str.size() < FDVAR_UTF8_INDEX_THRESHOLD)
+                {
+                    return;
+                }
+
+                m_offsets.reserve(m_length / FDVAR_UTF8_INDEX_STRIDE + 1);
+                SizeType codePoint = 0;
+                for(SizeType i = 0; i < str.size(); i += sequenceLength(str[i]), ++codePoint)
+                {
+                    if(codePoint % FDVAR_UTF8_INDEX_STRIDE == 0)
+                    {
+                        m_offsets.push_back(i);
+                    }
+                }
+            }
+
+            bool isValid() const { return m_valid; }
+            bool isAscii() const { return m_ascii; }
+            SizeType length() const { return m_length; }
+
+            template<typename CharType>
+            SizeType offset(std::basic_string_view<CharType> str, SizeType codePoint) const
+            {
+                if(codePoint >= m_length)
+                {
+                    return str.size();
+                }
+
+                if(m_ascii)
+                {
+                    return codePoint;
+                }
+
+                SizeType block = codePoint / FDVAR_UTF8_INDEX_STRIDE;
+                SizeType i = 0;
+                SizeType remaining = codePoint;
+                if(block < m_offsets.size())
+                {
+                    i = m_offsets[block];
+                    remaining = codePoint % FDVAR_UTF8_INDEX_STRIDE;
+                }
+
+                for(; remaining != 0; --remaining)
+                {
+                    i += sequenceLength(str[i]);
+                }
+
+                return i;
+            }
+        };
+    } // namespace utf8
+} // namespace FDVar
+
+#endif // FDVAR_UTF8_H
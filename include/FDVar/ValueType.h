@@ -15,7 +15,12 @@ namespace FDVar
         String,
         Function,
         Array,
-        Object
+        Object,
+        BigInteger,
+        Decimal,
+        Bytes,
+        Timestamp,
+        Duration
     };
 } // namespace FDVar
 
@@ -48,6 +53,21 @@ namespace std
 
             case FDVar::ValueType::Object:
                 return "Object";
+
+            case FDVar::ValueType::BigInteger:
+                return "BigInteger";
+
+            case FDVar::ValueType::Decimal:
+                return "Decimal";
+
+            case FDVar::ValueType::Bytes:
+                return "Bytes";
+
+            case FDVar::ValueType::Timestamp:
+                return "Timestamp";
+
+            case FDVar::ValueType::Duration:
+                return "Duration";
         }
     }
 } // namespace std
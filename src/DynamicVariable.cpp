@@ -1,4 +1,6 @@
 #include <FDVar/DynamicVariable.h>
+#include <cmath>
+#include <limits>
 #include <utility>
 
 using namespace FDVar;
@@ -38,6 +40,26 @@ DynamicVariable::DynamicVariable(ValueType type)
             m_value = std::make_shared<FunctionValue>();
             break;
 
+        case ValueType::BigInteger:
+            m_value = std::make_shared<BigIntegerValue>();
+            break;
+
+        case ValueType::Decimal:
+            m_value = std::make_shared<DecimalValue>();
+            break;
+
+        case ValueType::Bytes:
+            m_value = std::make_shared<BytesValue>();
+            break;
+
+        case ValueType::Timestamp:
+            m_value = std::make_shared<TimestampValue>();
+            break;
+
+        case ValueType::Duration:
+            m_value = std::make_shared<DurationValue>();
+            break;
+
         default:
             throw generateCastException(__func__);
     }
@@ -68,6 +90,14 @@ DynamicVariable &DynamicVariable::operator=(const DynamicVariable &other)
             m_value.reset(new StringValue(other.toString()));
             break;
 
+        case ValueType::BigInteger:
+            m_value.reset(new BigIntegerValue(other.toBigInteger()));
+            break;
+
+        case ValueType::Decimal:
+            m_value.reset(new DecimalValue(other.toDecimal()));
+            break;
+
         default:
             m_value = other.m_value;
             break;
@@ -138,65 +168,593 @@ DynamicVariable::operator const ObjectType &() const
     return static_cast<const ObjectType &>(static_cast<const ObjectValue &>(toObject()));
 }
 
+DynamicVariable::operator const BytesValue &() const { return toBytes(); }
 
-bool DynamicVariable::operator==(const DynamicVariable &value) const
+DynamicVariable::operator const TimestampValue &() const { return toTimestamp(); }
+
+DynamicVariable::operator const DurationValue &() const { return toDuration(); }
+
+
+namespace
 {
-    ValueType type = getValueType();
-    if(type != value.getValueType())
+    typedef std::pair<DynamicVariable::StringViewType, const AbstractValue *> MemberType;
+
+    ValueType typeOf(const AbstractValue *value)
     {
-        return false;
+        return value == nullptr ? ValueType::None : value->getValueType();
     }
 
-    switch(type)
+    bool isContainer(ValueType type)
     {
-        case ValueType::None:
-            return true;
+        return type == ValueType::Array || type == ValueType::Object;
+    }
 
-        case ValueType::Boolean:
-            return toBoolean() == value.toBoolean();
+    bool equalScalars(const AbstractValue *lhs, const AbstractValue *rhs, ValueType type)
+    {
+        switch(type)
+        {
+            case ValueType::None:
+                return true;
+
+            case ValueType::Boolean:
+                return static_cast<bool>(static_cast<const BoolValue &>(*lhs)) ==
+                       static_cast<bool>(static_cast<const BoolValue &>(*rhs));
+
+            case ValueType::Integer:
+                return static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*lhs)) ==
+                       static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*rhs));
+
+            case ValueType::Float:
+                return static_cast<DynamicVariable::FloatType>(
+                         static_cast<const FloatValue &>(*lhs)) ==
+                       static_cast<DynamicVariable::FloatType>(
+                         static_cast<const FloatValue &>(*rhs));
+
+            case ValueType::String:
+                return static_cast<const StringValue &>(*lhs) ==
+                       static_cast<const StringValue &>(*rhs);
+
+            case ValueType::BigInteger:
+                return static_cast<const BigIntegerValue &>(*lhs) ==
+                       static_cast<const BigIntegerValue &>(*rhs);
+
+            case ValueType::Decimal:
+                return static_cast<const DecimalValue &>(*lhs) ==
+                       static_cast<const DecimalValue &>(*rhs);
+
+            case ValueType::Bytes:
+                return static_cast<const BytesValue &>(*lhs) ==
+                       static_cast<const BytesValue &>(*rhs);
+
+            case ValueType::Timestamp:
+                return static_cast<const TimestampValue &>(*lhs) ==
+                       static_cast<const TimestampValue &>(*rhs);
+
+            case ValueType::Duration:
+                return static_cast<const DurationValue &>(*lhs) ==
+                       static_cast<const DurationValue &>(*rhs);
+
+            default:
+                return lhs == rhs;
+        }
+    }
 
-        case ValueType::Integer:
-            return toInteger() == value.toInteger();
+    bool equalValues(const AbstractValue *lhs, const AbstractValue *rhs)
+    {
+        std::vector<std::pair<const AbstractValue *, const AbstractValue *>> pending;
+        auto visit = [&pending](const AbstractValue *lhs, const AbstractValue *rhs) {
+            if(lhs == rhs)
+            {
+                return true;
+            }
+
+            ValueType type = typeOf(lhs);
+            if(type != typeOf(rhs))
+            {
+                return false;
+            }
+
+            if(isContainer(type))
+            {
+                pending.emplace_back(lhs, rhs);
+                return true;
+            }
+
+            return equalScalars(lhs, rhs, type);
+        };
+
+        if(!visit(lhs, rhs))
+        {
+            return false;
+        }
+
+        while(!pending.empty())
+        {
+            auto [left, right] = pending.back();
+            pending.pop_back();
+            if(left->isType(ValueType::Array))
+            {
+                const auto &lhsArray = static_cast<const AbstractArrayValue &>(*left);
+                const auto &rhsArray = static_cast<const AbstractArrayValue &>(*right);
+                DynamicVariable::SizeType size = lhsArray.size();
+                if(size != rhsArray.size())
+                {
+                    return false;
+                }
+
+                for(DynamicVariable::SizeType i = size; i-- > 0;)
+                {
+                    if(!visit(lhsArray[i].get(), rhsArray[i].get()))
+                    {
+                        return false;
+                    }
+                }
+            }
+            else
+            {
+                const auto &lhsObject = static_cast<const AbstractObjectValue &>(*left);
+                const auto &rhsObject = static_cast<const AbstractObjectValue &>(*right);
+                if(lhsObject.size() != rhsObject.size())
+                {
+                    return false;
+                }
+
+                bool equal = true;
+                lhsObject.forEach(
+                  [&](DynamicVariable::StringViewType key, const AbstractValue::Ptr &value) {
+                      if(!equal)
+                      {
+                          return;
+                      }
+
+                      AbstractValue::Ptr other = rhsObject.get(key);
+                      if(!other && (value || !rhsObject.contains(key)))
+                      {
+                          equal = false;
+                          return;
+                      }
+
+                      equal = visit(value.get(), other.get());
+                  });
+
+                if(!equal)
+                {
+                    return false;
+                }
+            }
+        }
 
-        case ValueType::Float:
-            return toFloat() == value.toFloat();
+        return true;
+    }
 
-        case ValueType::String:
-            return toString() == value.toString();
+    template<typename T>
+    int threeWay(const T &lhs, const T &rhs)
+    {
+        return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+    }
 
-        default:
-            throw generateCastException(__func__);
+    int compareNumbers(DynamicVariable::FloatType lhs, DynamicVariable::FloatType rhs)
+    {
+        if(std::isnan(lhs) || std::isnan(rhs))
+        {
+            return threeWay(std::isnan(lhs), std::isnan(rhs));
+        }
+
+        return threeWay(lhs, rhs);
     }
-}
 
-bool DynamicVariable::operator!=(const DynamicVariable &value) const
-{
-    ValueType type = getValueType();
-    if(type != value.getValueType())
+    DynamicVariable::FloatType numberOf(const AbstractValue *value)
     {
-        return true;
+        if(value->isType(ValueType::Integer))
+        {
+            return static_cast<DynamicVariable::FloatType>(
+              static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*value)));
+        }
+
+        if(value->isType(ValueType::BigInteger))
+        {
+            return static_cast<DynamicVariable::FloatType>(
+              static_cast<const BigIntegerValue &>(*value).toFloat());
+        }
+
+        if(value->isType(ValueType::Decimal))
+        {
+            return static_cast<DynamicVariable::FloatType>(
+              static_cast<const DecimalValue &>(*value).toFloat());
+        }
+
+        return static_cast<DynamicVariable::FloatType>(static_cast<const FloatValue &>(*value));
     }
 
-    switch(type)
+    bool isInteger(ValueType type)
     {
-        case ValueType::None:
-            return false;
+        return type == ValueType::Integer || type == ValueType::BigInteger;
+    }
 
-        case ValueType::Boolean:
-            return toBoolean() != value.toBoolean();
+    bool isNumber(ValueType type)
+    {
+        return isInteger(type) || type == ValueType::Float || type == ValueType::Decimal;
+    }
 
-        case ValueType::Integer:
-            return toInteger() != value.toInteger();
+    BigIntegerValue bigIntegerOf(const AbstractValue *value)
+    {
+        if(value->isType(ValueType::Integer))
+        {
+            return BigIntegerValue(
+              static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*value)));
+        }
 
-        case ValueType::Float:
-            return toFloat() != value.toFloat();
+        return static_cast<const BigIntegerValue &>(*value);
+    }
 
-        case ValueType::String:
-            return toString() != value.toString();
+    // Throws std::overflow_error for a BigInteger, which never fits in a Decimal coefficient.
+    DecimalValue decimalOf(const AbstractValue *value)
+    {
+        switch(value->getValueType())
+        {
+            case ValueType::Integer:
+                return DecimalValue(
+                  static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*value)));
+
+            case ValueType::BigInteger:
+                return DecimalValue(static_cast<const BigIntegerValue &>(*value).toInteger());
+
+            default:
+                return static_cast<const DecimalValue &>(*value);
+        }
+    }
 
-        default:
-            throw generateCastException(__func__);
+    template<typename T>
+    T calculate(arithmetic::Operation operation, const T &lhs, const T &rhs)
+    {
+        switch(operation)
+        {
+            case arithmetic::Operation::Add:
+                return lhs + rhs;
+            case arithmetic::Operation::Subtract:
+                return lhs - rhs;
+            case arithmetic::Operation::Multiply:
+                return lhs * rhs;
+            case arithmetic::Operation::Divide:
+                return lhs / rhs;
+            default:
+                if constexpr(std::is_floating_point_v<T>)
+                {
+                    throw std::domain_error("modulo needs integer or decimal operands");
+                }
+                else
+                {
+                    return lhs % rhs;
+                }
+        }
+    }
+
+    // BigInteger results that fit in IntType go back to the inline representation.
+    DynamicVariable narrowed(BigIntegerValue &&value)
+    {
+        if(value.fitsInteger())
+        {
+            return IntValue(value.toInteger());
+        }
+
+        return DynamicVariable(std::move(value));
+    }
+
+    // A finite number split exactly into its integral part, truncated toward zero, and the
+    // fraction numerator / denominator left over; the numerator carries the sign.
+    struct ExactNumber
+    {
+        BigIntegerValue integral;
+        BigIntegerValue numerator;
+        BigIntegerValue denominator;
+    };
+
+    BigIntegerValue powerOfTwo(unsigned exponent)
+    {
+        BigIntegerValue::LimbsType limbs(exponent / 32 + 1, 0);
+        limbs.back() = BigIntegerValue::LimbType(1) << (exponent % 32);
+        return BigIntegerValue(std::move(limbs), false);
     }
+
+    ExactNumber exactOf(const AbstractValue *value)
+    {
+        if(value->isType(ValueType::Float))
+        {
+            int exponent = 0;
+            DynamicVariable::FloatType mantissa = std::frexp(numberOf(value), &exponent);
+            constexpr int digits = std::numeric_limits<DynamicVariable::FloatType>::digits;
+            BigIntegerValue significand(static_cast<int64_t>(std::ldexp(mantissa, digits)));
+            exponent -= digits;
+            if(exponent >= 0)
+            {
+                return { significand * powerOfTwo(static_cast<unsigned>(exponent)),
+                         BigIntegerValue(),
+                         BigIntegerValue(1) };
+            }
+
+            BigIntegerValue denominator = powerOfTwo(static_cast<unsigned>(-exponent));
+            return { significand / denominator, significand % denominator, denominator };
+        }
+
+        if(value->isType(ValueType::Decimal))
+        {
+            const auto &decimal = static_cast<const DecimalValue &>(*value);
+            DynamicVariable::IntType power = 1;
+            for(unsigned i = 0; i < decimal.scale(); ++i)
+            {
+                power *= 10;
+            }
+
+            return { BigIntegerValue(decimal.coefficient() / power),
+                     BigIntegerValue(decimal.coefficient() % power),
+                     BigIntegerValue(power) };
+        }
+
+        return { bigIntegerOf(value), BigIntegerValue(), BigIntegerValue(1) };
+    }
+
+    // Exact ordering of two finite numbers of any numeric type, so mixed comparisons stay
+    // transitive where a round trip through double would not.
+    int compareExact(const AbstractValue *lhs, const AbstractValue *rhs)
+    {
+        ExactNumber left = exactOf(lhs);
+        ExactNumber right = exactOf(rhs);
+        int result = left.integral.compare(right.integral);
+        if(result != 0)
+        {
+            return result;
+        }
+
+        return (left.numerator * right.denominator).compare(right.numerator * left.denominator);
+    }
+
+    // Numbers of any numeric type by value alone; equal values of different types give 0.
+    int compareNumberValues(const AbstractValue *lhs, const AbstractValue *rhs)
+    {
+        ValueType lhsType = typeOf(lhs);
+        ValueType rhsType = typeOf(rhs);
+        if(lhsType == rhsType)
+        {
+            switch(lhsType)
+            {
+                case ValueType::Integer:
+                    return threeWay(
+                      static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*lhs)),
+                      static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*rhs)));
+
+                case ValueType::BigInteger:
+                    return static_cast<const BigIntegerValue &>(*lhs).compare(
+                      static_cast<const BigIntegerValue &>(*rhs));
+
+                case ValueType::Decimal:
+                    return static_cast<const DecimalValue &>(*lhs).compare(
+                      static_cast<const DecimalValue &>(*rhs));
+
+                default:
+                    return compareNumbers(numberOf(lhs), numberOf(rhs));
+            }
+        }
+
+        if(isInteger(lhsType) && isInteger(rhsType))
+        {
+            return bigIntegerOf(lhs).compare(bigIntegerOf(rhs));
+        }
+
+        if(lhsType != ValueType::Float && rhsType != ValueType::Float &&
+           lhsType != ValueType::BigInteger && rhsType != ValueType::BigInteger)
+        {
+            return decimalOf(lhs).compare(decimalOf(rhs));
+        }
+
+        if(lhsType == ValueType::Float && !std::isfinite(numberOf(lhs)))
+        {
+            return compareNumbers(numberOf(lhs), 0);
+        }
+
+        if(rhsType == ValueType::Float && !std::isfinite(numberOf(rhs)))
+        {
+            return compareNumbers(0, numberOf(rhs));
+        }
+
+        return compareExact(lhs, rhs);
+    }
+
+    // Numeric types sort together at the place of Integer, so that ordering numbers by value
+    // stays transitive with the types that lie between them in ValueType.
+    ValueType typeRank(ValueType type) { return isNumber(type) ? ValueType::Integer : type; }
+
+    int compareScalars(const AbstractValue *lhs, const AbstractValue *rhs)
+    {
+        ValueType lhsType = typeOf(lhs);
+        ValueType rhsType = typeOf(rhs);
+        if(isNumber(lhsType) && isNumber(rhsType) && lhsType != rhsType)
+        {
+            int result = compareNumberValues(lhs, rhs);
+            return result != 0 ? result : threeWay(lhsType, rhsType);
+        }
+
+        if(lhsType != rhsType)
+        {
+            return threeWay(typeRank(lhsType), typeRank(rhsType));
+        }
+
+        switch(lhsType)
+        {
+            case ValueType::None:
+                return 0;
+
+            case ValueType::Boolean:
+                return threeWay(static_cast<bool>(static_cast<const BoolValue &>(*lhs)),
+                                static_cast<bool>(static_cast<const BoolValue &>(*rhs)));
+
+            case ValueType::Integer:
+                return threeWay(
+                  static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*lhs)),
+                  static_cast<DynamicVariable::IntType>(static_cast<const IntValue &>(*rhs)));
+
+            case ValueType::Float:
+                return compareNumbers(numberOf(lhs), numberOf(rhs));
+
+            case ValueType::BigInteger:
+                return static_cast<const BigIntegerValue &>(*lhs).compare(
+                  static_cast<const BigIntegerValue &>(*rhs));
+
+            case ValueType::Decimal:
+                return static_cast<const DecimalValue &>(*lhs).compare(
+                  static_cast<const DecimalValue &>(*rhs));
+
+            case ValueType::Bytes:
+                return static_cast<const BytesValue &>(*lhs).compare(
+                  static_cast<const BytesValue &>(*rhs));
+
+            case ValueType::Timestamp:
+                return static_cast<const TimestampValue &>(*lhs).compare(
+                  static_cast<const TimestampValue &>(*rhs));
+
+            case ValueType::Duration:
+                return static_cast<const DurationValue &>(*lhs).compare(
+                  static_cast<const DurationValue &>(*rhs));
+
+            case ValueType::String:
+            {
+                int result = static_cast<const StringValue &>(*lhs).view().compare(
+                  static_cast<const StringValue &>(*rhs).view());
+                return threeWay(result, 0);
+            }
+
+            default:
+                return threeWay(std::less<const AbstractValue *>()(rhs, lhs),
+                                std::less<const AbstractValue *>()(lhs, rhs));
+        }
+    }
+
+    struct CompareFrame
+    {
+        const AbstractArrayValue *lhsArray;
+        const AbstractArrayValue *rhsArray;
+        std::vector<MemberType> lhsMembers;
+        std::vector<MemberType> rhsMembers;
+        DynamicVariable::SizeType lhsSize;
+        DynamicVariable::SizeType rhsSize;
+        DynamicVariable::SizeType next;
+    };
+
+    std::vector<MemberType> sortedMembers(const AbstractObjectValue &obj)
+    {
+        std::vector<MemberType> members;
+        members.reserve(obj.size());
+        obj.forEach(
+          [&members](DynamicVariable::StringViewType key, const AbstractValue::Ptr &value) {
+              members.emplace_back(key, value.get());
+          });
+
+        std::sort(members.begin(), members.end(), [](const MemberType &lhs, const MemberType &rhs) {
+            return lhs.first < rhs.first;
+        });
+
+        return members;
+    }
+
+    int compareValues(const AbstractValue *lhs, const AbstractValue *rhs)
+    {
+        std::vector<CompareFrame> stack;
+        for(;;)
+        {
+            ValueType type = typeOf(lhs);
+            if(lhs != rhs && type == typeOf(rhs) && isContainer(type))
+            {
+                CompareFrame frame { nullptr, nullptr, {}, {}, 0, 0, 0 };
+                if(type == ValueType::Array)
+                {
+                    frame.lhsArray = static_cast<const AbstractArrayValue *>(lhs);
+                    frame.rhsArray = static_cast<const AbstractArrayValue *>(rhs);
+                    frame.lhsSize = frame.lhsArray->size();
+                    frame.rhsSize = frame.rhsArray->size();
+                }
+                else
+                {
+                    const auto &lhsObject = static_cast<const AbstractObjectValue &>(*lhs);
+                    const auto &rhsObject = static_cast<const AbstractObjectValue &>(*rhs);
+                    frame.lhsMembers = sortedMembers(lhsObject);
+                    frame.rhsMembers = sortedMembers(rhsObject);
+                    frame.lhsSize = frame.lhsMembers.size();
+                    frame.rhsSize = frame.rhsMembers.size();
+                }
+
+                stack.push_back(std::move(frame));
+            }
+            else if(lhs != rhs)
+            {
+                int result = compareScalars(lhs, rhs);
+                if(result != 0)
+                {
+                    return result;
+                }
+            }
+
+            for(;;)
+            {
+                if(stack.empty())
+                {
+                    return 0;
+                }
+
+                CompareFrame &top = stack.back();
+                if(top.next < top.lhsSize && top.next < top.rhsSize)
+                {
+                    DynamicVariable::SizeType i = top.next++;
+                    if(top.lhsArray != nullptr)
+                    {
+                        lhs = (*top.lhsArray)[i].get();
+                        rhs = (*top.rhsArray)[i].get();
+                    }
+                    else
+                    {
+                        int result = threeWay(top.lhsMembers[i].first, top.rhsMembers[i].first);
+                        if(result != 0)
+                        {
+                            return result;
+                        }
+
+                        lhs = top.lhsMembers[i].second;
+                        rhs = top.rhsMembers[i].second;
+                    }
+
+                    break;
+                }
+
+                int result = threeWay(top.lhsSize, top.rhsSize);
+                if(result != 0)
+                {
+                    return result;
+                }
+
+                stack.pop_back();
+            }
+        }
+    }
+} // namespace
+
+bool DynamicVariable::operator==(const DynamicVariable &value) const
+{
+    return equalValues(m_value.get(), value.m_value.get());
+}
+
+bool DynamicVariable::operator!=(const DynamicVariable &value) const { return !(*this == value); }
+
+int DynamicVariable::compare(const DynamicVariable &value) const
+{
+    return compareValues(m_value.get(), value.m_value.get());
+}
+
+int DynamicVariable::compareNumber(const DynamicVariable &value) const
+{
+    if(!isNumber(typeOf(m_value.get())) || !isNumber(typeOf(value.m_value.get())))
+    {
+        throw generateCastException(__func__);
+    }
+
+    return compareNumberValues(m_value.get(), value.m_value.get());
 }
 
 bool DynamicVariable::operator==(std::nullptr_t) const { return isType(ValueType::None); }
@@ -227,7 +785,8 @@ DynamicVariable DynamicVariable::operator-() const
 {
     if(isType(ValueType::Integer))
     {
-        return DynamicVariable(-toInteger());
+        return DynamicVariable(IntType(0))
+          .combineInteger<arithmetic::Operation::Subtract>(static_cast<IntType>(toInteger()));
     }
 
     if(isType(ValueType::Float))
@@ -235,6 +794,21 @@ DynamicVariable DynamicVariable::operator-() const
         return DynamicVariable(-toFloat());
     }
 
+    if(isType(ValueType::BigInteger))
+    {
+        return narrowed(-toBigInteger());
+    }
+
+    if(isType(ValueType::Decimal))
+    {
+        return DynamicVariable(-toDecimal());
+    }
+
+    if(isType(ValueType::Duration))
+    {
+        return DynamicVariable(-toDuration());
+    }
+
     throw generateCastException(__func__);
 }
 
@@ -326,6 +900,14 @@ DynamicVariable &DynamicVariable::operator+=(const DynamicVariable &value)
         case ValueType::Float:
             return *this += static_cast<FloatType>(value.toFloat());
 
+        case ValueType::BigInteger:
+        case ValueType::Decimal:
+            return assignExact(arithmetic::Operation::Add, value);
+
+        case ValueType::Timestamp:
+        case ValueType::Duration:
+            return *this = combineTime(arithmetic::Operation::Add, value);
+
         case ValueType::String:
             return *this += static_cast<StringType>(value.toString());
 
@@ -344,12 +926,20 @@ DynamicVariable &DynamicVariable::operator-=(const DynamicVariable &value)
         case ValueType::Float:
             return *this -= static_cast<FloatType>(value.toFloat());
 
+        case ValueType::BigInteger:
+        case ValueType::Decimal:
+            return assignExact(arithmetic::Operation::Subtract, value);
+
+        case ValueType::Timestamp:
+        case ValueType::Duration:
+            return *this = combineTime(arithmetic::Operation::Subtract, value);
+
         default:
             throw generateCastException(__func__);
     }
 }
 
-DynamicVariable DynamicVariable::operator+(StringViewType value) const
+DynamicVariable DynamicVariable::operator+(StringViewType value) const &
 {
     if(!isType(ValueType::String))
     {
@@ -359,7 +949,7 @@ DynamicVariable DynamicVariable::operator+(StringViewType value) const
     return toString() + value;
 }
 
-DynamicVariable DynamicVariable::operator+(const DynamicVariable &value) const
+DynamicVariable DynamicVariable::operator+(const DynamicVariable &value) const &
 {
     switch(value.getValueType())
     {
@@ -369,6 +959,14 @@ DynamicVariable DynamicVariable::operator+(const DynamicVariable &value) const
         case ValueType::Float:
             return *this + static_cast<FloatType>(value.toFloat());
 
+        case ValueType::BigInteger:
+        case ValueType::Decimal:
+            return combineExact(arithmetic::Operation::Add, value);
+
+        case ValueType::Timestamp:
+        case ValueType::Duration:
+            return combineTime(arithmetic::Operation::Add, value);
+
         case ValueType::String:
             return *this + static_cast<StringType>(value.toString());
 
@@ -377,7 +975,7 @@ DynamicVariable DynamicVariable::operator+(const DynamicVariable &value) const
     }
 }
 
-DynamicVariable DynamicVariable::operator-(const DynamicVariable &value) const
+DynamicVariable DynamicVariable::operator-(const DynamicVariable &value) const &
 {
     switch(value.getValueType())
     {
@@ -387,6 +985,14 @@ DynamicVariable DynamicVariable::operator-(const DynamicVariable &value) const
         case ValueType::Float:
             return *this - static_cast<FloatType>(value.toFloat());
 
+        case ValueType::BigInteger:
+        case ValueType::Decimal:
+            return combineExact(arithmetic::Operation::Subtract, value);
+
+        case ValueType::Timestamp:
+        case ValueType::Duration:
+            return combineTime(arithmetic::Operation::Subtract, value);
+
         default:
             throw generateCastException(__func__);
     }
@@ -402,12 +1008,20 @@ DynamicVariable &DynamicVariable::operator*=(const DynamicVariable &value)
         case ValueType::Float:
             return *this *= static_cast<FloatType>(value.toFloat());
 
+        case ValueType::BigInteger:
+        case ValueType::Decimal:
+            return assignExact(arithmetic::Operation::Multiply, value);
+
+        case ValueType::Timestamp:
+        case ValueType::Duration:
+            return *this = combineTime(arithmetic::Operation::Multiply, value);
+
         default:
             throw generateCastException(__func__);
     }
 }
 
-DynamicVariable DynamicVariable::operator*(const DynamicVariable &value) const
+DynamicVariable DynamicVariable::operator*(const DynamicVariable &value) const &
 {
     switch(value.getValueType())
     {
@@ -417,6 +1031,14 @@ DynamicVariable DynamicVariable::operator*(const DynamicVariable &value) const
         case ValueType::Float:
             return *this * static_cast<FloatType>(value.toFloat());
 
+        case ValueType::BigInteger:
+        case ValueType::Decimal:
+            return combineExact(arithmetic::Operation::Multiply, value);
+
+        case ValueType::Timestamp:
+        case ValueType::Duration:
+            return combineTime(arithmetic::Operation::Multiply, value);
+
         default:
             throw generateCastException(__func__);
     }
@@ -432,12 +1054,20 @@ DynamicVariable &DynamicVariable::operator/=(const DynamicVariable &value)
         case ValueType::Float:
             return *this /= static_cast<FloatType>(value.toFloat());
 
+        case ValueType::BigInteger:
+        case ValueType::Decimal:
+            return assignExact(arithmetic::Operation::Divide, value);
+
+        case ValueType::Timestamp:
+        case ValueType::Duration:
+            return *this = combineTime(arithmetic::Operation::Divide, value);
+
         default:
             throw generateCastException(__func__);
     }
 }
 
-DynamicVariable DynamicVariable::operator/(const DynamicVariable &value) const
+DynamicVariable DynamicVariable::operator/(const DynamicVariable &value) const &
 {
     switch(value.getValueType())
     {
@@ -447,6 +1077,14 @@ DynamicVariable DynamicVariable::operator/(const DynamicVariable &value) const
         case ValueType::Float:
             return *this / static_cast<FloatType>(value.toFloat());
 
+        case ValueType::BigInteger:
+        case ValueType::Decimal:
+            return combineExact(arithmetic::Operation::Divide, value);
+
+        case ValueType::Timestamp:
+        case ValueType::Duration:
+            return combineTime(arithmetic::Operation::Divide, value);
+
         default:
             throw generateCastException(__func__);
     }
@@ -454,6 +1092,11 @@ DynamicVariable DynamicVariable::operator/(const DynamicVariable &value) const
 
 DynamicVariable &DynamicVariable::operator%=(const DynamicVariable &value)
 {
+    if(value.isType(ValueType::BigInteger) || value.isType(ValueType::Decimal))
+    {
+        return assignExact(arithmetic::Operation::Modulo, value);
+    }
+
     if(!value.isType(ValueType::Integer))
     {
         throw generateCastException(__func__);
@@ -462,8 +1105,13 @@ DynamicVariable &DynamicVariable::operator%=(const DynamicVariable &value)
     return *this %= static_cast<IntType>(value.toInteger());
 }
 
-DynamicVariable DynamicVariable::operator%(const DynamicVariable &value) const
+DynamicVariable DynamicVariable::operator%(const DynamicVariable &value) const &
 {
+    if(value.isType(ValueType::BigInteger) || value.isType(ValueType::Decimal))
+    {
+        return combineExact(arithmetic::Operation::Modulo, value);
+    }
+
     if(!value.isType(ValueType::Integer))
     {
         throw generateCastException(__func__);
@@ -472,6 +1120,260 @@ DynamicVariable DynamicVariable::operator%(const DynamicVariable &value) const
     return *this % static_cast<IntType>(value.toInteger());
 }
 
+DynamicVariable DynamicVariable::operator+(StringViewType value) &&
+{
+    if(!isUnique())
+    {
+        return std::as_const(*this) + value;
+    }
+
+    return std::move(*this += value);
+}
+
+DynamicVariable DynamicVariable::operator+(const DynamicVariable &value) &&
+{
+    if(!isUnique())
+    {
+        return std::as_const(*this) + value;
+    }
+
+    return std::move(*this += value);
+}
+
+DynamicVariable DynamicVariable::operator-(const DynamicVariable &value) &&
+{
+    if(!isUnique())
+    {
+        return std::as_const(*this) - value;
+    }
+
+    return std::move(*this -= value);
+}
+
+DynamicVariable DynamicVariable::operator*(const DynamicVariable &value) &&
+{
+    if(!isUnique())
+    {
+        return std::as_const(*this) * value;
+    }
+
+    return std::move(*this *= value);
+}
+
+DynamicVariable DynamicVariable::operator/(const DynamicVariable &value) &&
+{
+    if(!isUnique())
+    {
+        return std::as_const(*this) / value;
+    }
+
+    return std::move(*this /= value);
+}
+
+DynamicVariable DynamicVariable::operator%(const DynamicVariable &value) &&
+{
+    if(!isUnique())
+    {
+        return std::as_const(*this) % value;
+    }
+
+    return std::move(*this %= value);
+}
+
+template<arithmetic::Operation O>
+DynamicVariable DynamicVariable::combine(const DynamicVariable &value,
+                                         ArithmeticPolicy policy) const
+{
+    if(!isType(ValueType::Integer) || !value.isType(ValueType::Integer))
+    {
+        if constexpr(O == arithmetic::Operation::Add)
+        {
+            return *this + value;
+        }
+        else if constexpr(O == arithmetic::Operation::Subtract)
+        {
+            return *this - value;
+        }
+        else if constexpr(O == arithmetic::Operation::Multiply)
+        {
+            return *this * value;
+        }
+        else if constexpr(O == arithmetic::Operation::Divide)
+        {
+            return *this / value;
+        }
+        else
+        {
+            return *this % value;
+        }
+    }
+
+    auto rhs = static_cast<IntType>(value.toInteger());
+    switch(policy)
+    {
+        case ArithmeticPolicy::Checked:
+            return combineInteger<O, ArithmeticPolicy::Checked>(rhs);
+
+        case ArithmeticPolicy::Saturate:
+            return combineInteger<O, ArithmeticPolicy::Saturate>(rhs);
+
+        case ArithmeticPolicy::PromoteToFloat:
+            return combineInteger<O, ArithmeticPolicy::PromoteToFloat>(rhs);
+
+        case ArithmeticPolicy::PromoteToBigInteger:
+            return combineInteger<O, ArithmeticPolicy::PromoteToBigInteger>(rhs);
+
+        default:
+            return combineInteger<O, ArithmeticPolicy::Wrap>(rhs);
+    }
+}
+
+DynamicVariable DynamicVariable::combineExact(arithmetic::Operation operation,
+                                              const DynamicVariable &value) const
+{
+    ValueType lhsType = getValueType();
+    ValueType rhsType = value.getValueType();
+    bool real = lhsType == ValueType::Float || rhsType == ValueType::Float;
+    if(!isNumber(lhsType) || !isNumber(rhsType) ||
+       (real && operation == arithmetic::Operation::Modulo))
+    {
+        throw generateCastException(__func__);
+    }
+
+    const AbstractValue *lhs = m_value.get();
+    const AbstractValue *rhs = value.m_value.get();
+    if(real)
+    {
+        return DynamicVariable(calculate(operation, numberOf(lhs), numberOf(rhs)));
+    }
+
+    if(lhsType == ValueType::Decimal || rhsType == ValueType::Decimal)
+    {
+        return DynamicVariable(calculate(operation, decimalOf(lhs), decimalOf(rhs)));
+    }
+
+    return narrowed(calculate(operation, bigIntegerOf(lhs), bigIntegerOf(rhs)));
+}
+
+DynamicVariable &DynamicVariable::assignExact(arithmetic::Operation operation,
+                                              const DynamicVariable &value)
+{
+    if(isType(ValueType::Decimal) &&
+       (value.isType(ValueType::Decimal) || value.isType(ValueType::Integer)))
+    {
+        auto &node = static_cast<DecimalValue &>(*m_value);
+        node = calculate(operation, node, decimalOf(value.m_value.get()));
+        return *this;
+    }
+
+    return *this = combineExact(operation, value);
+}
+
+DynamicVariable DynamicVariable::combineTime(arithmetic::Operation operation,
+                                             const DynamicVariable &value) const
+{
+    ValueType lhsType = getValueType();
+    ValueType rhsType = value.getValueType();
+    switch(operation)
+    {
+        case arithmetic::Operation::Add:
+            if(lhsType == ValueType::Timestamp && rhsType == ValueType::Duration)
+            {
+                return DynamicVariable(toTimestamp() + value.toDuration());
+            }
+
+            if(lhsType == ValueType::Duration && rhsType == ValueType::Timestamp)
+            {
+                return DynamicVariable(toDuration() + value.toTimestamp());
+            }
+
+            if(lhsType == ValueType::Duration && rhsType == ValueType::Duration)
+            {
+                return DynamicVariable(toDuration() + value.toDuration());
+            }
+
+            break;
+
+        case arithmetic::Operation::Subtract:
+            if(lhsType == ValueType::Timestamp && rhsType == ValueType::Duration)
+            {
+                return DynamicVariable(toTimestamp() - value.toDuration());
+            }
+
+            if(lhsType == ValueType::Timestamp && rhsType == ValueType::Timestamp)
+            {
+                return DynamicVariable(toTimestamp() - value.toTimestamp());
+            }
+
+            if(lhsType == ValueType::Duration && rhsType == ValueType::Duration)
+            {
+                return DynamicVariable(toDuration() - value.toDuration());
+            }
+
+            break;
+
+        case arithmetic::Operation::Multiply:
+            if(lhsType == ValueType::Duration && rhsType == ValueType::Integer)
+            {
+                return DynamicVariable(toDuration() * static_cast<IntType>(value.toInteger()));
+            }
+
+            if(lhsType == ValueType::Integer && rhsType == ValueType::Duration)
+            {
+                return DynamicVariable(value.toDuration() * static_cast<IntType>(toInteger()));
+            }
+
+            break;
+
+        case arithmetic::Operation::Divide:
+            if(lhsType == ValueType::Duration && rhsType == ValueType::Integer)
+            {
+                return DynamicVariable(toDuration() / static_cast<IntType>(value.toInteger()));
+            }
+
+            if(lhsType == ValueType::Duration && rhsType == ValueType::Duration)
+            {
+                return DynamicVariable(toDuration() / value.toDuration());
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+    throw generateCastException(__func__);
+}
+
+DynamicVariable DynamicVariable::add(const DynamicVariable &value, ArithmeticPolicy policy) const
+{
+    return combine<arithmetic::Operation::Add>(value, policy);
+}
+
+DynamicVariable DynamicVariable::subtract(const DynamicVariable &value,
+                                          ArithmeticPolicy policy) const
+{
+    return combine<arithmetic::Operation::Subtract>(value, policy);
+}
+
+DynamicVariable DynamicVariable::multiply(const DynamicVariable &value,
+                                          ArithmeticPolicy policy) const
+{
+    return combine<arithmetic::Operation::Multiply>(value, policy);
+}
+
+DynamicVariable DynamicVariable::divide(const DynamicVariable &value,
+                                        ArithmeticPolicy policy) const
+{
+    return combine<arithmetic::Operation::Divide>(value, policy);
+}
+
+DynamicVariable DynamicVariable::modulo(const DynamicVariable &value,
+                                        ArithmeticPolicy policy) const
+{
+    return combine<arithmetic::Operation::Modulo>(value, policy);
+}
+
 DynamicVariable::SizeType DynamicVariable::size() const
 {
     if(isType(ValueType::Array))
@@ -484,6 +1386,11 @@ DynamicVariable::SizeType DynamicVariable::size() const
         return toString().size();
     }
 
+    if(isType(ValueType::Bytes))
+    {
+        return toBytes().size();
+    }
+
     throw generateCastException(__func__);
 }
 
@@ -499,6 +1406,11 @@ bool DynamicVariable::isEmpty() const
         return toString().isEmpty();
     }
 
+    if(isType(ValueType::Bytes))
+    {
+        return toBytes().isEmpty();
+    }
+
     throw generateCastException(__func__);
 }
 
@@ -507,7 +1419,7 @@ DynamicVariable DynamicVariable::operator[](DynamicVariable::SizeType pos)
 {
     if(isType(ValueType::String))
     {
-        return DynamicVariable(StringType(1, toString()[pos]));
+        return DynamicVariable(StringType(1, toString().view()[pos]));
     }
 
     if(isType(ValueType::Array))
@@ -522,7 +1434,7 @@ DynamicVariable DynamicVariable::operator[](DynamicVariable::SizeType pos) const
 {
     if(isType(ValueType::String))
     {
-        return DynamicVariable(StringType(1, toString()[pos]));
+        return DynamicVariable(StringType(1, toString().view()[pos]));
     }
 
     if(isType(ValueType::Array))
@@ -613,6 +1525,17 @@ void DynamicVariable::set(StringViewType key, const DynamicVariable &value)
 
     return toObject().set(key, value.m_value);
 }
+
+void DynamicVariable::set(StringViewType key, DynamicVariable &&value)
+{
+    if(!isType(ValueType::Object))
+    {
+        throw generateCastException(__func__);
+    }
+
+    return toObject().set(key, std::move(value.m_value));
+}
+
 void DynamicVariable::unset(StringViewType key)
 {
     if(!isType(ValueType::Object))
@@ -623,8 +1546,20 @@ void DynamicVariable::unset(StringViewType key)
     return toObject().unset(key);
 }
 
+void DynamicVariable::set(DynamicVariable::SizeType pos, const DynamicVariable &value)
+{
+    toArray().set(pos, value.m_value);
+}
+
+void DynamicVariable::set(DynamicVariable::SizeType pos, DynamicVariable &&value)
+{
+    toArray().set(pos, std::move(value.m_value));
+}
+
 void DynamicVariable::push(const DynamicVariable &value) { toArray().push(value.m_value); }
 
+void DynamicVariable::push(DynamicVariable &&value) { toArray().push(std::move(value.m_value)); }
+
 DynamicVariable DynamicVariable::pop() { return toArray().pop(); }
 
 void DynamicVariable::insert(const DynamicVariable &value, DynamicVariable::SizeType pos)
@@ -632,6 +1567,11 @@ void DynamicVariable::insert(const DynamicVariable &value, DynamicVariable::Size
     toArray().insert(value.m_value, pos);
 }
 
+void DynamicVariable::insert(DynamicVariable &&value, DynamicVariable::SizeType pos)
+{
+    toArray().insert(std::move(value.m_value), pos);
+}
+
 DynamicVariable DynamicVariable::removeAt(DynamicVariable::SizeType pos)
 {
     return toArray().removeAt(pos);
@@ -660,3 +1600,205 @@ DynamicVariable DynamicVariable::subString(DynamicVariable::SizeType from,
 {
     return toString().subString(from, count);
 }
+
+DynamicVariable::StringViewType DynamicVariable::view() const { return toString().view(); }
+
+DynamicVariable::SizeType DynamicVariable::length() const { return toString().length(); }
+
+DynamicVariable::StringViewType DynamicVariable::charAt(DynamicVariable::SizeType pos) const
+{
+    return toString().charAt(pos);
+}
+
+utf8::CodePointRange<DynamicVariable::StringType::value_type> DynamicVariable::codePoints() const
+{
+    return toString().codePoints();
+}
+
+DynamicVariable DynamicVariable::substr(DynamicVariable::SizeType from,
+                                        DynamicVariable::SizeType count)
+{
+    return toString().substr(from, count);
+}
+
+DynamicVariable DynamicVariable::slice(DynamicVariable::SizeType from,
+                                       DynamicVariable::SizeType count) const
+{
+    return toBytes().slice(from, count);
+}
+
+namespace
+{
+    struct HashFrame
+    {
+        const AbstractValue *value;
+        std::vector<std::pair<uint64_t, const AbstractValue *>> children;
+        DynamicVariable::SizeType next;
+        uint64_t state;
+    };
+
+    uint64_t hashScalar(const AbstractValue *value)
+    {
+        if(value == nullptr)
+        {
+            return hash::integer(static_cast<uint64_t>(ValueType::None));
+        }
+
+        ValueType type = value->getValueType();
+        uint64_t seed = hash::integer(static_cast<uint64_t>(type));
+        switch(type)
+        {
+            case ValueType::Boolean:
+                return hash::combine(seed,
+                                     static_cast<bool>(static_cast<const BoolValue &>(*value)));
+
+            case ValueType::Integer:
+                return hash::combine(seed,
+                                     static_cast<uint64_t>(static_cast<DynamicVariable::IntType>(
+                                       static_cast<const IntValue &>(*value))));
+
+            case ValueType::Float:
+            {
+                auto number = static_cast<DynamicVariable::FloatType>(
+                  static_cast<const FloatValue &>(*value));
+                if(number == 0)
+                {
+                    number = 0;
+                }
+                else if(std::isnan(number))
+                {
+                    number = std::numeric_limits<DynamicVariable::FloatType>::quiet_NaN();
+                }
+
+                return hash::combine(seed, hash::bytes(&number, sizeof(number)));
+            }
+
+            case ValueType::String:
+                return static_cast<const StringValue &>(*value).hash();
+
+            case ValueType::BigInteger:
+            {
+                const auto &number = static_cast<const BigIntegerValue &>(*value);
+                const BigIntegerValue::LimbsType &limbs = number.limbs();
+                return hash::combine(hash::combine(seed, number.isNegative()),
+                                     hash::bytes(limbs.data(), limbs.size() * sizeof(limbs[0])));
+            }
+
+            case ValueType::Decimal:
+            {
+                DecimalValue number = static_cast<const DecimalValue &>(*value).normalized();
+                return hash::combine(hash::combine(seed, number.scale()),
+                                     static_cast<uint64_t>(number.coefficient()));
+            }
+
+            case ValueType::Bytes:
+                return hash::combine(seed, static_cast<const BytesValue &>(*value).hash());
+
+            case ValueType::Timestamp:
+                return hash::combine(
+                  seed, static_cast<uint64_t>(static_cast<const TimestampValue &>(*value).count()));
+
+            case ValueType::Duration:
+                return hash::combine(
+                  seed, static_cast<uint64_t>(static_cast<const DurationValue &>(*value).count()));
+
+            default:
+                return hash::combine(seed, reinterpret_cast<uintptr_t>(value));
+        }
+    }
+
+    HashFrame makeHashFrame(const AbstractValue *value)
+    {
+        HashFrame frame { value, {}, 0, 0 };
+        if(value->isType(ValueType::Array))
+        {
+            const auto &arr = static_cast<const AbstractArrayValue &>(*value);
+            frame.children.reserve(arr.size());
+            for(DynamicVariable::SizeType i = 0, imax = arr.size(); i < imax; ++i)
+            {
+                frame.children.emplace_back(0, arr[i].get());
+            }
+
+            frame.state = hash::integer(static_cast<uint64_t>(ValueType::Array));
+        }
+        else
+        {
+            const auto &obj = static_cast<const AbstractObjectValue &>(*value);
+            frame.children.reserve(obj.size());
+            obj.forEach(
+              [&frame](DynamicVariable::StringViewType key, const AbstractValue::Ptr &child) {
+                  frame.children.emplace_back(
+                    hash::bytes(key.data(), key.size() * sizeof(key[0])), child.get());
+              });
+        }
+
+        return frame;
+    }
+
+    void foldHash(HashFrame &frame, uint64_t value)
+    {
+        if(frame.value == nullptr)
+        {
+            frame.state = value;
+        }
+        else if(frame.value->isType(ValueType::Array))
+        {
+            frame.state = hash::combine(frame.state, value);
+        }
+        else
+        {
+            frame.state += hash::mix(frame.children[frame.next - 1].first ^ hash::SECRET[0],
+                                     value ^ hash::SECRET[1]);
+        }
+    }
+
+    uint64_t finishHash(const HashFrame &frame)
+    {
+        if(frame.value == nullptr)
+        {
+            return frame.state;
+        }
+
+        uint64_t seed = hash::integer(static_cast<uint64_t>(frame.value->getValueType()));
+        return hash::combine(seed ^ frame.children.size(), frame.state);
+    }
+} // namespace
+
+uint64_t DynamicVariable::hash() const
+{
+    if(!m_value || (!isType(ValueType::Array) && !isType(ValueType::Object)))
+    {
+        return hashScalar(m_value.get());
+    }
+
+    std::vector<HashFrame> stack;
+    stack.push_back(HashFrame { nullptr, { { 0, m_value.get() } }, 0, 0 });
+    for(;;)
+    {
+        HashFrame &top = stack.back();
+        if(top.next < top.children.size())
+        {
+            const AbstractValue *child = top.children[top.next++].second;
+            if(child != nullptr &&
+               (child->isType(ValueType::Array) || child->isType(ValueType::Object)))
+            {
+                stack.push_back(makeHashFrame(child));
+            }
+            else
+            {
+                foldHash(top, hashScalar(child));
+            }
+
+            continue;
+        }
+
+        uint64_t result = finishHash(top);
+        stack.pop_back();
+        if(stack.empty())
+        {
+            return result;
+        }
+
+        foldHash(stack.back(), result);
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef FDVAR_ARITHMETICPOLICY_TEST_H
+#define FDVAR_ARITHMETICPOLICY_TEST_H
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include <FDVar/ArithmeticPolicy.h>
+#include <FDVar/DynamicVariable.h>
+#include <gtest/gtest.h>
+
+TEST(ArithmeticPolicy_test, test_kernels)
+{
+    using namespace FDVar::arithmetic;
+    using FDVar::ArithmeticPolicy;
+    constexpr int64_t max = std::numeric_limits<int64_t>::max();
+    constexpr int64_t min = std::numeric_limits<int64_t>::min();
+
+    int64_t result = 0;
+    ASSERT_FALSE(overflow<Operation::Add>(int64_t(2), int64_t(3), result));
+    ASSERT_EQ(result, 5);
+    ASSERT_TRUE(overflow<Operation::Add>(max, int64_t(1), result));
+    ASSERT_EQ(result, min);
+    ASSERT_TRUE(overflow<Operation::Subtract>(min, int64_t(1), result));
+    ASSERT_TRUE(overflow<Operation::Multiply>(max / 2 + 1, int64_t(2), result));
+    ASSERT_TRUE(overflow<Operation::Divide>(min, int64_t(-1), result));
+    ASSERT_FALSE(overflow<Operation::Modulo>(min, int64_t(-1), result));
+    ASSERT_EQ(result, 0);
+
+    ASSERT_EQ((apply<ArithmeticPolicy::Wrap, Operation::Add>(max, int64_t(1))), min);
+    ASSERT_EQ((apply<ArithmeticPolicy::Wrap, Operation::Multiply>(int64_t(-4), int64_t(5))), -20);
+    ASSERT_EQ((apply<ArithmeticPolicy::Wrap, Operation::Divide>(min, int64_t(-1))), min);
+    ASSERT_EQ((apply<ArithmeticPolicy::Wrap, Operation::Modulo>(min, int64_t(-1))), 0);
+    ASSERT_EQ((apply<ArithmeticPolicy::Wrap, Operation::Divide>(int64_t(7), int64_t(-1))), -7);
+    ASSERT_THROW((apply<ArithmeticPolicy::Checked, Operation::Add>(max, int64_t(1))),
+                 std::overflow_error);
+    ASSERT_THROW((apply<ArithmeticPolicy::Checked, Operation::Divide>(int64_t(1), int64_t(0))),
+                 std::domain_error);
+    ASSERT_EQ((apply<ArithmeticPolicy::Saturate, Operation::Add>(max, int64_t(1))), max);
+    ASSERT_EQ((apply<ArithmeticPolicy::Saturate, Operation::Subtract>(min, int64_t(1))), min);
+    ASSERT_EQ((apply<ArithmeticPolicy::Saturate, Operation::Multiply>(max, int64_t(-2))), min);
+    ASSERT_EQ((apply<ArithmeticPolicy::Saturate, Operation::Divide>(min, int64_t(-1))), max);
+
+    double real = 0;
+    ASSERT_TRUE(promote<Operation::Multiply>(int64_t(6), int64_t(7), result, real));
+    ASSERT_EQ(result, 42);
+    ASSERT_FALSE(promote<Operation::Multiply>(max, int64_t(4), result, real));
+    ASSERT_DOUBLE_EQ(real, static_cast<double>(max) * 4);
+}
+
+TEST(ArithmeticPolicy_test, test_dynamic_variable)
+{
+    using FDVar::ArithmeticPolicy;
+    using FDVar::DynamicVariable;
+    constexpr int64_t max = std::numeric_limits<int64_t>::max();
+
+    DynamicVariable big(max);
+    DynamicVariable one(1);
+    if constexpr(FDVar::DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::Wrap)
+    {
+        ASSERT_EQ(big + one, std::numeric_limits<int64_t>::min());
+    }
+    else if constexpr(FDVar::DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::PromoteToBigInteger)
+    {
+        ASSERT_TRUE((big + one).isType(FDVar::ValueType::BigInteger));
+        ASSERT_EQ(big + one - one, max);
+    }
+
+    ASSERT_EQ(big.add(one, ArithmeticPolicy::Wrap), std::numeric_limits<int64_t>::min());
+    ASSERT_THROW(big.add(one, ArithmeticPolicy::Checked), std::overflow_error);
+    ASSERT_EQ(big.add(one, ArithmeticPolicy::Saturate), max);
+
+    DynamicVariable promoted = big.multiply(DynamicVariable(2), ArithmeticPolicy::PromoteToFloat);
+    ASSERT_TRUE(promoted.isType(FDVar::ValueType::Float));
+    ASSERT_DOUBLE_EQ(static_cast<double>(promoted), static_cast<double>(max) * 2);
+
+    DynamicVariable small = one.add(one, ArithmeticPolicy::PromoteToFloat);
+    ASSERT_TRUE(small.isType(FDVar::ValueType::Integer));
+    ASSERT_EQ(small, 2);
+
+    ASSERT_THROW(one.divide(DynamicVariable(0), ArithmeticPolicy::Checked), std::domain_error);
+    ASSERT_THROW(one.modulo(DynamicVariable(0), ArithmeticPolicy::Saturate), std::domain_error);
+    ASSERT_EQ(DynamicVariable(7).modulo(DynamicVariable(4), ArithmeticPolicy::Checked), 3);
+    ASSERT_EQ(one.add(DynamicVariable(0.5), ArithmeticPolicy::Checked), 1.5);
+
+    DynamicVariable lowest(std::numeric_limits<int64_t>::min());
+    DynamicVariable minusOne(-1);
+    ASSERT_EQ(lowest.divide(minusOne, ArithmeticPolicy::Wrap), lowest);
+    ASSERT_EQ(lowest.modulo(minusOne, ArithmeticPolicy::Wrap), 0);
+    ASSERT_THROW(lowest.divide(minusOne, ArithmeticPolicy::Checked), std::overflow_error);
+    if constexpr(FDVar::DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::Wrap)
+    {
+        ASSERT_EQ(lowest / minusOne, lowest);
+        ASSERT_EQ(lowest % minusOne, 0);
+    }
+}
+
+#endif // FDVAR_ARITHMETICPOLICY_TEST_H
@@ -0,0 +1,181 @@
+#ifndef FDVAR_ARRAYINDEX_TEST_H
+#define FDVAR_ARRAYINDEX_TEST_H
+
+#include <FDVar/ArrayIndex.h>
+#include <FDVar/BigIntegerValue.h>
+#include <FDVar/DecimalValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    FDVar::DynamicVariable indexedUser(int id, const char *name, int age)
+    {
+        using FDVar::DynamicVariable;
+        DynamicVariable user(FDVar::ValueType::Object);
+        user.set("id", DynamicVariable(id));
+        user.set("name", DynamicVariable(DynamicVariable::StringType(name)));
+        user.set("age", DynamicVariable(age));
+        return user;
+    }
+} // namespace
+
+TEST(ArrayIndex_test, test_hash_lookup)
+{
+    using FDVar::ArrayIndex;
+    using FDVar::DynamicVariable;
+    DynamicVariable users(FDVar::ValueType::Array);
+    users.push(indexedUser(1, "ann", 30));
+    users.push(indexedUser(2, "bob", 25));
+    users.push(indexedUser(3, "cid", 30));
+    users.push(DynamicVariable(7));
+
+    ArrayIndex byName(users, "name");
+    ASSERT_EQ(byName.size(), 3);
+    DynamicVariable bob(DynamicVariable::StringType("bob"));
+    DynamicVariable eve(DynamicVariable::StringType("eve"));
+    ASSERT_EQ(byName.find(bob)["id"], 2);
+    ASSERT_TRUE(byName.find(eve).isType(FDVar::ValueType::None));
+
+    ArrayIndex byAge(users, "/age");
+    ASSERT_EQ(byAge.count(DynamicVariable(30)), 2);
+    ASSERT_EQ(byAge.findAll(DynamicVariable(30)).size(), 2);
+    ASSERT_EQ(byAge.findAll(DynamicVariable(99)).size(), 0);
+    ASSERT_EQ(byAge.count(DynamicVariable(30.0)), 2);
+    ASSERT_EQ(byAge.count(DynamicVariable(30.5)), 0);
+
+    ASSERT_THROW(ArrayIndex(DynamicVariable(1), "id"), std::invalid_argument);
+    ASSERT_THROW(ArrayIndex(users, "$[*]"), std::invalid_argument);
+    ASSERT_THROW(byAge.range(DynamicVariable(0), DynamicVariable(1)), std::domain_error);
+}
+
+TEST(ArrayIndex_test, test_incremental_updates)
+{
+    using FDVar::ArrayIndex;
+    using FDVar::DynamicVariable;
+    DynamicVariable users(FDVar::ValueType::Array);
+    users.push(indexedUser(1, "ann", 30));
+    users.push(indexedUser(2, "bob", 25));
+
+    ArrayIndex byId(users, "id");
+    users.push(indexedUser(3, "cid", 40));
+    ASSERT_EQ(byId.find(DynamicVariable(3))["name"].view(), "cid");
+
+    users.insert(indexedUser(4, "dan", 20), 0);
+    ASSERT_EQ(byId.size(), 4);
+    ASSERT_EQ(byId.find(DynamicVariable(4))["age"], 20);
+
+    users.removeAt(1);
+    ASSERT_TRUE(byId.find(DynamicVariable(1)).isType(FDVar::ValueType::None));
+    ASSERT_EQ(byId.size(), 3);
+
+    users.set(0, indexedUser(5, "eve", 50));
+    ASSERT_TRUE(byId.find(DynamicVariable(4)).isType(FDVar::ValueType::None));
+    ASSERT_EQ(byId.find(DynamicVariable(5))["name"].view(), "eve");
+
+    users.pop();
+    ASSERT_TRUE(byId.find(DynamicVariable(3)).isType(FDVar::ValueType::None));
+
+    users[0].set("id", DynamicVariable(6));
+    ASSERT_FALSE(byId.find(DynamicVariable(5)).isType(FDVar::ValueType::None));
+    byId.rebuild();
+    ASSERT_TRUE(byId.find(DynamicVariable(5)).isType(FDVar::ValueType::None));
+    ASSERT_EQ(byId.find(DynamicVariable(6))["name"].view(), "eve");
+
+    users.clear();
+    ASSERT_EQ(byId.size(), 0);
+}
+
+TEST(ArrayIndex_test, test_sorted_range)
+{
+    using FDVar::ArrayIndex;
+    using FDVar::DynamicVariable;
+    DynamicVariable users(FDVar::ValueType::Array);
+    int ages[] = { 41, 17, 29, 35, 29, 60 };
+    for(int i = 0; i < 6; ++i)
+    {
+        users.push(indexedUser(i, "user", ages[i]));
+    }
+
+    ArrayIndex byAge(users, "$.age", ArrayIndex::Kind::Sorted);
+    auto adults = byAge.range(DynamicVariable(18), DynamicVariable(41));
+    ASSERT_EQ(adults.size(), 4);
+    ASSERT_EQ(adults[0]["age"], 29);
+    ASSERT_EQ(adults[1]["age"], 29);
+    ASSERT_EQ(adults[2]["age"], 35);
+    ASSERT_EQ(adults[3]["age"], 41);
+    ASSERT_EQ(byAge.range(DynamicVariable(50), DynamicVariable(40)).size(), 0);
+
+    users.removeAt(0);
+    ASSERT_EQ(byAge.range(DynamicVariable(18), DynamicVariable(41)).size(), 3);
+    ASSERT_EQ(byAge.find(DynamicVariable(17))["id"], 1);
+}
+
+TEST(ArrayIndex_test, test_container_keys)
+{
+    using FDVar::ArrayIndex;
+    using FDVar::DynamicVariable;
+    DynamicVariable users(FDVar::ValueType::Array);
+    DynamicVariable tags(FDVar::ValueType::Array);
+    tags.push(DynamicVariable(1));
+    DynamicVariable user(FDVar::ValueType::Object);
+    user.set("tags", tags);
+    users.push(user);
+
+    ArrayIndex byTags(users, "tags");
+    ArrayIndex sortedByTags(users, "tags", ArrayIndex::Kind::Sorted);
+    tags.push(DynamicVariable(2));
+    ASSERT_EQ(users[0]["tags"].size(), 2);
+
+    DynamicVariable original(FDVar::ValueType::Array);
+    original.push(DynamicVariable(1));
+    ASSERT_EQ(byTags.count(original), 1);
+    ASSERT_EQ(sortedByTags.count(original), 1);
+    ASSERT_EQ(byTags.count(tags), 0);
+
+    users.removeAt(0);
+    ASSERT_EQ(byTags.size(), 0);
+    ASSERT_EQ(byTags.count(original), 0);
+    ASSERT_EQ(sortedByTags.size(), 0);
+    ASSERT_EQ(sortedByTags.count(original), 0);
+}
+TEST(ArrayIndex_test, test_numeric_keys)
+{
+    using FDVar::DecimalValue;
+    using FDVar::DynamicVariable;
+    DynamicVariable ids({ DynamicVariable(1), DynamicVariable(2.0),
+                          DynamicVariable(DecimalValue::parse("3.00")),
+                          DynamicVariable(FDVar::BigIntegerValue(4)), DynamicVariable(2.5),
+                          DynamicVariable(DynamicVariable::IntType(9007199254740993)) });
+    DynamicVariable rows(FDVar::ValueType::Array);
+    for(FDVar::DynamicVariable::SizeType i = 0; i < ids.size(); ++i)
+    {
+        DynamicVariable row(FDVar::ValueType::Object);
+        row.set("id", ids[i]);
+        rows.push(row);
+    }
+
+    for(auto kind: { FDVar::ArrayIndex::Kind::Hash, FDVar::ArrayIndex::Kind::Sorted })
+    {
+        FDVar::ArrayIndex index(rows, "id", kind);
+        ASSERT_TRUE(index.find(DynamicVariable(1.0)) == rows[0]);
+        ASSERT_TRUE(index.find(DynamicVariable(DecimalValue::parse("1.0"))) == rows[0]);
+        ASSERT_TRUE(index.find(DynamicVariable(2)) == rows[1]);
+        ASSERT_TRUE(index.find(DynamicVariable(3)) == rows[2]);
+        ASSERT_TRUE(index.find(DynamicVariable(4.0)) == rows[3]);
+        ASSERT_TRUE(index.find(DynamicVariable(DecimalValue::parse("2.50"))) == rows[4]);
+        ASSERT_EQ(index.count(DynamicVariable(9007199254740992.0)), 0U);
+        ASSERT_EQ(index.count(DynamicVariable(FDVar::BigIntegerValue(9007199254740993))), 1U);
+        ASSERT_EQ(index.findAll(DynamicVariable(DecimalValue::parse("4"))).size(), 1U);
+        ASSERT_TRUE(index.find(DynamicVariable(5)).isType(FDVar::ValueType::None));
+    }
+
+    FDVar::ArrayIndex sorted(rows, "id", FDVar::ArrayIndex::Kind::Sorted);
+    DynamicVariable middle = sorted.range(DynamicVariable(2), DynamicVariable(3.0));
+    ASSERT_EQ(middle.size(), 3U);
+    ASSERT_TRUE(middle[0] == rows[1]);
+    ASSERT_TRUE(middle[1] == rows[4]);
+    ASSERT_TRUE(middle[2] == rows[2]);
+}
+
+#endif // FDVAR_ARRAYINDEX_TEST_H
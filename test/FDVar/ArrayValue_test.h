@@ -142,6 +142,28 @@ TEST(ArrayValue_test, test_member_functions)
     ASSERT_TRUE(value.isEmpty());
 }
 
+TEST(ArrayValue_test, test_deep_destruction)
+{
+    std::weak_ptr<FDVar::AbstractValue> leaf;
+    {
+        FDVar::AbstractValue::Ptr root(new FDVar::ArrayValue());
+        FDVar::AbstractValue::Ptr current = root;
+        for(size_t i = 0; i < 500000; ++i)
+        {
+            FDVar::AbstractValue::Ptr child(new FDVar::ArrayValue());
+            static_cast<FDVar::ArrayValue &>(*current).push(child);
+            current = child;
+        }
+
+        static_cast<FDVar::ArrayValue &>(*current).push(
+          FDVar::AbstractValue::Ptr(new FDVar::IntValue(42)));
+        leaf = static_cast<FDVar::ArrayValue &>(*current)[0];
+        current.reset();
+    }
+
+    ASSERT_TRUE(leaf.expired());
+}
+
 TEST(CustomArrayValue_test, test_constructors)
 {
     ASSERT_TRUE(CustomArrayValue().isEmpty());
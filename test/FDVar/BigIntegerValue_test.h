@@ -0,0 +1,139 @@
+#ifndef FDVAR_BIGINTEGERVALUE_TEST_H
+#define FDVAR_BIGINTEGERVALUE_TEST_H
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <FDVar/BigIntegerValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/JsonWriter.h>
+#include <gtest/gtest.h>
+
+TEST(BigIntegerValue_test, test_parse)
+{
+    using FDVar::BigIntegerValue;
+
+    ASSERT_EQ(BigIntegerValue::parse("0").toString(), "0");
+    ASSERT_EQ(BigIntegerValue::parse("-0").toString(), "0");
+    ASSERT_EQ(BigIntegerValue::parse("+42").toString(), "42");
+    ASSERT_EQ(BigIntegerValue::parse("000123").toString(), "123");
+
+    std::string digits = "-123456789012345678901234567890123456789012345678901234567890";
+    BigIntegerValue value = BigIntegerValue::parse(digits);
+    ASSERT_TRUE(value.isNegative());
+    ASSERT_FALSE(value.fitsInteger());
+    ASSERT_EQ(value.toString(), digits);
+    ASSERT_THROW(value.toInteger(), std::overflow_error);
+
+    BigIntegerValue min(std::numeric_limits<int64_t>::min());
+    ASSERT_TRUE(min.fitsInteger());
+    ASSERT_EQ(min.toInteger(), std::numeric_limits<int64_t>::min());
+    ASSERT_EQ(min.toString(), "-9223372036854775808");
+
+    ASSERT_THROW(BigIntegerValue::parse(""), std::invalid_argument);
+    ASSERT_THROW(BigIntegerValue::parse("-"), std::invalid_argument);
+    ASSERT_THROW(BigIntegerValue::parse("12a"), std::invalid_argument);
+}
+
+TEST(BigIntegerValue_test, test_arithmetic)
+{
+    using FDVar::BigIntegerValue;
+
+    BigIntegerValue a = BigIntegerValue::parse("340282366920938463463374607431768211456");
+    BigIntegerValue b = BigIntegerValue::parse("18446744073709551616");
+    ASSERT_EQ((a + b).toString(), "340282366920938463481821351505477763072");
+    ASSERT_EQ((b - a).toString(), "-340282366920938463444927863358058659840");
+    ASSERT_EQ((a * b).toString(), "6277101735386680763835789423207666416102355444464034512896");
+    ASSERT_EQ((a / b).toString(), "18446744073709551616");
+    ASSERT_EQ((a % b).toString(), "0");
+
+    BigIntegerValue c = BigIntegerValue::parse("-1000000000000000000000007");
+    BigIntegerValue d(1000000007);
+    ASSERT_EQ((c / d).toString(), "-999999993000000");
+    ASSERT_EQ((c % d).toString(), "-49000007");
+    ASSERT_EQ(c / d * d + c % d, c);
+
+    ASSERT_LT(c, d);
+    ASSERT_GT(a, b);
+    ASSERT_EQ(-(-a), a);
+    ASSERT_THROW(a / BigIntegerValue(), std::domain_error);
+}
+
+TEST(BigIntegerValue_test, test_karatsuba)
+{
+    using FDVar::BigIntegerValue;
+
+    // Operands well above the Karatsuba threshold, checked against division and against the
+    // digit pattern of (10^n - 1)^2 = 10^2n - 2 * 10^n + 1.
+    std::string nines(1200, '9');
+    BigIntegerValue a = BigIntegerValue::parse(nines);
+    BigIntegerValue square = a * a;
+    ASSERT_EQ(square.toString(), std::string(1199, '9') + "8" + std::string(1199, '0') + "1");
+    ASSERT_EQ(square / a, a);
+    ASSERT_TRUE((square % a).isZero());
+
+    BigIntegerValue b = BigIntegerValue::parse("-" + std::string(700, '7') + "3");
+    BigIntegerValue product = a * b;
+    ASSERT_EQ(product / b, a);
+    ASSERT_EQ(product / a, b);
+    ASSERT_EQ((product - BigIntegerValue(5)) % a, BigIntegerValue(-5));
+}
+
+TEST(BigIntegerValue_test, test_dynamic_variable)
+{
+    using FDVar::ArithmeticPolicy;
+    using FDVar::BigIntegerValue;
+    using FDVar::DynamicVariable;
+    using FDVar::ValueType;
+    constexpr int64_t max = std::numeric_limits<int64_t>::max();
+
+    DynamicVariable big(max);
+    DynamicVariable sum = big.add(DynamicVariable(1), ArithmeticPolicy::PromoteToBigInteger);
+    ASSERT_TRUE(sum.isType(ValueType::BigInteger));
+    ASSERT_EQ(sum, uint64_t(max) + 1);
+    ASSERT_GT(sum, max);
+    ASSERT_NE(sum, max);
+    ASSERT_GT(sum, 1e18);
+
+    DynamicVariable back = sum - 1;
+    ASSERT_TRUE(back.isType(ValueType::Integer));
+    ASSERT_EQ(back, max);
+
+    DynamicVariable square = sum * sum;
+    ASSERT_TRUE(square.isType(ValueType::BigInteger));
+    ASSERT_EQ(square / sum, sum);
+    ASSERT_EQ(square % DynamicVariable(7), 1);
+    ASSERT_EQ(DynamicVariable(3) + sum, sum + 3);
+    ASSERT_EQ(-sum + sum, 0);
+    ASSERT_DOUBLE_EQ(static_cast<double>(sum * 0.5), 4611686018427387904.0);
+    ASSERT_THROW(static_cast<int64_t>(sum), std::overflow_error);
+    ASSERT_THROW(sum / 0, std::domain_error);
+    ASSERT_THROW(sum % DynamicVariable(1.5), std::runtime_error);
+
+    DynamicVariable accumulated(1);
+    for(int i = 0; i < 30; ++i)
+    {
+        accumulated = accumulated.multiply(DynamicVariable(1000),
+                                           ArithmeticPolicy::PromoteToBigInteger);
+    }
+
+    std::ostringstream stream;
+    stream << accumulated;
+    ASSERT_EQ(stream.str(), "1" + std::string(90, '0'));
+
+    ASSERT_LT(DynamicVariable(max), sum);
+    ASSERT_EQ(-sum, std::numeric_limits<int64_t>::min());
+    ASSERT_LT(-square, DynamicVariable(std::numeric_limits<int64_t>::min()));
+    ASSERT_LT(DynamicVariable(1e30), accumulated);
+    ASSERT_EQ(DynamicVariable(sum).hash(), sum.hash());
+    ASSERT_EQ(DynamicVariable(BigIntegerValue::parse("5")), DynamicVariable(BigIntegerValue(5)));
+
+    FDVar::JsonWriter writer;
+    writer.value(DynamicVariable({ sum, DynamicVariable(1) }));
+    ASSERT_EQ(writer.str(), "[9223372036854775808,1]");
+}
+
+#endif // FDVAR_BIGINTEGERVALUE_TEST_H
@@ -0,0 +1,100 @@
+#ifndef FDVAR_BYTESVALUE_TEST_H
+#define FDVAR_BYTESVALUE_TEST_H
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <FDVar/BytesValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/JsonWriter.h>
+#include <gtest/gtest.h>
+
+TEST(BytesValue_test, test_slice)
+{
+    using FDVar::BytesValue;
+
+    BytesValue bytes(std::vector<uint8_t> { 0, 1, 2, 3, 4, 5, 6, 7 });
+    ASSERT_EQ(bytes.size(), 8);
+    ASSERT_EQ(bytes[3], 3);
+    ASSERT_THROW(bytes.at(8), std::out_of_range);
+
+    BytesValue middle = bytes.slice(2, 4);
+    ASSERT_EQ(middle.size(), 4);
+    ASSERT_EQ(middle.data(), bytes.data() + 2);
+    ASSERT_EQ(middle.buffer(), bytes.buffer());
+    ASSERT_EQ(middle, BytesValue("\x02\x03\x04\x05", 4));
+
+    BytesValue inner = middle.slice(1);
+    ASSERT_EQ(inner.offset(), 3);
+    ASSERT_EQ(inner.size(), 3);
+    ASSERT_EQ(std::vector<uint8_t>(inner.begin(), inner.end()), std::vector<uint8_t>({ 3, 4, 5 }));
+    ASSERT_TRUE(middle.slice(4).isEmpty());
+    ASSERT_THROW(middle.slice(5), std::out_of_range);
+
+    ASSERT_LT(BytesValue("ab"), BytesValue("abc"));
+    ASSERT_LT(BytesValue("abc"), BytesValue("b"));
+    ASSERT_EQ(BytesValue(), BytesValue(""));
+    ASSERT_EQ(BytesValue("abc").hash(), BytesValue("xabc").slice(1).hash());
+}
+
+TEST(BytesValue_test, test_adopt)
+{
+    using FDVar::BytesValue;
+
+    int released = 0;
+    auto *storage = new uint8_t[4] { 'd', 'a', 't', 'a' };
+    {
+        BytesValue adopted = BytesValue::adopt(storage, 4, [&released](const uint8_t *data) {
+            ++released;
+            delete[] data;
+        });
+        BytesValue tail = adopted.slice(1);
+        adopted = BytesValue();
+        ASSERT_EQ(released, 0);
+        ASSERT_EQ(tail, BytesValue("ata"));
+    }
+
+    ASSERT_EQ(released, 1);
+
+    auto owner = std::make_shared<std::vector<uint8_t>>(std::vector<uint8_t> { 9, 8, 7 });
+    BytesValue shared(owner, owner->data() + 1, 2);
+    owner.reset();
+    ASSERT_EQ(shared, BytesValue("\x08\x07", 2));
+}
+
+TEST(BytesValue_test, test_dynamic_variable)
+{
+    using FDVar::BytesValue;
+    using FDVar::DynamicVariable;
+    using FDVar::ValueType;
+
+    DynamicVariable payload(BytesValue("hello world"));
+    ASSERT_TRUE(payload.isType(ValueType::Bytes));
+    ASSERT_EQ(payload.size(), 11);
+    ASSERT_FALSE(payload.isEmpty());
+    ASSERT_TRUE(DynamicVariable(ValueType::Bytes).isEmpty());
+
+    DynamicVariable copy(payload);
+    ASSERT_EQ(copy.internalValue(), payload.internalValue());
+
+    DynamicVariable word = payload.slice(6);
+    ASSERT_EQ(word, DynamicVariable(BytesValue("world")));
+    ASSERT_EQ(static_cast<const BytesValue &>(word).data(),
+              static_cast<const BytesValue &>(payload).data() + 6);
+    ASSERT_EQ(word.hash(), DynamicVariable(BytesValue("world")).hash());
+    ASSERT_LT(payload, word);
+    ASSERT_NE(payload, DynamicVariable("hello world"));
+
+    ASSERT_THROW(payload.slice(12), std::out_of_range);
+    ASSERT_THROW(DynamicVariable("text").slice(1), std::runtime_error);
+    ASSERT_THROW(payload + 1, std::runtime_error);
+
+    FDVar::JsonWriter writer;
+    writer.value(DynamicVariable({ payload.slice(0, 1), payload.slice(0, 2), payload.slice(0, 3),
+                                   DynamicVariable(BytesValue()) }));
+    ASSERT_EQ(writer.str(), "[\"aA==\",\"aGU=\",\"aGVs\",\"\"]");
+}
+
+#endif // FDVAR_BYTESVALUE_TEST_H
@@ -0,0 +1,142 @@
+#ifndef FDVAR_COLUMNARTABLE_TEST_H
+#define FDVAR_COLUMNARTABLE_TEST_H
+
+#include <stdexcept>
+
+#include <FDVar/ColumnarTable.h>
+#include <FDVar/DynamicVariable.h>
+#include <gtest/gtest.h>
+
+TEST(ColumnarTable_test, test_build)
+{
+    using FDVar::ColumnarTable;
+    using FDVar::DynamicVariable;
+    using Kind = ColumnarTable::Column::Kind;
+    using State = ColumnarTable::Column::State;
+
+    using V = DynamicVariable;
+
+    V rows({ V({ { "id", V(1) }, { "name", V("a") }, { "score", V(2) } }),
+             V({ { "id", V(2) }, { "name", V("b") }, { "score", V(2.5) } }),
+             V({ { "id", V(3) }, { "name", V("a") }, { "ok", V(true) } }),
+             V({ { "id", V(4) }, { "name", V() } }) });
+
+    ColumnarTable table = FDVar::toColumnar(rows);
+    ASSERT_EQ(table.rows(), 4);
+    ASSERT_EQ(table.columns().size(), 4);
+    ASSERT_EQ(table.columns()[0].name(), "id");
+    ASSERT_TRUE(table.contains("ok"));
+    ASSERT_FALSE(table.contains("missing"));
+    ASSERT_THROW(table.column("missing"), std::out_of_range);
+
+    const ColumnarTable::Column &id = table.column("id");
+    ASSERT_EQ(id.kind(), Kind::Integer);
+    ASSERT_EQ(id.integers(), std::vector<int64_t>({ 1, 2, 3, 4 }));
+
+    const ColumnarTable::Column &name = table.column("name");
+    ASSERT_EQ(name.kind(), Kind::String);
+    ASSERT_EQ(name.dictionary().size(), 2);
+    ASSERT_EQ(name.codes()[0], name.codes()[2]);
+    ASSERT_EQ(name.states()[3], State::Null);
+    ASSERT_EQ(name.value(2), V("a"));
+    ASSERT_EQ(name.value(3), nullptr);
+
+    const ColumnarTable::Column &score = table.column("score");
+    ASSERT_EQ(score.kind(), Kind::Float);
+    ASSERT_EQ(score.floats()[0], 2.0);
+    ASSERT_EQ(score.states()[2], State::Missing);
+
+    const ColumnarTable::Column &ok = table.column("ok");
+    ASSERT_EQ(ok.kind(), Kind::Boolean);
+    ASSERT_EQ(ok.states()[0], State::Missing);
+    ASSERT_TRUE(ok.hasValue(2));
+
+    ASSERT_THROW(FDVar::toColumnar(DynamicVariable(1)), std::invalid_argument);
+    ASSERT_THROW(FDVar::toColumnar(V({ V(1), V(2) })), std::invalid_argument);
+    ASSERT_THROW(FDVar::toColumnar(V({ V({ { "x", V(1) } }), V({ { "x", V("1") } }) })),
+                 std::invalid_argument);
+    ASSERT_THROW(FDVar::toColumnar(V({ V({ { "x", V({ V(1) }) } }) })), std::invalid_argument);
+    ASSERT_EQ(FDVar::toColumnar(DynamicVariable(FDVar::ValueType::Array)).rows(), 0);
+}
+
+TEST(ColumnarTable_test, test_filter_and_aggregate)
+{
+    using FDVar::ColumnarTable;
+    using FDVar::DynamicVariable;
+    using Comparison = ColumnarTable::Comparison;
+
+    DynamicVariable rows(FDVar::ValueType::Array);
+    for(int i = 0; i < 100; ++i)
+    {
+        DynamicVariable row({ { "n", DynamicVariable(i) },
+                              { "even", DynamicVariable(i % 2 == 0) },
+                              { "tag", DynamicVariable(i < 10 ? "low" : "high") } });
+        if(i % 10 == 0)
+        {
+            row.unset("n");
+        }
+
+        rows.push(row);
+    }
+
+    ColumnarTable table(rows);
+    ASSERT_EQ(table.count("n"), 90);
+    ASSERT_EQ(table.sum("n"), 4950 - 450);
+    ASSERT_EQ(table.min("n"), 1);
+    ASSERT_EQ(table.max("n"), 99);
+    ASSERT_EQ(table.sum("even"), 50);
+    ASSERT_EQ(table.min("tag"), DynamicVariable("high"));
+
+    ColumnarTable::MaskType low = table.filter("tag", Comparison::Equal, DynamicVariable("low"));
+    ASSERT_EQ(table.count("tag", &low), 10);
+    ASSERT_EQ(table.count("n", &low), 9);
+    ASSERT_EQ(table.sum("n", &low), 45);
+    ASSERT_EQ(table.mean("n", &low), 5.0);
+
+    ColumnarTable::MaskType both =
+      table.filter("even", Comparison::Equal, DynamicVariable(true), &low);
+    ASSERT_EQ(table.sum("n", &both), 2 + 4 + 6 + 8);
+    ASSERT_EQ(table.count("n", &both), 4);
+
+    ColumnarTable::MaskType big = table.filter("n", Comparison::Greater, DynamicVariable(97.5));
+    ASSERT_EQ(table.count("n", &big), 2);
+    ASSERT_EQ(table.filter("n", Comparison::LessEqual, DynamicVariable(3)),
+              table.filter("n", Comparison::Less, DynamicVariable(4)));
+
+    ColumnarTable::MaskType none = table.filter("n", Comparison::Less, DynamicVariable(0));
+    ASSERT_EQ(table.min("n", &none), nullptr);
+    ASSERT_EQ(table.mean("n", &none), nullptr);
+    ASSERT_EQ(table.sum("n", &none), 0);
+
+    ASSERT_THROW(table.filter("tag", Comparison::Equal, DynamicVariable(1)),
+                 std::invalid_argument);
+    ASSERT_THROW(table.filter("n", Comparison::Equal, DynamicVariable("1")),
+                 std::invalid_argument);
+    ASSERT_THROW(table.sum("tag"), std::invalid_argument);
+    ColumnarTable::MaskType shortMask(3, 1);
+    ASSERT_THROW(table.count("n", &shortMask), std::invalid_argument);
+}
+
+TEST(ColumnarTable_test, test_round_trip)
+{
+    using FDVar::ColumnarTable;
+    using FDVar::DynamicVariable;
+
+    using V = DynamicVariable;
+
+    V rows({ V({ { "a", V(1) }, { "b", V("x") } }),
+             V({ { "b", V() }, { "c", V(false) } }),
+             V({ { "a", V(-7) }, { "b", V("x") }, { "c", V(true) } }) });
+
+    ColumnarTable table(rows);
+    ASSERT_EQ(FDVar::fromColumnar(table), rows);
+
+    ColumnarTable::MaskType mask =
+      table.filter("a", ColumnarTable::Comparison::NotEqual, DynamicVariable(1));
+    ASSERT_EQ(FDVar::fromColumnar(table, &mask), DynamicVariable({ rows[2] }));
+
+    DynamicVariable restored = FDVar::fromColumnar(table);
+    ASSERT_NE(restored[0]["b"].internalValue(), restored[2]["b"].internalValue());
+}
+
+#endif // FDVAR_COLUMNARTABLE_TEST_H
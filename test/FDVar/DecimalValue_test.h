@@ -0,0 +1,180 @@
+#ifndef FDVAR_DECIMALVALUE_TEST_H
+#define FDVAR_DECIMALVALUE_TEST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <FDVar/DecimalValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/JsonWriter.h>
+#include <gtest/gtest.h>
+
+TEST(DecimalValue_test, test_parse)
+{
+    using FDVar::DecimalValue;
+
+    DecimalValue price = DecimalValue::parse("19.99");
+    ASSERT_EQ(price.coefficient(), 1999);
+    ASSERT_EQ(price.scale(), 2);
+    ASSERT_EQ(price.toString(), "19.99");
+
+    ASSERT_EQ(DecimalValue::parse("-0.05").toString(), "-0.05");
+    ASSERT_EQ(DecimalValue::parse("+1.50").toString(), "1.50");
+    ASSERT_EQ(DecimalValue::parse("1.5e3").toString(), "1500");
+    ASSERT_EQ(DecimalValue::parse("125E-2").toString(), "1.25");
+    ASSERT_EQ(DecimalValue::parse("7.").toString(), "7");
+    ASSERT_EQ(DecimalValue::parse("-9223372036854775808").coefficient(),
+              std::numeric_limits<int64_t>::min());
+    ASSERT_EQ(DecimalValue::parse("0.000000000000000001").scale(), 18);
+
+    ASSERT_THROW(DecimalValue::parse(""), std::invalid_argument);
+    ASSERT_THROW(DecimalValue::parse("."), std::invalid_argument);
+    ASSERT_THROW(DecimalValue::parse("1.2.3"), std::invalid_argument);
+    ASSERT_THROW(DecimalValue::parse("1e"), std::invalid_argument);
+    ASSERT_THROW(DecimalValue::parse("9223372036854775808"), std::overflow_error);
+    ASSERT_THROW(DecimalValue::parse("0.0000000000000000001"), std::overflow_error);
+}
+
+TEST(DecimalValue_test, test_arithmetic)
+{
+    using FDVar::DecimalValue;
+
+    DecimalValue a = DecimalValue::parse("10.00");
+    DecimalValue b = DecimalValue::parse("3");
+    ASSERT_EQ((a + b).toString(), "13.00");
+    ASSERT_EQ((b - a).toString(), "-7.00");
+    ASSERT_EQ((a * b).toString(), "30.00");
+    ASSERT_EQ((a / b).toString(), "3.33");
+    ASSERT_EQ((a % b).toString(), "1.00");
+    ASSERT_EQ(a.divide(b, 5).toString(), "3.33333");
+    ASSERT_EQ((DecimalValue::parse("0.1") + DecimalValue::parse("0.2")).toString(), "0.3");
+
+    // Half to even, in division and in rescaling.
+    ASSERT_EQ(DecimalValue::parse("2.5").rescale(0).toString(), "2");
+    ASSERT_EQ(DecimalValue::parse("3.5").rescale(0).toString(), "4");
+    ASSERT_EQ(DecimalValue::parse("-2.5").rescale(0).toString(), "-2");
+    ASSERT_EQ(DecimalValue::parse("0.125").divide(DecimalValue(1), 2).toString(), "0.12");
+    ASSERT_EQ(DecimalValue(2).divide(DecimalValue(3), 0).toString(), "1");
+    ASSERT_EQ(DecimalValue::parse("1.5").rescale(3).toString(), "1.500");
+
+    // Operands that only fit once the quotient is scaled past IntType.
+    DecimalValue large = DecimalValue::parse("92233720368547758.07");
+    ASSERT_EQ(large.divide(DecimalValue::parse("92233720368547758.07"), 18).toString(),
+              "1.000000000000000000");
+    ASSERT_THROW(large.divide(DecimalValue::parse("0.5"), 2), std::overflow_error);
+
+    DecimalValue precise = DecimalValue::parse("1.0000000000");
+    ASSERT_EQ((precise * precise).toString(), "1");
+    ASSERT_EQ(DecimalValue::parse("1.5") * DecimalValue::parse("2"), DecimalValue(3));
+
+    ASSERT_THROW(a / DecimalValue(), std::domain_error);
+    ASSERT_THROW(a % DecimalValue(), std::domain_error);
+    ASSERT_THROW(DecimalValue(std::numeric_limits<int64_t>::max()) + DecimalValue(1),
+                 std::overflow_error);
+    ASSERT_THROW(-DecimalValue(std::numeric_limits<int64_t>::min()), std::overflow_error);
+}
+
+TEST(DecimalValue_test, test_compare)
+{
+    using FDVar::DecimalValue;
+
+    ASSERT_EQ(DecimalValue::parse("1.5"), DecimalValue::parse("1.50"));
+    ASSERT_LT(DecimalValue::parse("-0.01"), DecimalValue());
+    ASSERT_LT(DecimalValue::parse("0.1"), DecimalValue::parse("0.11"));
+    ASSERT_GT(DecimalValue(std::numeric_limits<int64_t>::max()), DecimalValue::parse("0.5"));
+    ASSERT_LT(DecimalValue(std::numeric_limits<int64_t>::min()), DecimalValue::parse("0.5"));
+    ASSERT_EQ(DecimalValue::parse("1.500").normalized().toString(), "1.5");
+    ASSERT_EQ(DecimalValue::parse("-12.34").toInteger(), -12);
+    ASSERT_DOUBLE_EQ(DecimalValue::parse("-12.34").toFloat(), -12.34);
+}
+
+TEST(DecimalValue_test, test_dynamic_variable)
+{
+    using FDVar::DecimalValue;
+    using FDVar::DynamicVariable;
+    using FDVar::ValueType;
+
+    DynamicVariable price(DecimalValue::parse("19.99"));
+    ASSERT_TRUE(price.isType(ValueType::Decimal));
+
+    DynamicVariable total = price * 3;
+    ASSERT_TRUE(total.isType(ValueType::Decimal));
+    ASSERT_EQ(total, DynamicVariable(DecimalValue::parse("59.97")));
+    ASSERT_EQ(DynamicVariable(2) * price, DynamicVariable(DecimalValue::parse("39.98")));
+
+    total -= DynamicVariable(DecimalValue::parse("0.97"));
+    ASSERT_EQ(total, 59);
+    ASSERT_GT(total, 58);
+    ASSERT_LT(total, 59.5);
+    ASSERT_EQ(static_cast<int64_t>(price), 19);
+    ASSERT_DOUBLE_EQ(static_cast<double>(price), 19.99);
+
+    DynamicVariable mixed = price + 0.01;
+    ASSERT_TRUE(mixed.isType(ValueType::Float));
+    ASSERT_DOUBLE_EQ(static_cast<double>(mixed), 20.0);
+
+    ASSERT_EQ(-price + price, DynamicVariable(DecimalValue()));
+    ASSERT_EQ(price % 5, DynamicVariable(DecimalValue::parse("4.99")));
+    ASSERT_THROW(price / 0, std::domain_error);
+    ASSERT_THROW(price % DynamicVariable(1.5), std::runtime_error);
+    ASSERT_THROW(price + DynamicVariable("1"), std::runtime_error);
+
+    DynamicVariable tenth(DecimalValue::parse("0.10"));
+    ASSERT_EQ(tenth, DynamicVariable(DecimalValue::parse("0.1")));
+    ASSERT_EQ(tenth.hash(), DynamicVariable(DecimalValue::parse("0.1")).hash());
+    ASSERT_LT(DynamicVariable(0), tenth);
+    ASSERT_LT(tenth, DynamicVariable(0.2));
+
+    std::ostringstream stream;
+    stream << price;
+    ASSERT_EQ(stream.str(), "19.99");
+
+    FDVar::JsonWriter writer;
+    writer.value(DynamicVariable({ price, tenth }));
+    ASSERT_EQ(writer.str(), "[19.99,0.10]");
+}
+
+TEST(DecimalValue_test, test_mixed_ordering)
+{
+    using FDVar::DecimalValue;
+    using FDVar::DynamicVariable;
+
+    DynamicVariable integer(DynamicVariable::IntType(9007199254740993));
+    DynamicVariable real(9007199254740992.0);
+    DynamicVariable decimal(DecimalValue::parse("9007199254740992.5"));
+    ASSERT_LT(real, decimal);
+    ASSERT_LT(decimal, integer);
+    ASSERT_LT(real, integer);
+    ASSERT_FALSE(integer < real);
+
+    std::vector<DynamicVariable> values { integer, decimal, real };
+    std::sort(values.begin(), values.end());
+    ASSERT_TRUE(values[0].isType(FDVar::ValueType::Float));
+    ASSERT_TRUE(values[1].isType(FDVar::ValueType::Decimal));
+    ASSERT_TRUE(values[2].isType(FDVar::ValueType::Integer));
+
+    DynamicVariable padded(DecimalValue::parse("9007199254740992.50"));
+    ASSERT_EQ(decimal.compareNumber(padded), 0);
+    ASSERT_EQ(DynamicVariable(2).compareNumber(DynamicVariable(DecimalValue::parse("2.0"))), 0);
+    ASSERT_EQ(DynamicVariable(2.0).compareNumber(DynamicVariable(2)), 0);
+    ASSERT_GT(integer.compareNumber(real), 0);
+    ASSERT_THROW(DynamicVariable(2).compareNumber(DynamicVariable(true)), std::runtime_error);
+
+    DynamicVariable text(DynamicVariable::StringType("x"));
+    ASSERT_LT(DynamicVariable(FDVar::BigIntegerValue(1)), text);
+    ASSERT_LT(DynamicVariable(DecimalValue::parse("1.5")), text);
+    ASSERT_LT(DynamicVariable(5), text);
+
+    ASSERT_LT(DynamicVariable(-0.5), DynamicVariable(DecimalValue::parse("-0.25")));
+    ASSERT_LT(DynamicVariable(DecimalValue::parse("0.1")), DynamicVariable(0.1));
+    ASSERT_LT(DynamicVariable(-std::numeric_limits<double>::infinity()),
+              DynamicVariable(DecimalValue::parse("-1")));
+    ASSERT_LT(DynamicVariable(DecimalValue::parse("1")),
+              DynamicVariable(std::numeric_limits<double>::quiet_NaN()));
+}
+
+#endif // FDVAR_DECIMALVALUE_TEST_H
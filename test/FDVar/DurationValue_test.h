@@ -0,0 +1,57 @@
+#ifndef FDVAR_DURATIONVALUE_TEST_H
+#define FDVAR_DURATIONVALUE_TEST_H
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include <FDVar/DurationValue.h>
+#include <gtest/gtest.h>
+
+TEST(DurationValue_test, test_parse)
+{
+    using FDVar::DurationValue;
+
+    ASSERT_EQ(DurationValue::parse("PT1H30M").value(), std::chrono::minutes(90));
+    ASSERT_EQ(DurationValue::parse("P1W").value(), std::chrono::hours(168));
+    ASSERT_EQ(DurationValue::parse("P2DT3S").value(),
+              std::chrono::hours(48) + std::chrono::seconds(3));
+    ASSERT_EQ(DurationValue::parse("-PT0.5S").count(), -500000);
+    ASSERT_EQ(DurationValue::parse("PT1,25S").count(), 1250000);
+    ASSERT_EQ(DurationValue::parse("PT0.0000019S").count(), 1);
+    ASSERT_EQ(DurationValue::parse("PT90M"), DurationValue(std::chrono::minutes(90)));
+
+    ASSERT_THROW(DurationValue::parse(""), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("P"), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("P1DT"), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("P1Y"), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("P1M"), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("PT1S1M"), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("PT1.5M"), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("P1H"), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("PT5"), std::invalid_argument);
+    ASSERT_THROW(DurationValue::parse("PT99999999999999999H"), std::overflow_error);
+}
+
+TEST(DurationValue_test, test_format_and_arithmetic)
+{
+    using FDVar::DurationValue;
+
+    ASSERT_EQ(DurationValue().toString(), "PT0S");
+    ASSERT_EQ(DurationValue::parse("P1DT2H3M4.5S").toString(), "PT26H3M4.5S");
+    ASSERT_EQ(DurationValue::parse("-PT0.000001S").toString(), "-PT0.000001S");
+    ASSERT_EQ(DurationValue(std::chrono::hours(2)).toString(), "PT2H");
+
+    DurationValue hour(std::chrono::hours(1));
+    DurationValue minute(std::chrono::minutes(1));
+    ASSERT_EQ(hour / minute, 60);
+    ASSERT_EQ((hour + minute * 30).toString(), "PT1H30M");
+    ASSERT_EQ((minute - hour).toString(), "-PT59M");
+    ASSERT_EQ((hour / 7).toString(), "PT8M34.285714S");
+    ASSERT_LT(-hour, minute);
+    ASSERT_THROW(hour / 0, std::domain_error);
+    ASSERT_THROW(hour * std::numeric_limits<int64_t>::max(), std::overflow_error);
+}
+
+#endif // FDVAR_DURATIONVALUE_TEST_H
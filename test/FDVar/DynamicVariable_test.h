@@ -1,8 +1,11 @@
 #ifndef FDVAR_DYNAMICVARIABLE_TEST_H
 #define FDVAR_DYNAMICVARIABLE_TEST_H
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 #include "ArrayValue_test.h"
 #include "BoolValue_test.h"
@@ -466,6 +469,26 @@ TEST(DynamicVariable_test, test_string_operators)
     }
 }
 
+TEST(DynamicVariable_test, test_string_view)
+{
+    FDVar::DynamicVariable::StringType text(100, 'a');
+    text[50] = 'b';
+    FDVar::DynamicVariable value(text);
+    FDVar::DynamicVariable slice = value.subString(40, 40);
+    ASSERT_EQ(slice.size(), 40U);
+    ASSERT_EQ(slice.view(), text.substr(40, 40));
+    ASSERT_EQ(slice.view()[10], 'b');
+
+    size_t count = 0;
+    for(auto c: slice.view())
+    {
+        count += c == 'a' ? 1 : 0;
+    }
+
+    ASSERT_EQ(count, 39U);
+    ASSERT_THROW(FDVar::DynamicVariable(1).view(), std::runtime_error);
+}
+
 TEST(DynamicVariable_test, test_array_operators)
 {
     {
@@ -555,4 +578,194 @@ TEST(DynamicVariable_test, test_function_operators)
     ASSERT_EQ(value(1_var), 2);
 }
 
+TEST(DynamicVariable_test, test_function_arguments)
+{
+    FDVar::DynamicVariable add = FDVar::DynamicVariable::makeFunction(
+      [](const FDVar::DynamicVariable &a, const FDVar::DynamicVariable &b) { return a + b; });
+    ASSERT_EQ(add(2, 3), 5);
+    ASSERT_EQ(add(FDVar::DynamicVariable({ FDVar::DynamicVariable(4), FDVar::DynamicVariable(5) })),
+              9);
+    ASSERT_THROW(add(1, 2, 3), std::invalid_argument);
+
+    FDVar::DynamicVariable answer =
+      FDVar::DynamicVariable::makeFunction([]() { return FDVar::DynamicVariable(42); });
+    ASSERT_EQ(answer(), 42);
+
+    FDVar::DynamicVariable count =
+      FDVar::DynamicVariable::makeFunction([](const FDVar::DynamicVariable &args) {
+          return FDVar::DynamicVariable(static_cast<FDVar::DynamicVariable::IntType>(args.size()));
+      });
+    ASSERT_EQ(count(1, 2, 3), 3);
+}
+
+TEST(DynamicVariable_test, test_deep_equality)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable lhs(FDVar::ValueType::Object);
+    DynamicVariable rhs(FDVar::ValueType::Object);
+    for(int i = 0; i < 20; ++i)
+    {
+        DynamicVariable row({ DynamicVariable(i), DynamicVariable(i * 0.5), DynamicVariable() });
+        lhs.set(std::to_string(i), row);
+        rhs.set(std::to_string(19 - i),
+                DynamicVariable({ DynamicVariable(19 - i), DynamicVariable((19 - i) * 0.5),
+                                  DynamicVariable() }));
+    }
+
+    ASSERT_TRUE(lhs == rhs);
+    ASSERT_TRUE(lhs == lhs);
+    ASSERT_EQ(lhs.compare(rhs), 0);
+
+    DynamicVariable row = rhs["7"];
+    row.removeAt(1);
+    row.insert(DynamicVariable(3.6), 1);
+    ASSERT_TRUE(lhs != rhs);
+    ASSERT_NE(lhs.compare(rhs), 0);
+
+    DynamicVariable missing(FDVar::ValueType::Object);
+    DynamicVariable none(FDVar::ValueType::Object);
+    missing.set("a", DynamicVariable());
+    none.set("b", DynamicVariable());
+    ASSERT_FALSE(missing == none);
+
+    DynamicVariable func = DynamicVariable::makeFunction([]() { return DynamicVariable(1); });
+    DynamicVariable same = func;
+    ASSERT_TRUE(func == same);
+    ASSERT_FALSE(func == DynamicVariable::makeFunction([]() { return DynamicVariable(1); }));
+}
+
+TEST(DynamicVariable_test, test_ordering)
+{
+    using FDVar::DynamicVariable;
+    ASSERT_LT(DynamicVariable(), DynamicVariable(false));
+    ASSERT_LT(DynamicVariable(1), DynamicVariable(1.5));
+    ASSERT_LT(DynamicVariable(1), DynamicVariable(1.0));
+    ASSERT_LT(DynamicVariable(2.5), DynamicVariable(3));
+    ASSERT_LT(DynamicVariable(3), DynamicVariable(DynamicVariable::StringType("3")));
+    ASSERT_LT(DynamicVariable(DynamicVariable::StringType("abc")),
+              DynamicVariable(DynamicVariable::StringType("abd")));
+
+    DynamicVariable shorter({ DynamicVariable(1), DynamicVariable(2) });
+    DynamicVariable longer({ DynamicVariable(1), DynamicVariable(2), DynamicVariable(0) });
+    DynamicVariable greater({ DynamicVariable(1), DynamicVariable(3) });
+    ASSERT_LT(shorter, longer);
+    ASSERT_LT(longer, greater);
+    ASSERT_GE(greater, shorter);
+    ASSERT_GT(DynamicVariable({ shorter }), DynamicVariable(FDVar::ValueType::Array));
+
+    std::vector<DynamicVariable> values { greater, longer, shorter, DynamicVariable(7),
+                                          DynamicVariable(FDVar::ValueType::Object) };
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(values[0], 7);
+    ASSERT_TRUE(values[1] == shorter);
+    ASSERT_TRUE(values[3] == greater);
+    ASSERT_TRUE(values[4].isType(FDVar::ValueType::Object));
+}
+
+TEST(DynamicVariable_test, test_deep_comparison)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable lhs(FDVar::ValueType::Array);
+    DynamicVariable rhs(FDVar::ValueType::Array);
+    DynamicVariable lhsTail = lhs;
+    DynamicVariable rhsTail = rhs;
+    for(int i = 0; i < 100000; ++i)
+    {
+        DynamicVariable lhsChild(FDVar::ValueType::Array);
+        DynamicVariable rhsChild(FDVar::ValueType::Array);
+        lhsTail.push(lhsChild);
+        rhsTail.push(rhsChild);
+        lhsTail = lhsChild;
+        rhsTail = rhsChild;
+    }
+
+    ASSERT_TRUE(lhs == rhs);
+    ASSERT_EQ(lhs.compare(rhs), 0);
+    rhsTail.push(DynamicVariable(1));
+    ASSERT_FALSE(lhs == rhs);
+    ASSERT_LT(lhs, rhs);
+}
+
+TEST(DynamicVariable_test, test_vector_relocation)
+{
+    using FDVar::DynamicVariable;
+    static_assert(!std::is_polymorphic_v<DynamicVariable>);
+    static_assert(std::is_nothrow_move_constructible_v<DynamicVariable>);
+
+    DynamicVariable shared(FDVar::ValueType::Array);
+    const FDVar::AbstractValue::Ptr &node =
+      static_cast<const DynamicVariable &>(shared).internalValue();
+    std::vector<DynamicVariable> values;
+    for(int i = 0; i < 1000; ++i)
+    {
+        values.push_back(i % 2 == 0 ? DynamicVariable(999 - i) : shared);
+    }
+
+    ASSERT_EQ(node.use_count(), 501);
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(node.use_count(), 501);
+    ASSERT_EQ(values.front(), 1);
+    ASSERT_TRUE(values.back().isType(FDVar::ValueType::Array));
+
+    values.clear();
+    ASSERT_EQ(node.use_count(), 1);
+}
+
+TEST(DynamicVariable_test, test_rvalue_arithmetic)
+{
+    using FDVar::DynamicVariable;
+    static_assert(std::is_nothrow_move_constructible_v<FDVar::IntValue>);
+    static_assert(std::is_nothrow_move_constructible_v<FDVar::FloatValue>);
+    static_assert(std::is_nothrow_move_constructible_v<FDVar::StringValue>);
+    static_assert(std::is_nothrow_move_constructible_v<FDVar::ArrayValue>);
+    static_assert(std::is_nothrow_move_constructible_v<FDVar::ObjectValue>);
+
+    DynamicVariable a(1);
+    DynamicVariable b(2);
+    DynamicVariable c(3.5);
+    DynamicVariable sum(a + b + c);
+    ASSERT_EQ(a, 1);
+    ASSERT_EQ(b, 2);
+    ASSERT_EQ(sum, 6.5);
+    ASSERT_EQ(DynamicVariable(7) * 2 - 4, 10);
+    ASSERT_EQ((DynamicVariable(7) + b) % 4, 1);
+    ASSERT_EQ(DynamicVariable(9) / 2.0, 4.5);
+
+    DynamicVariable text(DynamicVariable::StringType("ab"));
+    DynamicVariable joined(text + DynamicVariable::StringType("cd") + text);
+    ASSERT_EQ(text.view(), "ab");
+    ASSERT_EQ(joined.view(), "abcdab");
+
+    // A temporary sharing its node with an array must not update the element.
+    DynamicVariable array(FDVar::ValueType::Array);
+    array.push(DynamicVariable(DynamicVariable::StringType("x")));
+    DynamicVariable element(array[0] + DynamicVariable::StringType("y"));
+    ASSERT_EQ(element.view(), "xy");
+    ASSERT_EQ(array[0].view(), "x");
+}
+
+TEST(DynamicVariable_test, test_rvalue_mutators)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable array(FDVar::ValueType::Array);
+    DynamicVariable child(FDVar::ValueType::Array);
+    const DynamicVariable &view = child;
+    const FDVar::AbstractValue *node = view.internalValue().get();
+    array.push(std::move(child));
+    ASSERT_EQ(view.internalValue(), nullptr);
+    ASSERT_EQ(static_cast<const DynamicVariable &>(array[0]).internalValue().get(), node);
+
+    DynamicVariable inserted(FDVar::ValueType::Object);
+    array.insert(std::move(inserted), 0);
+    ASSERT_TRUE(array[0].isType(FDVar::ValueType::Object));
+    array.set(1, DynamicVariable(5));
+    ASSERT_EQ(array[1], 5);
+
+    DynamicVariable object(FDVar::ValueType::Object);
+    DynamicVariable member(DynamicVariable::StringType("value"));
+    object.set("key", std::move(member));
+    ASSERT_EQ(object["key"].view(), "value");
+    ASSERT_EQ(static_cast<const DynamicVariable &>(member).internalValue(), nullptr);
+}
+
 #endif // FDVAR_DYNAMICVARIABLE_TEST_H
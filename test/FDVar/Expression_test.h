@@ -0,0 +1,193 @@
+#ifndef FDVAR_EXPRESSION_TEST_H
+#define FDVAR_EXPRESSION_TEST_H
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <FDVar/Expression.h>
+#include <gtest/gtest.h>
+
+TEST(Expression_test, test_generic)
+{
+    FDVar::Expression a = FDVar::Expression::argument(0);
+    FDVar::Expression b = FDVar::Expression::argument(1);
+    FDVar::CompiledExpression formula = (a * b + 1).compile();
+
+    ASSERT_FALSE(formula.isSpecialized());
+    ASSERT_EQ(formula.argumentCount(), 2U);
+    ASSERT_EQ(formula(2, 3), 7);
+    ASSERT_EQ(formula(2.5, 2), 6.0);
+    ASSERT_THROW(formula(2), std::invalid_argument);
+    ASSERT_THROW(formula("text", 2), std::runtime_error);
+}
+
+TEST(Expression_test, test_specialized)
+{
+    FDVar::Expression a = FDVar::Expression::argument(0);
+    FDVar::Expression b = FDVar::Expression::argument(1);
+    FDVar::Expression sum = a + b;
+    FDVar::CompiledExpression formula =
+      (sum * sum - a % 3).compile({ FDVar::ValueType::Integer, FDVar::ValueType::Integer });
+
+    ASSERT_TRUE(formula.isSpecialized());
+    ASSERT_EQ(formula(4, 1), 24);
+    ASSERT_TRUE(formula(4, 1).isType(FDVar::ValueType::Integer));
+
+    FDVar::CompiledExpression mixed =
+      (a / 2 + b).compile({ FDVar::ValueType::Integer, FDVar::ValueType::Float });
+    ASSERT_TRUE(mixed.isSpecialized());
+    ASSERT_EQ(mixed(5, 0.5), 2.5);
+    ASSERT_THROW((a / b).compile({ FDVar::ValueType::Integer, FDVar::ValueType::Integer })(1, 0),
+                 std::domain_error);
+
+    FDVar::CompiledExpression predicate =
+      (a > 1 && !(b == 2.0)).compile({ FDVar::ValueType::Integer, FDVar::ValueType::Float });
+    ASSERT_TRUE(predicate(2, 3.0) == true);
+    ASSERT_TRUE(predicate(2, 2.0) == false);
+    ASSERT_TRUE(predicate(1, 3.0) == false);
+}
+
+TEST(Expression_test, test_mixed_ordering)
+{
+    using FDVar::DynamicVariable;
+    constexpr int64_t above = (int64_t(1) << 53) + 1;
+    constexpr double below = 9007199254740992.0;
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+    FDVar::Expression a = FDVar::Expression::argument(0);
+    FDVar::Expression b = FDVar::Expression::argument(1);
+    std::vector<FDVar::ValueType> signature { FDVar::ValueType::Integer,
+                                              FDVar::ValueType::Float };
+    std::vector<FDVar::Expression> orderings { a < b, a <= b, a > b, a >= b,
+                                               b < a, b <= a, b > a, b >= a };
+    std::vector<bool> expected { false, false, true, true, true, true, false, false };
+
+    ASSERT_GT(DynamicVariable(above).compare(DynamicVariable(below)), 0);
+    for(size_t i = 0; i < orderings.size(); ++i)
+    {
+        FDVar::CompiledExpression compiled = orderings[i].compile(signature);
+        FDVar::CompiledExpression generic = orderings[i].compile();
+        ASSERT_TRUE(compiled.isSpecialized());
+        ASSERT_FALSE(generic.isSpecialized());
+
+        ASSERT_EQ(compiled(above, below), DynamicVariable(bool(expected[i])));
+        ASSERT_EQ(generic(above, below), DynamicVariable(bool(expected[i])));
+        ASSERT_EQ(compiled(2, 2.0), generic(2, 2.0));
+        ASSERT_EQ(compiled(-3, -2.5), generic(-3, -2.5));
+        ASSERT_EQ(compiled(std::numeric_limits<int64_t>::max(), 9223372036854775808.0),
+                  generic(std::numeric_limits<int64_t>::max(), 9223372036854775808.0));
+        ASSERT_EQ(compiled(1, nan), false);
+        ASSERT_EQ(generic(1, nan), false);
+    }
+}
+
+TEST(Expression_test, test_deoptimize)
+{
+    FDVar::Expression a = FDVar::Expression::argument(0);
+    FDVar::CompiledExpression formula = (a * 2).compile({ FDVar::ValueType::Integer });
+
+    ASSERT_EQ(formula(21), 42);
+    ASSERT_EQ(formula(1.5), 3.0);
+    ASSERT_TRUE(formula(1.5).isType(FDVar::ValueType::Float));
+
+    FDVar::CompiledExpression strings =
+      (a + FDVar::DynamicVariable("b")).compile({ FDVar::ValueType::String });
+    ASSERT_FALSE(strings.isSpecialized());
+    ASSERT_EQ(static_cast<const FDVar::DynamicVariable::StringType &>(
+                strings(FDVar::DynamicVariable("a"))),
+              "ab");
+
+    FDVar::CompiledExpression identity = a.compile({ FDVar::ValueType::Integer });
+    FDVar::DynamicVariable value(1);
+    FDVar::DynamicVariable result = identity(value);
+    ++result;
+    ASSERT_EQ(value, 1);
+}
+
+TEST(Expression_test, test_map)
+{
+    FDVar::Expression a = FDVar::Expression::argument(0);
+    FDVar::Expression b = FDVar::Expression::argument(1);
+    FDVar::CompiledExpression formula =
+      (a * b).compile({ FDVar::ValueType::Integer, FDVar::ValueType::Integer });
+
+    FDVar::DynamicVariable rows(FDVar::ValueType::Array);
+    for(int i = 0; i < 100; ++i)
+    {
+        rows.push(FDVar::DynamicVariable({ FDVar::DynamicVariable(i), FDVar::DynamicVariable(i) }));
+    }
+
+    rows.push(FDVar::DynamicVariable({ FDVar::DynamicVariable(0.5), FDVar::DynamicVariable(4) }));
+
+    FDVar::DynamicVariable result = formula.map(rows);
+    ASSERT_EQ(result.size(), 101U);
+    ASSERT_EQ(result[10], 100);
+    ASSERT_EQ(result[100], 2.0);
+
+    FDVar::DynamicVariable func = formula.toFunction();
+    ASSERT_EQ(func(6, 7), 42);
+}
+
+TEST(Expression_test, test_arithmetic_policy)
+{
+    using FDVar::ArithmeticPolicy;
+    using FDVar::DynamicVariable;
+    constexpr int64_t max = std::numeric_limits<int64_t>::max();
+    constexpr int64_t min = std::numeric_limits<int64_t>::min();
+
+    FDVar::Expression a = FDVar::Expression::argument(0);
+    FDVar::Expression b = FDVar::Expression::argument(1);
+    std::vector<FDVar::ValueType> integers { FDVar::ValueType::Integer,
+                                             FDVar::ValueType::Integer };
+    FDVar::CompiledExpression product = (a * b).compile(integers);
+    FDVar::CompiledExpression quotient = (a / b).compile(integers);
+    FDVar::CompiledExpression remainder = (a % b).compile(integers);
+    FDVar::CompiledExpression negation = (-a).compile({ FDVar::ValueType::Integer });
+    ASSERT_TRUE(product.isSpecialized());
+    ASSERT_TRUE(negation.isSpecialized());
+
+    ASSERT_EQ(remainder(min, -1), 0);
+    if constexpr(FDVar::DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::Checked)
+    {
+        ASSERT_THROW(product(max, 2), std::overflow_error);
+        ASSERT_THROW(quotient(min, -1), std::overflow_error);
+        ASSERT_THROW(negation(min), std::overflow_error);
+        return;
+    }
+
+    // The specialized path agrees with the DynamicVariable operators.
+    ASSERT_EQ(product(max, 2), DynamicVariable(max) * DynamicVariable(2));
+    ASSERT_EQ(quotient(min, -1), DynamicVariable(min) / DynamicVariable(-1));
+    ASSERT_EQ(negation(min), -DynamicVariable(min));
+
+    if constexpr(FDVar::DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::Wrap)
+    {
+        ASSERT_EQ(product(max, 2), -2);
+        ASSERT_EQ(quotient(min, -1), min);
+        ASSERT_EQ(negation(min), min);
+    }
+    else if constexpr(FDVar::DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::Saturate)
+    {
+        ASSERT_EQ(product(max, 2), max);
+        ASSERT_EQ(quotient(min, -1), max);
+        ASSERT_EQ(negation(min), max);
+    }
+    else if constexpr(FDVar::DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::PromoteToFloat)
+    {
+        ASSERT_TRUE(product(max, 2).isType(FDVar::ValueType::Float));
+        ASSERT_TRUE(quotient(min, -1).isType(FDVar::ValueType::Float));
+        ASSERT_TRUE(negation(min).isType(FDVar::ValueType::Float));
+        ASSERT_TRUE(product(3, 2).isType(FDVar::ValueType::Integer));
+    }
+    else
+    {
+        ASSERT_TRUE(product(max, 2).isType(FDVar::ValueType::BigInteger));
+        ASSERT_TRUE(quotient(min, -1).isType(FDVar::ValueType::BigInteger));
+        ASSERT_TRUE(negation(min).isType(FDVar::ValueType::BigInteger));
+        ASSERT_EQ(negation(min) + DynamicVariable(min), 0);
+    }
+}
+
+#endif // FDVAR_EXPRESSION_TEST_H
@@ -33,4 +33,50 @@ TEST(FunctionValue_test, test_member_functions)
       2);
 }
 
+TEST(FunctionValue_test, test_arguments)
+{
+    FDVar::FunctionValue value(
+      [](const FDVar::AbstractValue::Ptr *args, FDVar::FunctionValue::SizeType count) {
+          FDVar::IntValue::IntType sum = 0;
+          for(FDVar::FunctionValue::SizeType i = 0; i < count; ++i)
+          {
+              sum += static_cast<FDVar::IntValue &>(*args[i]);
+          }
+
+          return FDVar::AbstractValue::Ptr(new FDVar::IntValue(sum));
+      });
+
+    FDVar::AbstractValue::Ptr one(new FDVar::IntValue(1));
+    FDVar::AbstractValue::Ptr two(new FDVar::IntValue(2));
+    ASSERT_EQ(static_cast<FDVar::IntValue &>(*value(one, two)), 3);
+    ASSERT_EQ(static_cast<FDVar::IntValue &>(*value()), 0);
+
+    FDVar::FunctionValue unary([](FDVar::AbstractValue::Ptr var) { return var; });
+    FDVar::AbstractValue::Ptr packed = unary(one, two);
+    ASSERT_TRUE(packed->isType(FDVar::ValueType::Array));
+    ASSERT_EQ(static_cast<FDVar::AbstractArrayValue &>(*packed).size(), 2U);
+}
+
+TEST(FunctionValue_test, test_small_function)
+{
+    FDVar::SmallFunction<int(int), 16> empty;
+    ASSERT_TRUE(!empty);
+    ASSERT_THROW(empty(1), std::bad_function_call);
+
+    FDVar::SmallFunction<int(int), 16> small([](int i) { return i + 1; });
+    ASSERT_EQ(small(1), 2);
+
+    std::array<int, 16> data {};
+    data[15] = 7;
+    FDVar::SmallFunction<int(int), 16> large([data](int i) { return data[i]; });
+    FDVar::SmallFunction<int(int), 16> copy(large);
+    FDVar::SmallFunction<int(int), 16> moved(std::move(large));
+    ASSERT_TRUE(!large);
+    ASSERT_EQ(copy(15), 7);
+    ASSERT_EQ(moved(15), 7);
+
+    ASSERT_TRUE(!FDVar::SmallFunction<int(int)>(std::function<int(int)>()));
+    ASSERT_TRUE(!FDVar::SmallFunction<int(int)>(static_cast<int (*)(int)>(nullptr)));
+}
+
 #endif // FDVAR_FUNCTIONVALUE_TEST_H
@@ -0,0 +1,100 @@
+#ifndef FDVAR_HASH_TEST_H
+#define FDVAR_HASH_TEST_H
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/Hash.h>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <unordered_set>
+
+TEST(Hash_test, test_bytes)
+{
+    std::string text(200, 'x');
+    std::set<uint64_t> seen;
+    for(size_t i = 0; i <= text.size(); ++i)
+    {
+        seen.insert(FDVar::hash::bytes(text.data(), i));
+    }
+
+    ASSERT_EQ(seen.size(), text.size() + 1);
+    ASSERT_EQ(FDVar::hash::bytes("abc", 3), FDVar::hash::bytes(std::string("abc").data(), 3));
+    ASSERT_NE(FDVar::hash::bytes("abc", 3), FDVar::hash::bytes("abd", 3));
+    ASSERT_NE(FDVar::hash::bytes("abc", 3, 1), FDVar::hash::bytes("abc", 3, 2));
+}
+
+TEST(Hash_test, test_string_cache)
+{
+    FDVar::StringValue value("key");
+    uint64_t hash = value.hash();
+    ASSERT_EQ(hash, value.hash());
+    ASSERT_EQ(FDVar::StringValue(value).hash(), hash);
+
+    value += "s";
+    ASSERT_NE(value.hash(), hash);
+    ASSERT_EQ(value.hash(), FDVar::StringValue("keys").hash());
+
+    FDVar::StringValue::StringType text(10000, 'a');
+    FDVar::StringValue large(text);
+    ASSERT_EQ(large.subString(100, 50).hash(), FDVar::StringValue(text.substr(100, 50)).hash());
+}
+
+TEST(Hash_test, test_dynamic_variable)
+{
+    std::hash<FDVar::DynamicVariable> hasher;
+    ASSERT_EQ(hasher(FDVar::DynamicVariable(42)), hasher(FDVar::DynamicVariable(42)));
+    ASSERT_NE(hasher(FDVar::DynamicVariable(42)), hasher(FDVar::DynamicVariable(43)));
+    ASSERT_NE(hasher(FDVar::DynamicVariable(1)), hasher(FDVar::DynamicVariable(true)));
+    ASSERT_EQ(hasher(FDVar::DynamicVariable(0.0)), hasher(FDVar::DynamicVariable(-0.0)));
+    ASSERT_EQ(hasher(FDVar::DynamicVariable(NAN)), hasher(FDVar::DynamicVariable(-NAN)));
+    ASSERT_EQ(hasher(FDVar::DynamicVariable()), hasher(FDVar::DynamicVariable()));
+
+    FDVar::DynamicVariable lhs(FDVar::ValueType::Array);
+    FDVar::DynamicVariable rhs(FDVar::ValueType::Array);
+    lhs.push(FDVar::DynamicVariable(1));
+    lhs.push(FDVar::DynamicVariable(FDVar::DynamicVariable::StringType("two")));
+    rhs.push(FDVar::DynamicVariable(FDVar::DynamicVariable::StringType("two")));
+    rhs.push(FDVar::DynamicVariable(1));
+    ASSERT_NE(lhs.hash(), rhs.hash());
+    rhs.removeAt(0);
+    rhs.push(FDVar::DynamicVariable(FDVar::DynamicVariable::StringType("two")));
+    ASSERT_EQ(lhs.hash(), rhs.hash());
+
+    FDVar::DynamicVariable first(FDVar::ValueType::Object);
+    FDVar::DynamicVariable second(FDVar::ValueType::Object);
+    for(int i = 0; i < 50; ++i)
+    {
+        first.set(std::to_string(i), FDVar::DynamicVariable(i));
+        second.set(std::to_string(49 - i), FDVar::DynamicVariable(49 - i));
+    }
+
+    first.set("list", lhs);
+    second.set("list", rhs);
+    ASSERT_EQ(first.hash(), second.hash());
+    second.set("7", FDVar::DynamicVariable(8));
+    ASSERT_NE(first.hash(), second.hash());
+
+    std::unordered_set<FDVar::DynamicVariable> keys;
+    keys.insert(FDVar::DynamicVariable(FDVar::DynamicVariable::StringType("alpha")));
+    keys.insert(FDVar::DynamicVariable(FDVar::DynamicVariable::StringType("beta")));
+    keys.insert(FDVar::DynamicVariable(FDVar::DynamicVariable::StringType("alpha")));
+    keys.insert(FDVar::DynamicVariable(7));
+    ASSERT_EQ(keys.size(), 3U);
+    ASSERT_EQ(keys.count(FDVar::DynamicVariable(FDVar::DynamicVariable::StringType("beta"))), 1U);
+}
+
+TEST(Hash_test, test_deep_structure)
+{
+    FDVar::DynamicVariable root(FDVar::ValueType::Array);
+    FDVar::DynamicVariable current = root;
+    for(int i = 0; i < 100000; ++i)
+    {
+        FDVar::DynamicVariable child(FDVar::ValueType::Array);
+        current.push(child);
+        current = child;
+    }
+
+    ASSERT_EQ(root.hash(), root.hash());
+}
+
+#endif // FDVAR_HASH_TEST_H
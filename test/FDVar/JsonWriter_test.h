@@ -0,0 +1,63 @@
+#ifndef FDVAR_JSONWRITER_TEST_H
+#define FDVAR_JSONWRITER_TEST_H
+
+#include <cmath>
+#include <limits>
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/JsonWriter.h>
+#include <gtest/gtest.h>
+
+TEST(JsonWriter_test, test_scalars)
+{
+    FDVar::JsonWriter writer;
+    writer.beginArray();
+    writer.null();
+    writer.boolean(true);
+    writer.integer(-42);
+    writer.number(1.5);
+    writer.number(3.0);
+    writer.number(std::numeric_limits<double>::quiet_NaN());
+    writer.string("a\"b\\c\n\x01");
+    writer.beginObject();
+    writer.key("k");
+    writer.beginArray();
+    writer.endArray();
+    writer.endObject();
+    writer.endArray();
+    ASSERT_EQ(writer.str(), R"([null,true,-42,1.5,3.0,null,"a\"b\\c\n\u0001",{"k":[]}])");
+}
+
+TEST(JsonWriter_test, test_dynamic_variable)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable inner(FDVar::ValueType::Array);
+    inner.push(DynamicVariable(1));
+    inner.push(DynamicVariable(DynamicVariable::StringType("x")));
+    inner.push(DynamicVariable());
+    DynamicVariable root(FDVar::ValueType::Object);
+    root.set("list", inner);
+
+    FDVar::JsonWriter writer;
+    writer.value(root);
+    ASSERT_EQ(writer.str(), R"({"list":[1,"x",null]})");
+
+    DynamicVariable deep(FDVar::ValueType::Array);
+    DynamicVariable current = deep;
+    for(int i = 0; i < 10000; ++i)
+    {
+        DynamicVariable next(FDVar::ValueType::Array);
+        current.push(next);
+        current = next;
+    }
+
+    writer.clear();
+    writer.value(deep);
+    ASSERT_EQ(writer.str().size(), 20002);
+
+    DynamicVariable function(DynamicVariable::FunctionType([](DynamicVariable value) {
+        return value;
+    }));
+    ASSERT_THROW(writer.value(function), std::invalid_argument);
+}
+#endif // FDVAR_JSONWRITER_TEST_H
@@ -0,0 +1,120 @@
+#ifndef FDVAR_LAZYARITHMETIC_TEST_H
+#define FDVAR_LAZYARITHMETIC_TEST_H
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include <FDVar/DecimalValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/LazyArithmetic.h>
+#include <gtest/gtest.h>
+
+TEST(LazyArithmetic_test, test_matches_eager)
+{
+    using FDVar::DynamicVariable;
+    using FDVar::lazy;
+
+    DynamicVariable x(7);
+    DynamicVariable y(2);
+    DynamicVariable z(1.5);
+
+    DynamicVariable integer = lazy(x) * 2 + y - 3;
+    ASSERT_TRUE(integer.isType(FDVar::ValueType::Integer));
+    ASSERT_EQ(integer, x * 2 + y - 3);
+
+    DynamicVariable mixed = lazy(x) * 2 + y - z;
+    ASSERT_TRUE(mixed.isType(FDVar::ValueType::Float));
+    ASSERT_EQ(mixed, x * 2 + y - z);
+
+    DynamicVariable quotient = 10 / lazy(y) + lazy(x) / y;
+    ASSERT_TRUE(quotient.isType(FDVar::ValueType::Integer));
+    ASSERT_EQ(quotient, 8);
+
+    DynamicVariable scaled = lazy(x) / 2.0;
+    ASSERT_EQ(scaled, 3.5);
+
+    DynamicVariable remainder = (lazy(x) + 4) % y;
+    ASSERT_EQ(remainder, 1);
+    ASSERT_EQ(x, 7);
+}
+
+TEST(LazyArithmetic_test, test_errors)
+{
+    using FDVar::DynamicVariable;
+    using FDVar::lazy;
+
+    DynamicVariable x(7);
+    DynamicVariable text(DynamicVariable::StringType("7"));
+    ASSERT_THROW(DynamicVariable(lazy(x) + text), std::runtime_error);
+    ASSERT_THROW(DynamicVariable(lazy(x) % 2.0), std::runtime_error);
+}
+
+TEST(LazyArithmetic_test, test_assign_to)
+{
+    using FDVar::DynamicVariable;
+    using FDVar::lazy;
+
+    DynamicVariable x(3);
+    DynamicVariable target(0);
+    const FDVar::AbstractValue *node =
+      static_cast<const DynamicVariable &>(target).internalValue().get();
+    (lazy(x) * x + 1).assignTo(target);
+    ASSERT_EQ(target, 10);
+    ASSERT_EQ(static_cast<const DynamicVariable &>(target).internalValue().get(), node);
+
+    (lazy(x) * 0.5).assignTo(target);
+    ASSERT_EQ(target, 1.5);
+
+    DynamicVariable array(FDVar::ValueType::Array);
+    array.push(DynamicVariable(0));
+    DynamicVariable element = array[0];
+    (lazy(x) + 1).assignTo(element);
+    ASSERT_EQ(element, 4);
+    ASSERT_EQ(array[0], 0);
+}
+
+TEST(LazyArithmetic_test, test_exact_operands)
+{
+    using FDVar::ArithmeticPolicy;
+    using FDVar::DecimalValue;
+    using FDVar::DynamicVariable;
+    using FDVar::lazy;
+    constexpr int64_t max = std::numeric_limits<int64_t>::max();
+
+    DynamicVariable price(DecimalValue::parse("19.99"));
+    DynamicVariable count(3);
+    DynamicVariable total = lazy(price) * count + 1;
+    ASSERT_TRUE(total.isType(FDVar::ValueType::Decimal));
+    ASSERT_EQ(total, price * count + 1);
+
+    DynamicVariable big = DynamicVariable(max).add(DynamicVariable(1),
+                                                   ArithmeticPolicy::PromoteToBigInteger);
+    DynamicVariable back = lazy(big) - 1;
+    ASSERT_TRUE(back.isType(FDVar::ValueType::Integer));
+    ASSERT_EQ(back, max);
+    ASSERT_EQ(DynamicVariable(lazy(big) * 2 % 7), big * 2 % 7);
+
+    DynamicVariable target(0);
+    (lazy(big) + big).assignTo(target);
+    ASSERT_EQ(target, big + big);
+
+    // Overflow in a chain follows the eager operators under every policy.
+    DynamicVariable x(max);
+    if constexpr(FDVar::DEFAULT_ARITHMETIC_POLICY == ArithmeticPolicy::Checked)
+    {
+        ASSERT_THROW(DynamicVariable(lazy(x) * 2), std::overflow_error);
+    }
+    else
+    {
+        DynamicVariable product = lazy(x) * 2;
+        ASSERT_EQ(product.getValueType(), (x * 2).getValueType());
+        ASSERT_EQ(product, x * 2);
+        ASSERT_EQ(DynamicVariable(lazy(x) * 2 - x), x * 2 - x);
+    }
+
+    DynamicVariable none;
+    ASSERT_THROW(DynamicVariable(lazy(none) + 1), std::runtime_error);
+}
+
+#endif // FDVAR_LAZYARITHMETIC_TEST_H
@@ -0,0 +1,95 @@
+#ifndef FDVAR_NANBOXEDVARIABLE_TEST_H
+#define FDVAR_NANBOXEDVARIABLE_TEST_H
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/NanBoxedVariable.h>
+#include <gtest/gtest.h>
+
+#if FDVAR_NAN_BOXING_SUPPORTED
+TEST(NanBoxedVariable_test, test_scalars)
+{
+    using FDVar::NanBoxedVariable;
+    static_assert(sizeof(NanBoxedVariable) == 8);
+
+    NanBoxedVariable none;
+    ASSERT_TRUE(none.isType(FDVar::ValueType::None));
+    ASSERT_TRUE(NanBoxedVariable(true).toBool());
+    ASSERT_FALSE(NanBoxedVariable(false).toBool());
+
+    int64_t limit = (int64_t(1) << 47) - 1;
+    for(int64_t value: { int64_t(0), int64_t(-1), int64_t(42), limit, -limit - 1 })
+    {
+        NanBoxedVariable boxed(value);
+        ASSERT_TRUE(boxed.isInline());
+        ASSERT_TRUE(boxed.isType(FDVar::ValueType::Integer));
+        ASSERT_EQ(boxed.toInteger(), value);
+    }
+
+    NanBoxedVariable wide(std::numeric_limits<int64_t>::min());
+    ASSERT_FALSE(wide.isInline());
+    ASSERT_TRUE(wide.isType(FDVar::ValueType::Integer));
+    ASSERT_EQ(wide.toInteger(), std::numeric_limits<int64_t>::min());
+
+    for(double value: { 0.0, -0.0, 1.5, -2.25e300, std::numeric_limits<double>::infinity(),
+                        std::numeric_limits<double>::denorm_min() })
+    {
+        NanBoxedVariable boxed(value);
+        ASSERT_TRUE(boxed.isInline());
+        ASSERT_TRUE(boxed.isType(FDVar::ValueType::Float));
+        ASSERT_EQ(boxed.toFloat(), value);
+    }
+
+    NanBoxedVariable nan(-std::numeric_limits<double>::quiet_NaN());
+    ASSERT_TRUE(nan.isType(FDVar::ValueType::Float));
+    ASSERT_TRUE(std::isnan(nan.toFloat()));
+    ASSERT_NE(nan, nan);
+    ASSERT_EQ(NanBoxedVariable(0.0), NanBoxedVariable(-0.0));
+    ASSERT_NE(NanBoxedVariable(1), NanBoxedVariable(1.0));
+
+    ASSERT_THROW(NanBoxedVariable(1).toFloat(), std::runtime_error);
+    ASSERT_THROW(NanBoxedVariable(1.0).toInteger(), std::runtime_error);
+    ASSERT_THROW(none.toBool(), std::runtime_error);
+}
+
+TEST(NanBoxedVariable_test, test_boxed_values)
+{
+    using FDVar::DynamicVariable;
+    using FDVar::NanBoxedVariable;
+    NanBoxedVariable text("compact");
+    ASSERT_FALSE(text.isInline());
+    ASSERT_EQ(text.view(), "compact");
+
+    NanBoxedVariable copy = text;
+    ASSERT_EQ(copy, text);
+    NanBoxedVariable moved = std::move(copy);
+    ASSERT_TRUE(copy.isType(FDVar::ValueType::None));
+    ASSERT_EQ(moved.view(), "compact");
+    moved = NanBoxedVariable(3);
+    ASSERT_EQ(moved.toInteger(), 3);
+    ASSERT_EQ(text, NanBoxedVariable("compact"));
+
+    DynamicVariable array(FDVar::ValueType::Array);
+    array.push(DynamicVariable(1));
+    NanBoxedVariable shared(array);
+    ASSERT_TRUE(shared.isType(FDVar::ValueType::Array));
+    array.push(DynamicVariable(2));
+    ASSERT_EQ(shared.toDynamicVariable().size(), 2);
+
+    ASSERT_EQ(NanBoxedVariable(DynamicVariable(7)).toInteger(), 7);
+    ASSERT_EQ(NanBoxedVariable(DynamicVariable(2.5)).toFloat(), 2.5);
+    ASSERT_TRUE(NanBoxedVariable(DynamicVariable(true)).toBool());
+    ASSERT_TRUE(NanBoxedVariable(DynamicVariable()).isType(FDVar::ValueType::None));
+    ASSERT_EQ(NanBoxedVariable(9).toDynamicVariable(), 9);
+    ASSERT_EQ(text.toDynamicVariable().view(), "compact");
+
+    std::vector<NanBoxedVariable> values(1000, NanBoxedVariable(1.0));
+    values[10] = NanBoxedVariable("x");
+    std::vector<NanBoxedVariable> copies = values;
+    ASSERT_EQ(copies[10], values[10]);
+}
+#endif // FDVAR_NAN_BOXING_SUPPORTED
+#endif // FDVAR_NANBOXEDVARIABLE_TEST_H
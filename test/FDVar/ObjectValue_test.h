@@ -41,7 +41,7 @@ class CustomObjectValue : public FDVar::AbstractObjectValue
 
     FDVar::AbstractValue::Ptr keys() const override
     {
-        std::unique_ptr<FDVar::ArrayValue> result;
+        std::unique_ptr<FDVar::ArrayValue> result(new FDVar::ArrayValue());
         result->push(std::make_shared<FDVar::StringValue>("i"));
         result->push(std::make_shared<FDVar::StringValue>("f"));
         result->push(std::make_shared<FDVar::StringValue>("b"));
@@ -91,6 +91,39 @@ class CustomObjectValue : public FDVar::AbstractObjectValue
     }
 };
 
+// Forwards to an ObjectValue but keeps the default find(), so callers have to fall back to
+// contains() and get().
+class ForwardingObjectValue : public FDVar::AbstractObjectValue
+{
+  private:
+    FDVar::ObjectValue m_object;
+
+  public:
+    explicit ForwardingObjectValue(FDVar::ObjectValue::ObjectType values) :
+        m_object(std::move(values))
+    {
+    }
+
+    FDVar::AbstractValue::Ptr keys() const override { return m_object.keys(); }
+
+    FDVar::AbstractValue::Ptr operator[](StringViewType member) override
+    {
+        return m_object[member];
+    }
+
+    FDVar::AbstractValue::Ptr operator[](StringViewType member) const override
+    {
+        return m_object[member];
+    }
+
+    void set(StringViewType key, FDVar::AbstractValue::Ptr value) override
+    {
+        m_object.set(key, std::move(value));
+    }
+
+    void unset(StringViewType key) override { m_object.unset(key); }
+};
+
 TEST(ObjectValue_test, test_constructors)
 {
     FDVar::ObjectValue value;
@@ -132,6 +165,33 @@ TEST(ObjectValue_test, test_member_functions)
     obj.erase("i2");
 }
 
+TEST(ObjectValue_test, test_deep_destruction)
+{
+    FDVar::AbstractValue::Ptr shared(new FDVar::IntValue(42));
+    {
+        FDVar::AbstractValue::Ptr root(new FDVar::ObjectValue());
+        FDVar::AbstractValue::Ptr current = root;
+        for(size_t i = 0; i < 500000; ++i)
+        {
+            FDVar::AbstractValue::Ptr child(i % 2 == 0 ? static_cast<FDVar::AbstractValue *>(
+                                                           new FDVar::ArrayValue({ shared }))
+                                                       : new FDVar::ObjectValue());
+            if(current->isType(FDVar::ValueType::Object))
+            {
+                static_cast<FDVar::ObjectValue &>(*current).set("child", child);
+            }
+            else
+            {
+                static_cast<FDVar::ArrayValue &>(*current).push(child);
+            }
+
+            current = child;
+        }
+    }
+
+    ASSERT_EQ(shared.use_count(), 1);
+}
+
 TEST(CustomObjectValue_test, test_constructors)
 {
     CustomObjectValue value;
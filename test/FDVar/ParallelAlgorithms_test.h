@@ -0,0 +1,104 @@
+#ifndef FDVAR_PARALLELALGORITHMS_TEST_H
+#define FDVAR_PARALLELALGORITHMS_TEST_H
+
+#include <FDVar/ParallelAlgorithms.h>
+#include <gtest/gtest.h>
+
+static FDVar::DynamicVariable makeParallelTestArray(size_t count)
+{
+    FDVar::DynamicVariable::ArrayType arr;
+    for(size_t i = 0; i < count; ++i)
+    {
+        arr.emplace_back(new FDVar::IntValue((i * 7919) % count));
+    }
+
+    return FDVar::DynamicVariable(std::move(arr));
+}
+
+TEST(ParallelAlgorithms_test, test_thread_pool)
+{
+    FDVar::ThreadPool pool(4);
+    ASSERT_EQ(pool.size(), 4U);
+
+    std::vector<int> values(10000, 0);
+    pool.parallelFor(0, values.size(), 64, [&values](size_t from, size_t to) {
+        for(size_t i = from; i < to; ++i)
+        {
+            values[i] = static_cast<int>(i);
+        }
+    });
+
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        ASSERT_EQ(values[i], static_cast<int>(i));
+    }
+
+    ASSERT_THROW(pool.parallelFor(0, 100, 1,
+                                  [](size_t from, size_t) {
+                                      if(from == 50)
+                                      {
+                                          throw std::runtime_error("error");
+                                      }
+                                  }),
+                 std::runtime_error);
+}
+
+TEST(ParallelAlgorithms_test, test_map_filter_reduce)
+{
+    FDVar::ThreadPool pool(4);
+    FDVar::DynamicVariable value = makeParallelTestArray(5000);
+
+    FDVar::DynamicVariable doubled = FDVar::parallelMap(
+      value, [](const FDVar::DynamicVariable &var) { return var * 2; }, pool);
+    ASSERT_EQ(doubled.size(), value.size());
+    for(size_t i = 0; i < value.size(); ++i)
+    {
+        ASSERT_EQ(doubled[i], static_cast<FDVar::DynamicVariable::IntType>(value[i]) * 2);
+    }
+
+    FDVar::DynamicVariable::FunctionType isEven = [](FDVar::DynamicVariable var) {
+        return FDVar::DynamicVariable(var % 2 == 0);
+    };
+    FDVar::DynamicVariable even = FDVar::parallelFilter(value, isEven, pool, 16);
+    ASSERT_EQ(even.size(), 2500U);
+    for(size_t i = 1; i < even.size(); ++i)
+    {
+        ASSERT_EQ(even[i] % 2, 0);
+    }
+
+    FDVar::DynamicVariable sum = FDVar::parallelReduce(
+      value, FDVar::DynamicVariable(0),
+      [](const FDVar::DynamicVariable &a, const FDVar::DynamicVariable &b) { return a + b; },
+      pool);
+    ASSERT_EQ(sum, 4999 * 5000 / 2);
+    ASSERT_EQ(value[1], 7919 % 5000);
+}
+
+TEST(ParallelAlgorithms_test, test_sort)
+{
+    FDVar::ThreadPool pool(3);
+    FDVar::DynamicVariable value = makeParallelTestArray(10007);
+    FDVar::parallelSort(
+      value,
+      [](const FDVar::DynamicVariable &a, const FDVar::DynamicVariable &b) {
+          return static_cast<FDVar::DynamicVariable::IntType>(a) <
+                 static_cast<FDVar::DynamicVariable::IntType>(b);
+      },
+      pool, 100);
+
+    ASSERT_EQ(value.size(), 10007U);
+    for(size_t i = 0; i < value.size(); ++i)
+    {
+        ASSERT_EQ(value[i], i);
+    }
+
+    FDVar::DynamicVariable empty(FDVar::ValueType::Array);
+    FDVar::parallelSort(
+      empty, [](const FDVar::DynamicVariable &, const FDVar::DynamicVariable &) { return false; });
+    ASSERT_TRUE(empty.isEmpty());
+    ASSERT_THROW(FDVar::parallelMap(FDVar::DynamicVariable(1),
+                                    [](const FDVar::DynamicVariable &var) { return var; }),
+                 std::runtime_error);
+}
+
+#endif // FDVAR_PARALLELALGORITHMS_TEST_H
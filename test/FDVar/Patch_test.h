@@ -0,0 +1,220 @@
+#ifndef FDVAR_PATCH_TEST_H
+#define FDVAR_PATCH_TEST_H
+
+#include "ObjectValue_test.h"
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/Patch.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace
+{
+    FDVar::DynamicVariable patchString(const char *text)
+    {
+        return FDVar::DynamicVariable(FDVar::DynamicVariable::StringType(text));
+    }
+
+    FDVar::DynamicVariable patchOperation(const char *op,
+                                          const char *path,
+                                          const FDVar::DynamicVariable &value)
+    {
+        FDVar::DynamicVariable operation(FDVar::ValueType::Object);
+        operation.set("op", patchString(op));
+        operation.set("path", patchString(path));
+        operation.set("value", value);
+        return operation;
+    }
+
+    FDVar::DynamicVariable patchOperation(const char *op, const char *path, const char *from)
+    {
+        FDVar::DynamicVariable operation(FDVar::ValueType::Object);
+        operation.set("op", patchString(op));
+        operation.set("path", patchString(path));
+        operation.set("from", patchString(from));
+        return operation;
+    }
+} // namespace
+
+TEST(Patch_test, test_diff_objects)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable source(FDVar::ValueType::Object);
+    DynamicVariable shared(FDVar::ValueType::Array);
+    for(int i = 0; i < 1000; ++i)
+    {
+        shared.push(DynamicVariable(i));
+    }
+
+    source.set("name", patchString("alpha"));
+    source.set("count", DynamicVariable(1));
+    source.set("stale", DynamicVariable(true));
+    source.set("shared", shared);
+
+    DynamicVariable target(FDVar::ValueType::Object);
+    target.set("name", patchString("beta"));
+    target.set("count", DynamicVariable(1));
+    target.set("fresh/key", DynamicVariable(2.5));
+    target.set("shared", shared);
+
+    DynamicVariable patch = FDVar::diff(source, target);
+    ASSERT_EQ(patch.size(), 3U);
+
+    FDVar::apply(source, patch);
+    ASSERT_TRUE(source == target);
+    ASSERT_EQ(FDVar::diff(source, target).size(), 0U);
+}
+
+TEST(Patch_test, test_diff_arrays)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable source({ DynamicVariable(1), DynamicVariable(2), DynamicVariable(3),
+                             DynamicVariable(4), DynamicVariable(5) });
+    DynamicVariable target({ DynamicVariable(1), DynamicVariable(9), DynamicVariable(2),
+                             DynamicVariable(3), DynamicVariable(5) });
+
+    DynamicVariable patch = FDVar::diff(source, target);
+    ASSERT_EQ(patch.size(), 2U);
+    ASSERT_EQ(patch[0]["op"].view(), "add");
+    ASSERT_EQ(patch[0]["path"].view(), "/1");
+    ASSERT_EQ(patch[1]["op"].view(), "remove");
+    ASSERT_EQ(patch[1]["path"].view(), "/4");
+
+    FDVar::apply(source, patch);
+    ASSERT_TRUE(source == target);
+
+    DynamicVariable inner(FDVar::ValueType::Object);
+    inner.set("value", DynamicVariable(1));
+    DynamicVariable nested({ DynamicVariable(0), inner });
+    DynamicVariable changed(FDVar::ValueType::Object);
+    changed.set("value", DynamicVariable(2));
+    DynamicVariable expected({ DynamicVariable(0), changed });
+
+    patch = FDVar::diff(nested, expected);
+    ASSERT_EQ(patch.size(), 1U);
+    ASSERT_EQ(patch[0]["op"].view(), "replace");
+    ASSERT_EQ(patch[0]["path"].view(), "/1/value");
+}
+
+TEST(Patch_test, test_round_trip)
+{
+    using FDVar::DynamicVariable;
+    std::mt19937 generator(7);
+    for(int size: { 10, 300, 1500 })
+    {
+        DynamicVariable source(FDVar::ValueType::Array);
+        DynamicVariable target(FDVar::ValueType::Array);
+        for(int i = 0; i < size; ++i)
+        {
+            source.push(DynamicVariable(static_cast<int>(generator() % 20)));
+            target.push(DynamicVariable(static_cast<int>(generator() % 20)));
+        }
+
+        DynamicVariable document(FDVar::ValueType::Object);
+        document.set("rows", source);
+        DynamicVariable expected(FDVar::ValueType::Object);
+        expected.set("rows", target);
+
+        FDVar::apply(document, FDVar::diff(document, expected));
+        ASSERT_TRUE(document == expected);
+        ASSERT_FALSE(document["rows"].internalValue() == target.internalValue());
+    }
+}
+
+TEST(Patch_test, test_apply)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable document(FDVar::ValueType::Object);
+    document.set("list", DynamicVariable({ DynamicVariable(1), DynamicVariable(2) }));
+    document.set("a~b", DynamicVariable(FDVar::ValueType::Object));
+
+    DynamicVariable patch(FDVar::ValueType::Array);
+    patch.push(patchOperation("add", "/list/-", DynamicVariable(3)));
+    patch.push(patchOperation("add", "/list/0", DynamicVariable(0)));
+    patch.push(patchOperation("replace", "/list/1", DynamicVariable(10)));
+    patch.push(patchOperation("add", "/a~0b/c~1d", DynamicVariable(true)));
+    patch.push(patchOperation("copy", "/copy", "/list"));
+    patch.push(patchOperation("move", "/moved", "/a~0b"));
+    patch.push(patchOperation("test", "/moved/c~1d", DynamicVariable(true)));
+    FDVar::apply(document, patch);
+
+    ASSERT_TRUE(document["list"] ==
+                DynamicVariable({ DynamicVariable(0), DynamicVariable(10), DynamicVariable(2),
+                                  DynamicVariable(3) }));
+    ASSERT_TRUE(document["copy"] == document["list"]);
+    ASSERT_FALSE(document["copy"].internalValue() == document["list"].internalValue());
+    ASSERT_TRUE(document["moved"]["c/d"] == DynamicVariable(true));
+    ASSERT_EQ(document.keys().size(), 3U);
+
+    DynamicVariable failing(FDVar::ValueType::Array);
+    failing.push(patchOperation("test", "/list/0", DynamicVariable(1)));
+    ASSERT_THROW(FDVar::apply(document, failing), std::invalid_argument);
+
+    DynamicVariable numeric(FDVar::ValueType::Array);
+    numeric.push(patchOperation("test", "/list/1", DynamicVariable(10.0)));
+    numeric.push(patchOperation("test", "/list", DynamicVariable({ DynamicVariable(0.0),
+                                                                  DynamicVariable(10),
+                                                                  DynamicVariable(2.0),
+                                                                  DynamicVariable(3) })));
+    FDVar::apply(document, numeric);
+    DynamicVariable fraction(FDVar::ValueType::Array);
+    fraction.push(patchOperation("test", "/list/1", DynamicVariable(10.5)));
+    ASSERT_THROW(FDVar::apply(document, fraction), std::invalid_argument);
+
+    DynamicVariable missing(FDVar::ValueType::Array);
+    missing.push(patchOperation("remove", "/nothing", DynamicVariable()));
+    ASSERT_THROW(FDVar::apply(document, missing), std::out_of_range);
+
+    DynamicVariable outOfRange(FDVar::ValueType::Array);
+    outOfRange.push(patchOperation("add", "/list/9", DynamicVariable(1)));
+    ASSERT_THROW(FDVar::apply(document, outOfRange), std::out_of_range);
+
+    DynamicVariable cycle(FDVar::ValueType::Array);
+    cycle.push(patchOperation("move", "/list/0", "/list"));
+    ASSERT_THROW(FDVar::apply(document, cycle), std::invalid_argument);
+}
+
+TEST(Patch_test, test_equal)
+{
+    using FDVar::DynamicVariable;
+    FDVar::AbstractValue::Ptr custom(new CustomObjectValue());
+    DynamicVariable plain(FDVar::ValueType::Object);
+    plain.set("i", DynamicVariable(42));
+    plain.set("b", DynamicVariable(true));
+    plain.set("f", DynamicVariable(static_cast<double>(static_cast<float>(3.14159))));
+    plain.set("s", patchString("text"));
+    ASSERT_TRUE(FDVar::json::equal(custom, plain.internalValue()));
+    ASSERT_TRUE(FDVar::json::equal(plain.internalValue(), custom));
+
+    DynamicVariable document(FDVar::ValueType::Object);
+    document.set("custom", DynamicVariable(custom));
+    DynamicVariable patch(FDVar::ValueType::Array);
+    patch.push(patchOperation("test", "/custom", plain));
+    FDVar::apply(document, patch);
+
+    plain.set("i", DynamicVariable(43));
+    ASSERT_FALSE(FDVar::json::equal(plain.internalValue(), custom));
+
+    DynamicVariable lhs(FDVar::ValueType::Array);
+    DynamicVariable rhs(FDVar::ValueType::Array);
+    DynamicVariable lhsTail = lhs;
+    DynamicVariable rhsTail = rhs;
+    for(int i = 0; i < 100000; ++i)
+    {
+        DynamicVariable lhsChild(FDVar::ValueType::Array);
+        DynamicVariable rhsChild(FDVar::ValueType::Array);
+        lhsTail.push(lhsChild);
+        rhsTail.push(rhsChild);
+        lhsTail = lhsChild;
+        rhsTail = rhsChild;
+    }
+
+    lhsTail.push(DynamicVariable(1));
+    rhsTail.push(DynamicVariable(1.0));
+    ASSERT_TRUE(FDVar::json::equal(lhs.internalValue(), rhs.internalValue()));
+    rhsTail.push(DynamicVariable(2));
+    ASSERT_FALSE(FDVar::json::equal(lhs.internalValue(), rhs.internalValue()));
+}
+
+#endif // FDVAR_PATCH_TEST_H
@@ -0,0 +1,144 @@
+#ifndef FDVAR_PATH_TEST_H
+#define FDVAR_PATH_TEST_H
+
+#include <FDVar/BigIntegerValue.h>
+#include <FDVar/DecimalValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/Path.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    FDVar::DynamicVariable pathDocument()
+    {
+        using FDVar::DynamicVariable;
+        DynamicVariable books(FDVar::ValueType::Array);
+        const char *titles[] = { "Sayings", "Sword", "Moby Dick", "Rings" };
+        double prices[] = { 8.95, 12.99, 8.99, 22.99 };
+        for(int i = 0; i < 4; ++i)
+        {
+            DynamicVariable book(FDVar::ValueType::Object);
+            book.set("title", DynamicVariable(DynamicVariable::StringType(titles[i])));
+            book.set("price", DynamicVariable(prices[i]));
+            book.set("id", DynamicVariable(i));
+            if(i % 2 == 1)
+            {
+                book.set("isbn", DynamicVariable(DynamicVariable::StringType("0-553")));
+            }
+
+            books.push(book);
+        }
+
+        DynamicVariable store(FDVar::ValueType::Object);
+        store.set("book", books);
+        store.set("a/b~c", DynamicVariable(7));
+
+        DynamicVariable root(FDVar::ValueType::Object);
+        root.set("store", store);
+        return root;
+    }
+} // namespace
+
+TEST(Path_test, test_pointer)
+{
+    FDVar::DynamicVariable document = pathDocument();
+    FDVar::Path title = FDVar::Path::fromPointer("/store/book/2/title");
+    ASSERT_TRUE(title.isSingular());
+    ASSERT_EQ(title.get(document).view(), "Moby Dick");
+    ASSERT_EQ(FDVar::Path::parse("/store/a~1b~0c").get(document), 7);
+    ASSERT_TRUE(FDVar::Path::parse("").get(document).isType(FDVar::ValueType::Object));
+
+    ASSERT_FALSE(FDVar::Path::parse("/store/book/4").contains(document));
+    ASSERT_FALSE(FDVar::Path::parse("/store/book/01").contains(document));
+    ASSERT_FALSE(FDVar::Path::parse("/store/missing/0").contains(document));
+    ASSERT_THROW(FDVar::Path::parse("/store/missing").get(document), std::out_of_range);
+    ASSERT_THROW(FDVar::Path::parse("store"), std::invalid_argument);
+    ASSERT_THROW(FDVar::Path::parse("/a~2"), std::invalid_argument);
+}
+
+TEST(Path_test, test_json_path)
+{
+    FDVar::DynamicVariable document = pathDocument();
+    ASSERT_EQ(FDVar::Path::parse("$.store.book[1].title").get(document).view(), "Sword");
+    ASSERT_EQ(FDVar::Path::parse("$['store'][\"book\"][-1].id").get(document), 3);
+    ASSERT_EQ(FDVar::Path::parse("$.store['a/b~c']").get(document), 7);
+
+    FDVar::DynamicVariable ids = FDVar::Path::parse("$.store.book[*].id").select(document);
+    ASSERT_EQ(ids.size(), 4U);
+    for(int i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(ids[i], i);
+    }
+
+    ASSERT_EQ(FDVar::Path::parse("$.store.*").select(document).size(), 2U);
+    FDVar::DynamicVariable titles = FDVar::Path::parse("$.*.*[*].title").select(document);
+    ASSERT_EQ(titles.size(), 4U);
+    ASSERT_EQ(titles[3].view(), "Rings");
+    ASSERT_EQ(FDVar::Path::parse("$.store.book[?(@.isbn)].id").select(document).size(), 2U);
+
+    FDVar::DynamicVariable cheap =
+      FDVar::Path::parse("$.store.book[?(@.price < 10)].title").select(document);
+    ASSERT_EQ(cheap.size(), 2U);
+    ASSERT_EQ(cheap[0].view(), "Sayings");
+    ASSERT_EQ(cheap[1].view(), "Moby Dick");
+
+    ASSERT_EQ(FDVar::Path::parse("$.store.book[?(@.id >= 2)]").select(document).size(), 2U);
+    ASSERT_EQ(FDVar::Path::parse("$.store.book[?(@.title == 'Rings')].id").get(document), 3);
+    ASSERT_EQ(FDVar::Path::parse("$.store.book[?(@.id != 1.0)]").select(document).size(), 3U);
+
+    ASSERT_THROW(FDVar::Path::parse("$..book"), std::invalid_argument);
+    ASSERT_THROW(FDVar::Path::parse("$.store[?(@.id ~ 1)]"), std::invalid_argument);
+    ASSERT_THROW(FDVar::Path::parse("$.store.book[1"), std::invalid_argument);
+}
+
+TEST(Path_test, test_numeric_filters)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable items(FDVar::ValueType::Array);
+    DynamicVariable first(FDVar::ValueType::Object);
+    first.set("price", DynamicVariable(FDVar::DecimalValue::parse("8.95")));
+    first.set("stock", DynamicVariable(FDVar::BigIntegerValue::parse("100000000000000000000")));
+    items.push(first);
+    DynamicVariable second(FDVar::ValueType::Object);
+    second.set("price", DynamicVariable(FDVar::DecimalValue::parse("12.50")));
+    second.set("stock", DynamicVariable(5));
+    items.push(second);
+    DynamicVariable third(FDVar::ValueType::Object);
+    third.set("stock", DynamicVariable(DynamicVariable::IntType(9007199254740993)));
+    items.push(third);
+
+    auto count = [&items](const char *path) {
+        return FDVar::Path::parse(path).select(items).size();
+    };
+    ASSERT_EQ(count("$[?(@.price < 10)]"), 1U);
+    ASSERT_EQ(count("$[?(@.price >= 8.95)]"), 2U);
+    ASSERT_EQ(count("$[?(@.price <= 8.95)]"), 0U);
+    ASSERT_EQ(count("$[?(@.price == 12.5)]"), 1U);
+    ASSERT_EQ(count("$[?(@.price != 12.5)]"), 1U);
+    ASSERT_EQ(count("$[?(@.stock > 1000)]"), 2U);
+    ASSERT_EQ(count("$[?(@.stock <= 5.0)]"), 1U);
+    ASSERT_EQ(count("$[?(@.stock == 5.0)]"), 1U);
+    ASSERT_EQ(count("$[?(@.stock == 9007199254740992.0)]"), 0U);
+    ASSERT_EQ(count("$[?(@.stock > 9007199254740992.0)]"), 2U);
+}
+
+TEST(Path_test, test_streaming)
+{
+    FDVar::DynamicVariable document = pathDocument();
+    FDVar::Path path = FDVar::Path().member("store").member("book").filter(
+      [](const FDVar::DynamicVariable &book) { return book["id"] > 0; });
+
+    int visited = 0;
+    path.forEach(document, [&visited](const FDVar::DynamicVariable &book) {
+        ++visited;
+        return book["id"] < 2;
+    });
+    ASSERT_EQ(visited, 2);
+
+    FDVar::DynamicVariable total(0.0);
+    FDVar::Path::parse("$.store.book[*].price").forEach(
+      document, [&total](const FDVar::DynamicVariable &price) { total += price; });
+    ASSERT_NEAR(static_cast<double>(total), 53.92, 1e-9);
+}
+
+#endif // FDVAR_PATH_TEST_H
@@ -0,0 +1,151 @@
+#ifndef FDVAR_RECLAIMER_TEST_H
+#define FDVAR_RECLAIMER_TEST_H
+
+#include <future>
+#include <vector>
+
+#include <FDVar/Reclaimer.h>
+#include <gtest/gtest.h>
+
+TEST(Reclaimer_test, test_reclaim)
+{
+    FDVar::AbstractValue::Ptr leaf(new FDVar::IntValue(42));
+    FDVar::DynamicVariable value(FDVar::ValueType::Array);
+    FDVar::DynamicVariable current = value;
+    for(size_t i = 0; i < 100000; ++i)
+    {
+        FDVar::DynamicVariable child(FDVar::ValueType::Object);
+        current.push(child);
+        current = FDVar::DynamicVariable(FDVar::ValueType::Array);
+        child.set("next", current);
+    }
+
+    current.push(FDVar::DynamicVariable(leaf));
+    current = FDVar::DynamicVariable();
+
+    FDVar::Reclaimer reclaimer;
+    reclaimer.reclaim(value);
+    ASSERT_EQ(value, nullptr);
+    reclaimer.flush();
+    ASSERT_EQ(leaf.use_count(), 1);
+
+    FDVar::DynamicVariable none;
+    reclaimer.reclaim(none);
+    reclaimer.flush();
+}
+
+TEST(Reclaimer_test, test_automatic)
+{
+    FDVar::AbstractValue::Ptr leaf(new FDVar::IntValue(42));
+    FDVar::Reclaimer reclaimer(16, FDVar::Reclaimer::Policy::Block);
+    reclaimer.enableAutomatic(8);
+    ASSERT_EQ(FDVar::AbstractValue::releaseHandler(), &reclaimer);
+
+    {
+        FDVar::DynamicVariable small(FDVar::ValueType::Array);
+        small.push(FDVar::DynamicVariable(leaf));
+    }
+
+    ASSERT_EQ(reclaimer.stats().enqueued, 0U);
+    ASSERT_EQ(leaf.use_count(), 1);
+
+    for(size_t i = 0; i < 10; ++i)
+    {
+        FDVar::DynamicVariable large(FDVar::ValueType::Array);
+        FDVar::DynamicVariable object(FDVar::ValueType::Object);
+        for(size_t j = 0; j < 8; ++j)
+        {
+            large.push(FDVar::DynamicVariable(leaf));
+            object.set(std::to_string(j), FDVar::DynamicVariable(leaf));
+        }
+    }
+
+    reclaimer.flush();
+    FDVar::Reclaimer::Stats stats = reclaimer.stats();
+    ASSERT_EQ(stats.enqueued, 160U);
+    ASSERT_EQ(stats.reclaimed, 160U);
+    ASSERT_EQ(stats.queued, 0U);
+    ASSERT_LE(stats.peakQueued, 16U);
+    ASSERT_EQ(leaf.use_count(), 1);
+
+    reclaimer.disableAutomatic();
+    ASSERT_EQ(FDVar::AbstractValue::releaseHandler(), nullptr);
+}
+
+TEST(Reclaimer_test, test_nested)
+{
+    FDVar::AbstractValue::Ptr leaf(new FDVar::IntValue(42));
+    FDVar::Reclaimer reclaimer(1 << 20, FDVar::Reclaimer::Policy::Block);
+    reclaimer.enableAutomatic(8);
+
+    {
+        FDVar::DynamicVariable large(FDVar::ValueType::Array);
+        for(size_t i = 0; i < 1000; ++i)
+        {
+            large.push(FDVar::DynamicVariable(leaf));
+        }
+
+        FDVar::DynamicVariable inner(FDVar::ValueType::Array);
+        inner.push(large);
+        FDVar::DynamicVariable root(FDVar::ValueType::Object);
+        root.set("items", inner);
+        large = FDVar::DynamicVariable();
+        inner = FDVar::DynamicVariable();
+    }
+
+    reclaimer.flush();
+    FDVar::Reclaimer::Stats stats = reclaimer.stats();
+    ASSERT_EQ(stats.enqueued, 1U);
+    ASSERT_EQ(stats.reclaimed, 1U);
+    ASSERT_EQ(stats.releasedInline, 0U);
+    ASSERT_EQ(leaf.use_count(), 1);
+    reclaimer.disableAutomatic();
+}
+
+namespace
+{
+    class BlockingValue : public FDVar::AbstractValue
+    {
+        std::shared_future<void> m_gate;
+
+      public:
+        explicit BlockingValue(std::shared_future<void> gate) : m_gate(std::move(gate)) {}
+
+        ~BlockingValue() noexcept override { m_gate.wait(); }
+
+        FDVar::ValueType getValueType() const override { return FDVar::ValueType::Integer; }
+    };
+} // namespace
+
+TEST(Reclaimer_test, test_release_inline)
+{
+    FDVar::Reclaimer reclaimer(4, FDVar::Reclaimer::Policy::ReleaseInline);
+    std::promise<void> gate;
+    std::vector<FDVar::AbstractValue::Ptr> values;
+    values.emplace_back(new BlockingValue(gate.get_future().share()));
+    for(size_t i = 1; i < 4; ++i)
+    {
+        values.emplace_back(new FDVar::IntValue(i));
+    }
+
+    ASSERT_TRUE(reclaimer.defer(values));
+    ASSERT_TRUE(values.empty());
+
+    // The worker holds the full batch until the gate opens, so the queue stays at capacity.
+    values.emplace_back(new FDVar::IntValue(4));
+    ASSERT_FALSE(reclaimer.defer(values));
+    ASSERT_EQ(values.size(), 1U);
+
+    FDVar::Reclaimer::Stats stats = reclaimer.stats();
+    ASSERT_EQ(stats.releasedInline, 1U);
+    ASSERT_EQ(stats.enqueued, 4U);
+    ASSERT_EQ(stats.queued, 4U);
+
+    gate.set_value();
+    reclaimer.flush();
+    stats = reclaimer.stats();
+    ASSERT_EQ(stats.reclaimed, 4U);
+    ASSERT_EQ(stats.queued, 0U);
+}
+
+#endif // FDVAR_RECLAIMER_TEST_H
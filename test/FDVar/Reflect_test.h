@@ -0,0 +1,141 @@
+#ifndef FDVAR_REFLECT_TEST_H
+#define FDVAR_REFLECT_TEST_H
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ObjectValue_test.h"
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/Reflect.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    struct ReflectPoint
+    {
+        int x = 0;
+        double y = 0;
+    };
+
+    FDVAR_REFLECT(ReflectPoint, x, y)
+
+    struct ReflectShape
+    {
+        std::string name;
+        bool closed = false;
+        std::vector<ReflectPoint> points;
+        std::optional<int> layer;
+        FDVar::DynamicVariable extra;
+    };
+
+    FDVAR_REFLECT(ReflectShape, name, closed, points, layer, extra)
+
+    struct ReflectNarrow
+    {
+        int8_t small = 0;
+        uint16_t port = 0;
+        uint64_t big = 0;
+    };
+
+    FDVAR_REFLECT(ReflectNarrow, small, port, big)
+} // namespace
+
+TEST(Reflect_test, test_fields)
+{
+    static_assert(FDVar::is_reflected_v<ReflectPoint>);
+    static_assert(!FDVar::is_reflected_v<int>);
+    constexpr auto fields = FDVar::reflect::fields<ReflectShape>;
+    static_assert(std::tuple_size_v<decltype(fields)> == 5);
+    static_assert(std::get<0>(fields).name == "name");
+    static_assert(std::get<2>(fields).jsonKey == "\"points\":");
+}
+
+TEST(Reflect_test, test_round_trip)
+{
+    using FDVar::DynamicVariable;
+    ReflectShape shape { "tri", true, { { 1, 0.5 }, { 2, 1.5 }, { 3, 2.5 } }, std::nullopt, {} };
+    DynamicVariable value = FDVar::toDynamicVariable<ReflectShape>(shape);
+    ASSERT_EQ(value["name"].view(), "tri");
+    ASSERT_EQ(value["closed"], true);
+    ASSERT_EQ(value["points"].size(), 3);
+    ASSERT_EQ(value["points"][1]["x"], 2);
+    ASSERT_TRUE(value["layer"].isType(FDVar::ValueType::None));
+
+    value.set("layer", DynamicVariable(4));
+    auto restored = FDVar::fromDynamicVariable<ReflectShape>(value);
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_EQ(restored->name, "tri");
+    ASSERT_EQ(restored->points.size(), 3);
+    ASSERT_EQ(restored->points[2].y, 2.5);
+    ASSERT_EQ(restored->layer, 4);
+
+    DynamicVariable partial(FDVar::ValueType::Object);
+    partial.set("y", DynamicVariable(7));
+    auto point = FDVar::fromDynamicVariable<ReflectPoint>(partial);
+    ASSERT_TRUE(point.has_value());
+    ASSERT_EQ(point->x, 0);
+    ASSERT_EQ(point->y, 7.0);
+
+    partial.set("x", DynamicVariable(DynamicVariable::StringType("bad")));
+    ASSERT_FALSE(FDVar::fromDynamicVariable<ReflectPoint>(partial).has_value());
+    ASSERT_FALSE(FDVar::fromDynamicVariable<ReflectPoint>(DynamicVariable(1)).has_value());
+}
+
+TEST(Reflect_test, test_integer_range)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable value(FDVar::ValueType::Object);
+    value.set("small", DynamicVariable(-128));
+    value.set("port", DynamicVariable(65535));
+    auto narrow = FDVar::fromDynamicVariable<ReflectNarrow>(value);
+    ASSERT_TRUE(narrow.has_value());
+    ASSERT_EQ(narrow->small, -128);
+    ASSERT_EQ(narrow->port, 65535);
+
+    value.set("small", DynamicVariable(128));
+    ASSERT_THROW(FDVar::fromDynamicVariable<ReflectNarrow>(value), std::out_of_range);
+    value.set("small", DynamicVariable(0));
+    value.set("port", DynamicVariable(-1));
+    ASSERT_THROW(FDVar::fromDynamicVariable<ReflectNarrow>(value), std::out_of_range);
+    value.set("port", DynamicVariable(65536));
+    ASSERT_THROW(FDVar::fromDynamicVariable<ReflectNarrow>(value), std::out_of_range);
+
+    ReflectNarrow wide;
+    wide.big = uint64_t(std::numeric_limits<int64_t>::max());
+    ASSERT_EQ(FDVar::toDynamicVariable<ReflectNarrow>(wide)["big"],
+              std::numeric_limits<int64_t>::max());
+    wide.big += 1;
+    ASSERT_THROW(FDVar::toDynamicVariable<ReflectNarrow>(wide), std::out_of_range);
+}
+
+TEST(Reflect_test, test_json)
+{
+    using FDVar::DynamicVariable;
+    ReflectShape shape { "a\"b", false, { { 1, 0.25 } }, 3, {} };
+    shape.extra = DynamicVariable(FDVar::ValueType::Array);
+    shape.extra.push(DynamicVariable(true));
+    ASSERT_EQ(FDVar::toJson(shape),
+              R"({"name":"a\"b","closed":false,"points":[{"x":1,"y":0.25}],"layer":3,)"
+              R"("extra":[true]})");
+}
+
+TEST(Reflect_test, test_custom_object)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable custom(FDVar::AbstractValue::Ptr(new ForwardingObjectValue(
+      { { "x", FDVar::AbstractValue::Ptr(new FDVar::IntValue(7)) } })));
+    ReflectPoint point { 0, 1.5 };
+    ASSERT_TRUE(FDVar::reflect::fromValue(custom, point));
+    ASSERT_EQ(point.x, 7);
+    ASSERT_EQ(point.y, 1.5);
+
+    DynamicVariable wrong(FDVar::AbstractValue::Ptr(new ForwardingObjectValue(
+      { { "y", FDVar::AbstractValue::Ptr(new FDVar::StringValue("2")) } })));
+    ASSERT_FALSE(FDVar::reflect::fromValue(wrong, point));
+}
+#endif // FDVAR_REFLECT_TEST_H
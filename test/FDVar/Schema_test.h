@@ -0,0 +1,392 @@
+#ifndef FDVAR_SCHEMA_TEST_H
+#define FDVAR_SCHEMA_TEST_H
+
+#include "ObjectValue_test.h"
+
+#include <FDVar/BigIntegerValue.h>
+#include <FDVar/DecimalValue.h>
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/Schema.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+    FDVar::DynamicVariable schemaString(const char *value)
+    {
+        return FDVar::DynamicVariable(FDVar::DynamicVariable::StringType(value));
+    }
+
+    FDVar::DynamicVariable schemaStrings(std::initializer_list<const char *> values)
+    {
+        FDVar::DynamicVariable result(FDVar::ValueType::Array);
+        for(const char *value: values)
+        {
+            result.push(schemaString(value));
+        }
+
+        return result;
+    }
+
+    FDVar::DynamicVariable schemaOf(const char *type)
+    {
+        FDVar::DynamicVariable result(FDVar::ValueType::Object);
+        result.set("type", schemaString(type));
+        return result;
+    }
+
+    FDVar::DynamicVariable orderSchema()
+    {
+        using FDVar::DynamicVariable;
+        DynamicVariable quantity = schemaOf("integer");
+        quantity.set("minimum", DynamicVariable(1));
+
+        DynamicVariable price = schemaOf("number");
+        price.set("exclusiveMinimum", DynamicVariable(0));
+
+        DynamicVariable sku = schemaOf("string");
+        sku.set("pattern", schemaString("^[A-Z]{3}-[0-9]+$"));
+
+        DynamicVariable itemProperties(FDVar::ValueType::Object);
+        itemProperties.set("sku", sku);
+        itemProperties.set("quantity", quantity);
+        itemProperties.set("price", price);
+        DynamicVariable item = schemaOf("object");
+        item.set("properties", itemProperties);
+        item.set("required", schemaStrings({ "sku", "quantity", "price" }));
+        item.set("additionalProperties", DynamicVariable(false));
+
+        DynamicVariable items = schemaOf("array");
+        items.set("items", item);
+        items.set("minItems", DynamicVariable(1));
+
+        DynamicVariable status(FDVar::ValueType::Object);
+        status.set("enum", schemaStrings({ "new", "paid", "shipped" }));
+
+        DynamicVariable name = schemaOf("string");
+        name.set("minLength", DynamicVariable(1));
+        name.set("maxLength", DynamicVariable(8));
+
+        DynamicVariable customerProperties(FDVar::ValueType::Object);
+        customerProperties.set("name", name);
+        DynamicVariable customer = schemaOf("object");
+        customer.set("properties", customerProperties);
+        customer.set("required", schemaStrings({ "name" }));
+
+        DynamicVariable tags = schemaOf("array");
+        tags.set("items", schemaOf("string"));
+        tags.set("uniqueItems", DynamicVariable(true));
+
+        DynamicVariable properties(FDVar::ValueType::Object);
+        properties.set("id", schemaOf("integer"));
+        properties.set("status", status);
+        properties.set("customer", customer);
+        properties.set("items", items);
+        properties.set("tags", tags);
+
+        DynamicVariable root = schemaOf("object");
+        root.set("properties", properties);
+        root.set("required", schemaStrings({ "id", "status", "items" }));
+        return root;
+    }
+
+    FDVar::DynamicVariable orderPayload()
+    {
+        using FDVar::DynamicVariable;
+        DynamicVariable items(FDVar::ValueType::Array);
+        for(int i = 0; i < 3; ++i)
+        {
+            DynamicVariable item(FDVar::ValueType::Object);
+            item.set("sku", schemaString("ABC-12"));
+            item.set("quantity", DynamicVariable(i + 1));
+            item.set("price", DynamicVariable(9.5));
+            items.push(item);
+        }
+
+        DynamicVariable customer(FDVar::ValueType::Object);
+        customer.set("name", schemaString("Zoë"));
+
+        DynamicVariable order(FDVar::ValueType::Object);
+        order.set("id", DynamicVariable(42));
+        order.set("status", schemaString("paid"));
+        order.set("customer", customer);
+        order.set("items", items);
+        order.set("tags", schemaStrings({ "gift", "rush" }));
+        return order;
+    }
+} // namespace
+
+TEST(Schema_test, test_valid_payload)
+{
+    FDVar::Schema schema(orderSchema());
+    FDVar::SchemaError error;
+    ASSERT_TRUE(schema.validate(orderPayload(), error));
+    ASSERT_TRUE(FDVar::Schema().validate(orderPayload()));
+
+    auto order = orderPayload();
+    order.set("id", FDVar::DynamicVariable(42.0));
+    ASSERT_TRUE(schema.validate(order));
+    order.set("id", FDVar::DynamicVariable(42.5));
+    ASSERT_FALSE(schema.validate(order));
+}
+
+TEST(Schema_test, test_error_path)
+{
+    using FDVar::DynamicVariable;
+    FDVar::Schema schema(orderSchema());
+    FDVar::SchemaError error;
+
+    auto order = orderPayload();
+    order["items"][2].set("quantity", DynamicVariable(0));
+    ASSERT_FALSE(schema.validate(order, error));
+    ASSERT_EQ(error.path, "/items/2/quantity");
+    ASSERT_EQ(error.message, "value is below the minimum");
+
+    order = orderPayload();
+    order["items"][1].set("colour", schemaString("red"));
+    ASSERT_FALSE(schema.validate(order, error));
+    ASSERT_EQ(error.path, "/items/1/colour");
+
+    order = orderPayload();
+    order["items"][0].unset("sku");
+    ASSERT_FALSE(schema.validate(order, error));
+    ASSERT_EQ(error.path, "/items/0/sku");
+    ASSERT_EQ(error.message, "required member is missing");
+
+    order = orderPayload();
+    order["items"][0].set("sku", schemaString("abc-1"));
+    ASSERT_FALSE(schema.validate(order, error));
+    ASSERT_EQ(error.message, "string does not match pattern");
+
+    order = orderPayload();
+    order.set("status", schemaString("lost"));
+    ASSERT_FALSE(schema.validate(order, error));
+    ASSERT_EQ(error.path, "/status");
+
+    order = orderPayload();
+    order["customer"].set("name", schemaString("Zoë Smith"));
+    ASSERT_FALSE(schema.validate(order, error));
+    ASSERT_EQ(error.path, "/customer/name");
+
+    order = orderPayload();
+    order["tags"].push(schemaString("gift"));
+    ASSERT_FALSE(schema.validate(order, error));
+    ASSERT_EQ(error.path, "/tags/2");
+
+    ASSERT_FALSE(schema.validate(DynamicVariable(1), error));
+    ASSERT_EQ(error.path, "");
+    ASSERT_EQ(error.message, "value has the wrong type");
+}
+
+TEST(Schema_test, test_combinators_and_refs)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable node = schemaOf("object");
+    DynamicVariable children = schemaOf("array");
+    DynamicVariable ref(FDVar::ValueType::Object);
+    ref.set("$ref", schemaString("#/$defs/node"));
+    children.set("items", ref);
+    DynamicVariable nodeProperties(FDVar::ValueType::Object);
+    nodeProperties.set("children", children);
+    node.set("properties", nodeProperties);
+
+    DynamicVariable defs(FDVar::ValueType::Object);
+    defs.set("node", node);
+    DynamicVariable tree(FDVar::ValueType::Object);
+    tree.set("$defs", defs);
+    tree.set("$ref", schemaString("#/$defs/node"));
+    FDVar::Schema recursive(tree);
+
+    DynamicVariable leaf(FDVar::ValueType::Object);
+    DynamicVariable list(FDVar::ValueType::Array);
+    list.push(leaf);
+    DynamicVariable root(FDVar::ValueType::Object);
+    root.set("children", list);
+    ASSERT_TRUE(recursive.validate(root));
+    list.push(DynamicVariable(3));
+    FDVar::SchemaError error;
+    ASSERT_FALSE(recursive.validate(root, error));
+    ASSERT_EQ(error.path, "/children/1");
+
+    DynamicVariable options(FDVar::ValueType::Array);
+    options.push(schemaOf("integer"));
+    options.push(schemaOf("number"));
+    DynamicVariable oneOf(FDVar::ValueType::Object);
+    oneOf.set("oneOf", options);
+    FDVar::Schema exactlyOne(oneOf);
+    ASSERT_TRUE(exactlyOne.validate(DynamicVariable(1.5)));
+    ASSERT_FALSE(exactlyOne.validate(DynamicVariable(1)));
+
+    DynamicVariable anyOf(FDVar::ValueType::Object);
+    anyOf.set("anyOf", options);
+    DynamicVariable notString(FDVar::ValueType::Object);
+    notString.set("not", schemaOf("string"));
+    anyOf.set("allOf", DynamicVariable(std::initializer_list<DynamicVariable> { notString }));
+    FDVar::Schema any(anyOf);
+    ASSERT_TRUE(any.validate(DynamicVariable(1)));
+    ASSERT_FALSE(any.validate(schemaString("1")));
+    ASSERT_FALSE(any.validate(DynamicVariable(true)));
+
+    ASSERT_FALSE(FDVar::Schema(DynamicVariable(false)).validate(DynamicVariable()));
+    ASSERT_THROW(FDVar::Schema(schemaOf("decimal")), std::invalid_argument);
+    ASSERT_THROW(FDVar::Schema(DynamicVariable(1)), std::invalid_argument);
+}
+TEST(Schema_test, test_ref_cycles)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable self(FDVar::ValueType::Object);
+    self.set("$ref", schemaString("#"));
+    ASSERT_THROW(FDVar::Schema { self }, std::invalid_argument);
+
+    DynamicVariable indirect(FDVar::ValueType::Object);
+    indirect.set("allOf", DynamicVariable(std::initializer_list<DynamicVariable> { self }));
+    ASSERT_THROW(FDVar::Schema { indirect }, std::invalid_argument);
+
+    DynamicVariable nested = schemaOf("array");
+    nested.set("items", self);
+    DynamicVariable strings(FDVar::ValueType::Array);
+    strings.push(schemaOf("string"));
+    strings.push(nested);
+    DynamicVariable descending(FDVar::ValueType::Object);
+    descending.set("anyOf", strings);
+    FDVar::Schema tree(descending);
+    DynamicVariable value({ schemaString("a"), DynamicVariable({ schemaString("b") }) });
+    ASSERT_TRUE(tree.validate(value));
+    value.push(DynamicVariable(1));
+    ASSERT_FALSE(tree.validate(value));
+}
+
+TEST(Schema_test, test_numeric_equality)
+{
+    using FDVar::BigIntegerValue;
+    using FDVar::DecimalValue;
+    using FDVar::DynamicVariable;
+
+    DynamicVariable allowed(FDVar::ValueType::Array);
+    allowed.push(DynamicVariable(1));
+    allowed.push(DynamicVariable(DecimalValue::parse("2.50")));
+    allowed.push(DynamicVariable(std::initializer_list<DynamicVariable> { DynamicVariable(3) }));
+    DynamicVariable enumSchema(FDVar::ValueType::Object);
+    enumSchema.set("enum", allowed);
+    FDVar::Schema oneOfValues(enumSchema);
+
+    ASSERT_TRUE(oneOfValues.validate(DynamicVariable(1.0)));
+    ASSERT_TRUE(oneOfValues.validate(DynamicVariable(DecimalValue::parse("1.00"))));
+    ASSERT_TRUE(oneOfValues.validate(DynamicVariable(BigIntegerValue::parse("1"))));
+    ASSERT_TRUE(oneOfValues.validate(DynamicVariable(2.5)));
+    ASSERT_TRUE(oneOfValues.validate(DynamicVariable(DecimalValue::parse("2.5"))));
+    ASSERT_TRUE(oneOfValues.validate(
+      DynamicVariable(std::initializer_list<DynamicVariable> { DynamicVariable(3.0) })));
+    ASSERT_FALSE(oneOfValues.validate(DynamicVariable(2)));
+    ASSERT_FALSE(oneOfValues.validate(DynamicVariable(DecimalValue::parse("1.01"))));
+    ASSERT_FALSE(oneOfValues.validate(DynamicVariable(true)));
+    ASSERT_FALSE(oneOfValues.validate(schemaString("1")));
+
+    DynamicVariable constSchema(FDVar::ValueType::Object);
+    DynamicVariable huge(BigIntegerValue::parse("100000000000000000000"));
+    constSchema.set("const", huge);
+    FDVar::Schema constant(constSchema);
+    ASSERT_TRUE(constant.validate(DynamicVariable(1e20)));
+    ASSERT_TRUE(constant.validate(huge));
+    ASSERT_FALSE(constant.validate(DynamicVariable(DecimalValue::parse("1.5"))));
+
+    constSchema.set("enum", DynamicVariable({ DynamicVariable(1), DynamicVariable(2) }));
+    FDVar::Schema both(constSchema);
+    ASSERT_FALSE(both.validate(huge));
+    ASSERT_FALSE(both.validate(DynamicVariable(1)));
+    constSchema.set("enum", DynamicVariable({ DynamicVariable(1), huge }));
+    ASSERT_TRUE(FDVar::Schema(constSchema).validate(huge));
+    ASSERT_FALSE(FDVar::Schema(constSchema).validate(DynamicVariable(1)));
+
+    FDVar::Schema integer(schemaOf("integer"));
+    ASSERT_TRUE(integer.validate(DynamicVariable(2.0)));
+    ASSERT_TRUE(integer.validate(DynamicVariable(DecimalValue::parse("2.000"))));
+    ASSERT_FALSE(integer.validate(DynamicVariable(DecimalValue::parse("2.5"))));
+    ASSERT_FALSE(integer.validate(DynamicVariable(2.5)));
+
+    DynamicVariable uniqueSchema = schemaOf("array");
+    uniqueSchema.set("uniqueItems", DynamicVariable(true));
+    FDVar::Schema unique(uniqueSchema);
+    ASSERT_FALSE(unique.validate(DynamicVariable({ DynamicVariable(1), DynamicVariable(1.0) })));
+    ASSERT_FALSE(unique.validate(
+      DynamicVariable({ DynamicVariable(DecimalValue::parse("2.50")), DynamicVariable(2.5) })));
+    ASSERT_FALSE(unique.validate(DynamicVariable({ DynamicVariable({ DynamicVariable(3) }),
+                                                   DynamicVariable({ DynamicVariable(3.0) }) })));
+    ASSERT_TRUE(unique.validate(DynamicVariable({ DynamicVariable(1), DynamicVariable(1.5) })));
+    ASSERT_TRUE(unique.validate(DynamicVariable({ DynamicVariable(1), schemaString("1") })));
+}
+
+TEST(Schema_test, test_numeric_bounds)
+{
+    using FDVar::BigIntegerValue;
+    using FDVar::DecimalValue;
+    using FDVar::DynamicVariable;
+
+    DynamicVariable priceSchema = schemaOf("number");
+    priceSchema.set("minimum", DynamicVariable(DecimalValue::parse("0.01")));
+    priceSchema.set("exclusiveMaximum", DynamicVariable(BigIntegerValue::parse("1000")));
+    priceSchema.set("multipleOf", DynamicVariable(DecimalValue::parse("0.01")));
+    FDVar::Schema price(priceSchema);
+    ASSERT_TRUE(price.validate(DynamicVariable(DecimalValue::parse("19.99"))));
+    ASSERT_TRUE(price.validate(DynamicVariable(20)));
+    ASSERT_TRUE(price.validate(DynamicVariable(DecimalValue::parse("0.01"))));
+    ASSERT_FALSE(price.validate(DynamicVariable(DecimalValue::parse("0.009"))));
+    ASSERT_FALSE(price.validate(DynamicVariable(DecimalValue::parse("19.995"))));
+    ASSERT_FALSE(price.validate(DynamicVariable(1000)));
+    ASSERT_FALSE(price.validate(DynamicVariable(BigIntegerValue::parse("100000000000000000000"))));
+
+    DynamicVariable boundedSchema = schemaOf("integer");
+    boundedSchema.set("maximum", DynamicVariable(DynamicVariable::IntType(9007199254740992)));
+    FDVar::Schema bounded(boundedSchema);
+    ASSERT_TRUE(bounded.validate(DynamicVariable(DynamicVariable::IntType(9007199254740992))));
+    ASSERT_FALSE(bounded.validate(DynamicVariable(DynamicVariable::IntType(9007199254740993))));
+    ASSERT_FALSE(bounded.validate(DynamicVariable(BigIntegerValue::parse("9007199254740993"))));
+
+    DynamicVariable multipleSchema(FDVar::ValueType::Object);
+    multipleSchema.set("multipleOf", DynamicVariable(5));
+    FDVar::Schema multiple(multipleSchema);
+    DynamicVariable tenPower(BigIntegerValue::parse("10000000000000000000"));
+    ASSERT_TRUE(multiple.validate(tenPower));
+    ASSERT_FALSE(multiple.validate(tenPower + DynamicVariable(1)));
+    ASSERT_TRUE(multiple.validate(DynamicVariable(12.5 * 2)));
+
+    DynamicVariable invalid(FDVar::ValueType::Object);
+    invalid.set("multipleOf", DynamicVariable(DecimalValue::parse("-0.5")));
+    ASSERT_THROW(FDVar::Schema { invalid }, std::invalid_argument);
+    invalid.set("multipleOf", schemaString("1"));
+    ASSERT_THROW(FDVar::Schema { invalid }, std::invalid_argument);
+}
+
+TEST(Schema_test, test_custom_objects)
+{
+    using FDVar::DynamicVariable;
+    DynamicVariable properties(FDVar::ValueType::Object);
+    properties.set("id", schemaOf("integer"));
+    DynamicVariable schema = schemaOf("object");
+    schema.set("required", schemaStrings({ "id" }));
+    schema.set("properties", properties);
+
+    DynamicVariable custom(FDVar::AbstractValue::Ptr(new ForwardingObjectValue(
+      { { "id", FDVar::AbstractValue::Ptr(new FDVar::IntValue(7)) } })));
+    FDVar::Schema compiled(schema);
+    ASSERT_TRUE(compiled.validate(custom));
+
+    FDVar::SchemaError error;
+    DynamicVariable wrong(FDVar::AbstractValue::Ptr(new ForwardingObjectValue(
+      { { "id", FDVar::AbstractValue::Ptr(new FDVar::StringValue("7")) } })));
+    ASSERT_FALSE(compiled.validate(wrong, error));
+    ASSERT_EQ(error.path, DynamicVariable::StringType("/id"));
+
+    DynamicVariable empty(FDVar::AbstractValue::Ptr(new ForwardingObjectValue({})));
+    ASSERT_FALSE(compiled.validate(empty));
+
+    DynamicVariable document(FDVar::AbstractValue::Ptr(new ForwardingObjectValue(
+      { { "type", schemaString("object").internalValue() },
+        { "required", schemaStrings({ "id" }).internalValue() },
+        { "properties", properties.internalValue() } })));
+    FDVar::Schema fromCustom(document);
+    ASSERT_TRUE(fromCustom.validate(custom));
+    ASSERT_FALSE(fromCustom.validate(wrong));
+    ASSERT_FALSE(fromCustom.validate(empty));
+}
+
+#endif // FDVAR_SCHEMA_TEST_H
@@ -65,5 +65,68 @@ TEST(StringValue_test, test_member_functions)
     ASSERT_EQ(value.subString(0, 4), test.substr(0, 4));
 }
 
+TEST(StringValue_test, test_rope)
+{
+    FDVar::StringValue::StringType test;
+    FDVar::StringValue value;
+    for(size_t i = 0; i < 10000; ++i)
+    {
+        value = value + TEST_STRING_VALUE;
+        test += TEST_STRING_VALUE;
+    }
+
+    ASSERT_EQ(value.size(), test.size());
+    FDVar::StringValue copy(value);
+    FDVar::StringValue other = value + "tail";
+    value += "end";
+    copy.append("copy");
+    ASSERT_EQ(value, test + "end");
+    ASSERT_EQ(copy, test + "copy");
+    ASSERT_EQ(other, test + "tail");
+
+    value[0] = 'T';
+    ASSERT_EQ(value.subString(0, 4), "Text");
+    ASSERT_EQ(other.subString(0, 4), "text");
+}
+
+TEST(StringValue_test, test_slice)
+{
+    FDVar::StringValue::StringType test;
+    for(size_t i = 0; i < 64; ++i)
+    {
+        test += TEST_STRING_VALUE;
+    }
+
+    FDVar::StringValue value(test);
+    FDVar::StringValue slice = value.subString(4, 100);
+    FDVar::StringValue nested = slice.subString(4, 40);
+    ASSERT_EQ(slice, test.substr(4, 100));
+    ASSERT_EQ(nested, test.substr(8, 40));
+    ASSERT_EQ(nested.view().data(), value.view().data() + 8);
+    ASSERT_EQ(value.subString(250, 100), test.substr(250));
+    ASSERT_THROW(value.subString(test.size() + 1, 1), std::out_of_range);
+
+    value.append("!");
+    slice[0] = 'T';
+    ASSERT_EQ(value, test + "!");
+    ASSERT_EQ(slice.subString(0, 4), "Text");
+    ASSERT_EQ(nested, test.substr(8, 40));
+    ASSERT_EQ(static_cast<const FDVar::StringValue::StringType &>(nested), test.substr(8, 40));
+}
+
+TEST(StringValue_test, test_rope_destruction)
+{
+    FDVar::StringValue::StringType chunk(FDVAR_STRING_ROPE_CHUNK_SIZE / 2 + 1, 'b');
+    std::unique_ptr<FDVar::StringValue> value(
+      new FDVar::StringValue(FDVar::StringValue::StringType(FDVAR_STRING_ROPE_THRESHOLD, 'a')));
+    for(size_t i = 0; i < 100000; ++i)
+    {
+        *value = *value + chunk;
+    }
+
+    ASSERT_EQ(value->size(), FDVAR_STRING_ROPE_THRESHOLD + 100000U * chunk.size());
+    ASSERT_EQ((*value)[FDVAR_STRING_ROPE_THRESHOLD], 'b');
+    value.reset();
+}
 
 #endif // FDVAR_STRINGVALUE_TEST_H
@@ -0,0 +1,116 @@
+#ifndef FDVAR_TIMESTAMPVALUE_TEST_H
+#define FDVAR_TIMESTAMPVALUE_TEST_H
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/JsonWriter.h>
+#include <FDVar/TimestampValue.h>
+#include <gtest/gtest.h>
+
+TEST(TimestampValue_test, test_parse)
+{
+    using FDVar::TimestampValue;
+
+    ASSERT_EQ(TimestampValue::parse("1970-01-01T00:00:00Z").count(), 0);
+    ASSERT_EQ(TimestampValue::parse("2024-02-29T12:34:56.789Z").count(), 1709210096789000);
+    ASSERT_EQ(TimestampValue::parse("2000-01-01").count(), 946684800000000);
+    ASSERT_EQ(TimestampValue::parse("0001-01-01t00:00:00z").count(), -62135596800000000);
+    ASSERT_EQ(TimestampValue::parse("1969-12-31 23:59:59.999999").count(), -1);
+    ASSERT_EQ(TimestampValue::parse("2024-01-01T00:00:00.123456789Z").count() % 1000000, 123456);
+    ASSERT_EQ(TimestampValue::parse("2024-03-10T08:00:00+05:30"),
+              TimestampValue::parse("2024-03-10T02:30:00Z"));
+    ASSERT_EQ(TimestampValue::parse("2024-03-10T00:15-0100"),
+              TimestampValue::parse("2024-03-10T01:15:00Z"));
+    ASSERT_EQ(TimestampValue::parse("+10000-01-01T00:00:00Z").toString(),
+              "+10000-01-01T00:00:00Z");
+
+    ASSERT_THROW(TimestampValue::parse(""), std::invalid_argument);
+    ASSERT_THROW(TimestampValue::parse("2023-02-29"), std::invalid_argument);
+    ASSERT_THROW(TimestampValue::parse("2024-13-01"), std::invalid_argument);
+    ASSERT_THROW(TimestampValue::parse("2024-1-01"), std::invalid_argument);
+    ASSERT_THROW(TimestampValue::parse("2024-01-01T24:00"), std::invalid_argument);
+    ASSERT_THROW(TimestampValue::parse("2024-01-01T10:00:00."), std::invalid_argument);
+    ASSERT_THROW(TimestampValue::parse("2024-01-01T10:00:00+"), std::invalid_argument);
+    ASSERT_THROW(TimestampValue::parse("2024-01-01T10:00:00Zx"), std::invalid_argument);
+}
+
+TEST(TimestampValue_test, test_format)
+{
+    using FDVar::TimestampValue;
+
+    ASSERT_EQ(TimestampValue().toString(), "1970-01-01T00:00:00Z");
+    ASSERT_EQ(TimestampValue::fromMicroseconds(-1).toString(), "1969-12-31T23:59:59.999999Z");
+    ASSERT_EQ(TimestampValue::parse("2024-02-29T12:34:56.500+01:00").toString(),
+              "2024-02-29T11:34:56.5Z");
+    ASSERT_EQ(TimestampValue::parse("-0001-03-01").toString(), "-0001-03-01T00:00:00Z");
+
+    // Every day boundary over four centuries survives a round trip through text.
+    for(int64_t day = -146097; day <= 146097; day += 97)
+    {
+        TimestampValue value = TimestampValue::fromMicroseconds(day * 86400000000LL + 1);
+        ASSERT_EQ(TimestampValue::parse(value.toString()), value);
+    }
+
+    auto now = std::chrono::system_clock::now();
+    TimestampValue current(now);
+    ASSERT_EQ(current.value(), std::chrono::floor<std::chrono::microseconds>(now));
+}
+
+TEST(TimestampValue_test, test_dynamic_variable)
+{
+    using FDVar::DurationValue;
+    using FDVar::DynamicVariable;
+    using FDVar::TimestampValue;
+    using FDVar::ValueType;
+
+    DynamicVariable start(TimestampValue::parse("2024-01-31T23:00:00Z"));
+    DynamicVariable step(DurationValue::parse("PT1H30M"));
+    ASSERT_TRUE(start.isType(ValueType::Timestamp));
+    ASSERT_TRUE(step.isType(ValueType::Duration));
+
+    DynamicVariable end = start + step;
+    ASSERT_TRUE(end.isType(ValueType::Timestamp));
+    ASSERT_EQ(end, DynamicVariable(TimestampValue::parse("2024-02-01T00:30:00Z")));
+    ASSERT_EQ(step + start, end);
+    ASSERT_EQ(end - step, start);
+    ASSERT_EQ(end - start, step);
+    ASSERT_EQ(step * 2, DynamicVariable(DurationValue::parse("PT3H")));
+    ASSERT_EQ(DynamicVariable(2) * step, step * 2);
+    ASSERT_EQ(step / 3, DynamicVariable(DurationValue::parse("PT30M")));
+    ASSERT_EQ(step / DynamicVariable(DurationValue::parse("PT1M")), 90);
+    ASSERT_EQ(-step + step, DynamicVariable(ValueType::Duration));
+
+    DynamicVariable moving(start);
+    moving += step;
+    moving -= DynamicVariable(DurationValue::parse("PT30M"));
+    ASSERT_EQ(moving, DynamicVariable(TimestampValue::parse("2024-02-01T00:00:00Z")));
+    ASSERT_EQ(start, DynamicVariable(TimestampValue::parse("2024-01-31T23:00:00Z")));
+
+    ASSERT_THROW(start + start, std::runtime_error);
+    ASSERT_THROW(start + 1, std::runtime_error);
+    ASSERT_THROW(step * step, std::runtime_error);
+    ASSERT_THROW(step / 0, std::domain_error);
+
+    std::vector<DynamicVariable> times { end, start, moving };
+    std::sort(times.begin(), times.end());
+    ASSERT_EQ(times[0], start);
+    ASSERT_EQ(times[2], end);
+    ASSERT_LT(start, end);
+    ASSERT_EQ(end.hash(), DynamicVariable(TimestampValue::parse("2024-02-01T01:30+01:00")).hash());
+    ASSERT_NE(start, DynamicVariable("2024-01-31T23:00:00Z"));
+
+    std::ostringstream stream;
+    stream << start << ' ' << step;
+    ASSERT_EQ(stream.str(), "2024-01-31T23:00:00Z PT1H30M");
+
+    FDVar::JsonWriter writer;
+    writer.value(DynamicVariable({ start, step }));
+    ASSERT_EQ(writer.str(), "[\"2024-01-31T23:00:00Z\",\"PT1H30M\"]");
+}
+
+#endif // FDVAR_TIMESTAMPVALUE_TEST_H
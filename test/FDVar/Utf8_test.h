@@ -0,0 +1,85 @@
+#ifndef FDVAR_UTF8_TEST_H
+#define FDVAR_UTF8_TEST_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <FDVar/DynamicVariable.h>
+#include <FDVar/Utf8.h>
+#include <gtest/gtest.h>
+
+TEST(Utf8_test, test_validation)
+{
+    ASSERT_TRUE(FDVar::utf8::isValid(std::string_view("plain ascii text, long enough")));
+    ASSERT_TRUE(
+      FDVar::utf8::isValid(std::string_view("h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80")));
+    ASSERT_FALSE(FDVar::utf8::isValid(std::string_view("\xC0\xAF")));
+    ASSERT_FALSE(FDVar::utf8::isValid(std::string_view("abcdefgh\xE2\x82")));
+    ASSERT_FALSE(FDVar::utf8::isValid(std::string_view("\xED\xA0\x80")));
+    ASSERT_FALSE(FDVar::utf8::isValid(std::string_view("\xF4\x90\x80\x80")));
+    ASSERT_FALSE(FDVar::utf8::isValid(std::string_view("abc\x80")));
+
+    ASSERT_EQ(FDVar::utf8::length(std::string_view("h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80")),
+              9U);
+    ASSERT_THROW(FDVar::StringValue::fromUtf8("\xFF"), std::invalid_argument);
+}
+
+TEST(Utf8_test, test_code_points)
+{
+    FDVar::StringValue::StringType text;
+    for(size_t i = 0; i < 1000; ++i)
+    {
+        text += i % 3 == 0 ? "\xC3\xA9" : (i % 3 == 1 ? "a" : "\xE2\x82\xAC");
+    }
+
+    FDVar::StringValue value = FDVar::StringValue::fromUtf8(text);
+    ASSERT_TRUE(value.isValidUtf8());
+    ASSERT_EQ(value.length(), 1000U);
+    ASSERT_EQ(value.charAt(0), "\xC3\xA9");
+    ASSERT_EQ(value.charAt(500), "\xE2\x82\xAC");
+    ASSERT_EQ(value.codePointAt(996), 0xE9U);
+    ASSERT_EQ(value.codePointAt(997), static_cast<uint32_t>('a'));
+    ASSERT_EQ(value.codePointAt(998), 0x20ACU);
+    ASSERT_THROW(value.charAt(1000), std::out_of_range);
+
+    FDVar::StringValue part = value.substr(998, 10);
+    ASSERT_EQ(part, "\xE2\x82\xAC\xC3\xA9");
+    ASSERT_EQ(value.substr(3, 3), "\xC3\xA9" "a\xE2\x82\xAC");
+
+    value.append("\xF0\x9F\x98\x80");
+    ASSERT_EQ(value.length(), 1001U);
+    ASSERT_EQ(value.codePointAt(1000), 0x1F600U);
+
+    FDVar::StringValue invalid("abc\xFF");
+    ASSERT_FALSE(invalid.isValidUtf8());
+    ASSERT_THROW(invalid.length(), std::runtime_error);
+}
+
+TEST(Utf8_test, test_dynamic_variable)
+{
+    FDVar::DynamicVariable value("na\xC3\xAFve caf\xC3\xA9");
+    ASSERT_EQ(value.size(), 12U);
+    ASSERT_EQ(value.length(), 10U);
+    ASSERT_EQ(value.charAt(2), "\xC3\xAF");
+    ASSERT_EQ(value.substr(6, 4).view(), "caf\xC3\xA9");
+
+    FDVar::DynamicVariable text("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+    std::vector<uint32_t> codePoints(text.codePoints().begin(), text.codePoints().end());
+    ASSERT_EQ(codePoints, std::vector<uint32_t>({ 0x61, 0xE9, 0x20AC, 0x1F600 }));
+
+    std::vector<FDVar::DynamicVariable::StringViewType> characters;
+    for(auto it = text.codePoints().begin(); it != text.codePoints().end(); ++it)
+    {
+        characters.push_back(it.character());
+        ASSERT_EQ(it.character().data(), text.view().data() + it.offset());
+    }
+
+    ASSERT_EQ(characters.size(), 4U);
+    ASSERT_EQ(characters[3], "\xF0\x9F\x98\x80");
+    ASSERT_EQ(FDVar::DynamicVariable("").codePoints().begin(),
+              FDVar::DynamicVariable("").codePoints().end());
+    ASSERT_THROW(FDVar::DynamicVariable("abc\x80").codePoints(), std::runtime_error);
+}
+
+#endif // FDVAR_UTF8_TEST_H
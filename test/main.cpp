@@ -1,4 +1,24 @@
+#include "FDVar/ArithmeticPolicy_test.h"
+#include "FDVar/ArrayIndex_test.h"
+#include "FDVar/BigIntegerValue_test.h"
+#include "FDVar/BytesValue_test.h"
+#include "FDVar/ColumnarTable_test.h"
+#include "FDVar/DecimalValue_test.h"
+#include "FDVar/DurationValue_test.h"
 #include "FDVar/DynamicVariable_test.h"
+#include "FDVar/Expression_test.h"
+#include "FDVar/Hash_test.h"
+#include "FDVar/JsonWriter_test.h"
+#include "FDVar/LazyArithmetic_test.h"
+#include "FDVar/NanBoxedVariable_test.h"
+#include "FDVar/ParallelAlgorithms_test.h"
+#include "FDVar/Path_test.h"
+#include "FDVar/Patch_test.h"
+#include "FDVar/Reclaimer_test.h"
+#include "FDVar/Reflect_test.h"
+#include "FDVar/Schema_test.h"
+#include "FDVar/TimestampValue_test.h"
+#include "FDVar/Utf8_test.h"
 
 #include <gtest/gtest.h>
 